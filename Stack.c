@@ -17,217 +17,4742 @@
 	#include "stdlib.h"
 #endif // end of USE_MALLOC
 
-STACK *CreateStack(STACK *Stack, void (*CustomFreeMethod)(void *Data))
+#if (USING_STACK_VALUE_METHODS == 1) || (USING_STACK_SPILL_METHODS == 1) || (USING_STACK_SPLICE_METHODS == 1)
+	#include "string.h"
+#endif // end of USING_STACK_VALUE_METHODS, USING_STACK_SPILL_METHODS or USING_STACK_SPLICE_METHODS
+
+#if (USING_STACK_SEARCH_METHODS == 1) && (USING_STACK_SIMD_SEARCH == 1)
+	#if defined(__AVX2__) && (__SIZEOF_POINTER__ == 8)
+		#include "immintrin.h"
+
+		#define STACK_SIMD_AVX2
+	#elif defined(__SSE2__)
+		#include "emmintrin.h"
+
+		#define STACK_SIMD_SSE2
+	#endif // end of __AVX2__
+#endif // end of USING_STACK_SEARCH_METHODS and USING_STACK_SIMD_SEARCH
+
+#if (USING_STACK_SERIALIZE_METHODS == 1)
+	/*
+		The first member of every STACK_SERIAL_HEADER, "STSR" in memory on
+		a little endian machine, and the layout of the buffer that follows.
+	*/
+	#define STACK_SERIAL_MAGIC						(UINT32)0x52535453
+	#define STACK_SERIAL_VERSION					(UINT32)2
+
+	/*
+		Written to every STACK_SERIAL_HEADER, it only reads back the same
+		on a machine with the same byte order.
+	*/
+	#define STACK_SERIAL_BYTE_ORDER					(UINT32)0x01020304
+
+	/*
+		The address of the top item of a STACK made with CreateStackView().
+	*/
+	#define StackViewTop(Stack)						((Stack)->View + (((Stack)->Size - 1) * (Stack)->ElementSize))
+#endif // end of USING_STACK_SERIALIZE_METHODS
+
+#if (USING_STACK_HUGE_PAGE_ARENA == 1)
+	#include "sys/mman.h"
+#endif // end of USING_STACK_HUGE_PAGE_ARENA
+
+#if (USING_STACK_PARALLEL_FREE == 1) || (USING_STACK_NODE_MAGAZINES == 1)
+	#include "pthread.h"
+#endif // end of USING_STACK_PARALLEL_FREE or USING_STACK_NODE_MAGAZINES
+
+#if (USING_STACK_NODE_MAGAZINES == 1)
+	/*
+		The per CPU magazines are only kept with restartable sequences,
+		which need an x86-64 Linux and a glibc that registers every thread
+		with the kernel.  Otherwise each thread keeps a magazine.
+	*/
+	#if defined(__x86_64__) && defined(__linux__) && defined(__GLIBC__) && ((__GLIBC__ > 2) || ((__GLIBC__ == 2) && (__GLIBC_MINOR__ >= 35)))
+		#include "sys/rseq.h"
+
+		#define STACK_MAGAZINES_USE_RSEQ
+	#endif
+#endif // end of USING_STACK_NODE_MAGAZINES
+
+/*
+	The number of bytes each item takes up inside a STACK_NODE.  A STACK
+	made with CreateValueStack() stores its items themselves, every other
+	STACK stores data pointers.
+*/
+#if (USING_STACK_VALUE_METHODS == 1)
+	#define StackSlotSizeInBytes(Stack)			(UINT32)((Stack)->ElementSize ? (Stack)->ElementSize : (UINT32)sizeof(void*))
+#else
+	#define StackSlotSizeInBytes(Stack)			(UINT32)sizeof(void*)
+#endif // end of USING_STACK_VALUE_METHODS
+
+/*
+	The number of bytes StackMemAlloc() is asked for when a new STACK_NODE
+	is needed.  With chunked storage a STACK_NODE holds ElementsPerNode
+	slots, the first of which is the Data member of the STACK_NODE.  A
+	STACK_NODE of a value STACK otherwise has its item right after it.
+*/
+#if (USING_STACK_CHUNKED_STORAGE == 1)
+	#define StackNodeSizeInBytes(Stack)			(UINT32)(sizeof(STACK_NODE) - sizeof(void*) + ((Stack)->ElementsPerNode * StackSlotSizeInBytes(Stack)))
+#elif (USING_STACK_VALUE_METHODS == 1)
+	#define StackNodeSizeInBytes(Stack)			(UINT32)(sizeof(STACK_NODE) + (Stack)->ElementSize)
+#else
+	#define StackNodeSizeInBytes(Stack)			(UINT32)sizeof(STACK_NODE)
+#endif // end of USING_STACK_CHUNKED_STORAGE
+
+/*
+	The number of bytes a node arena sets aside for each STACK_NODE and
+	for the header of each of its blocks.
+*/
+#if (USING_STACK_NODE_ARENA == 1)
+	#define StackArenaAlign(Size)					(UINT32)(((Size) + (STACK_ARENA_ALIGNMENT - 1)) & ~(UINT32)(STACK_ARENA_ALIGNMENT - 1))
+	#define StackArenaNodeSizeInBytes(Stack)		StackArenaAlign(StackNodeSizeInBytes(Stack))
+	#define StackArenaHeaderSizeInBytes				StackArenaAlign(sizeof(STACK_ARENA_BLOCK))
+#endif // end of USING_STACK_NODE_ARENA
+
+/*
+	How the memory of a huge page arena block was mapped, and how a
+	block of a node arena is given back.
+*/
+#if (USING_STACK_HUGE_PAGE_ARENA == 1)
+	#define STACK_ARENA_BLOCK_MAPPED				(UINT32)0
+	#define STACK_ARENA_BLOCK_HUGE_TLB				(UINT32)1
+	#define STACK_ARENA_BLOCK_ADVISED				(UINT32)2
+
+	#define StackArenaFreeBlock(Stack, Block)		munmap((void*)(Block), (size_t)((Block)->SizeInBytes))
+#elif (USING_STACK_NODE_ARENA == 1)
+	#define StackArenaFreeBlock(Stack, Block)		StackDeallocate(Stack, (void*)(Block))
+#endif // end of USING_STACK_HUGE_PAGE_ARENA
+
+/*
+	The number of bytes the inline buffer of a STACK sets aside for each
+	STACK_NODE, and whether a STACK_NODE was carved out of it.
+*/
+#if (USING_STACK_INLINE_BUFFER == 1)
+	#define StackInlineNodeSizeInBytes(Stack)		(UINT32)((StackNodeSizeInBytes(Stack) + sizeof(void*) - 1) & ~(UINT32)(sizeof(void*) - 1))
+	#define StackIsInlineNode(Stack, StackNode)		((BYTE*)(StackNode) >= (BYTE*)((Stack)->InlineBuffer) && (BYTE*)(StackNode) < (BYTE*)((Stack)->InlineBuffer) + sizeof((Stack)->InlineBuffer))
+#endif // end of USING_STACK_INLINE_BUFFER
+
+/*
+	The address of slot Index of a chunked STACK_NODE.
+*/
+#if (USING_STACK_CHUNKED_STORAGE == 1)
+	#define StackNodeSlot(Stack, StackNode, Index)	((BYTE*)((StackNode)->Data) + ((Index) * StackSlotSizeInBytes(Stack)))
+#endif // end of USING_STACK_CHUNKED_STORAGE
+
+/*
+	Where a STACK gets the memory for its STACK_NODE's and whatever else
+	it allocates for itself.  With USING_STACK_ALLOCATORS each STACK has
+	its own STACK_ALLOCATOR, which is StackMemAlloc() and StackMemDealloc()
+	unless it was given another one.
+*/
+#if (USING_STACK_ALLOCATORS == 1)
+	#define StackAllocate(Stack, Size)				((Stack)->Allocator.Alloc((Stack)->Allocator.Context, (UINT32)(Size)))
+	#define StackDeallocate(Stack, Memory)			((Stack)->Allocator.Free((Stack)->Allocator.Context, (void*)(Memory)))
+#else
+	#define StackAllocate(Stack, Size)				StackMemAlloc(Size)
+	#define StackDeallocate(Stack, Memory)			StackMemDealloc(Memory)
+#endif // end of USING_STACK_ALLOCATORS
+
+/*
+	The number of items of the STACK that are in its STACK_NODE's, 
+	rather than spilled out to a file.
+*/
+#if (USING_STACK_SPILL_METHODS == 1)
+	#define StackInMemorySize(Stack)				((Stack)->Size - (Stack)->SpilledSize)
+	#define StackNeedsPageIn(Stack)					((Stack)->SpilledSize && (Stack)->SpilledSize == (Stack)->Size)
+#else
+	#define StackInMemorySize(Stack)				((Stack)->Size)
+#endif // end of USING_STACK_SPILL_METHODS
+
+/*
+	Called each time a STACK_NODE is linked in on top of the STACK.  If
+	there is nothing under it, it is now the bottom STACK_NODE.
+*/
+#if (USING_STACK_SPLICE_METHODS == 1)
+	#define StackNoteBottomNode(Stack, StackNode)	((StackNode)->Next == (STACK_NODE*)NULL ? (void)((Stack)->BottomOfStack = (STACK_NODE*)(StackNode)) : (void)0)
+#else
+	#define StackNoteBottomNode(Stack, StackNode)	((void)0)
+#endif // end of USING_STACK_SPLICE_METHODS
+
+#if (USING_STACK_LATENCY_HISTOGRAM == 1)
+	#include <time.h>
+
+	/*
+		The default StackGetTimestamp(), see StackConfig.h.
+	*/
+	static UINT64 StackGetTimeInNanoseconds(void)
+	{
+		struct timespec Time;
+
+		clock_gettime(CLOCK_MONOTONIC, &Time);
+
+		return (UINT64)Time.tv_sec * (UINT64)1000000000 + (UINT64)Time.tv_nsec;
+	}
+
+	/*
+		Counts down to the next call that should be timed.  Returns the
+		time the call started if this is the one, otherwise 0.
+	*/
+	static UINT64 StackLatencySampleStart(STACK *Stack)
+	{
+		if(--Stack->Stats.SampleCountdown)
+			return (UINT64)0;
+
+		Stack->Stats.SampleCountdown = (UINT32)STACK_LATENCY_SAMPLE_PERIOD;
+
+		return (UINT64)StackGetTimestamp();
+	}
+
+	/*
+		Adds how long a timed call took to the histogram.  StartTime is 
+		what StackLatencySampleStart() returned, 0 if it wasn't timed.
+	*/
+	static void StackLatencySampleEnd(UINT32 *Histogram, UINT64 StartTime)
+	{
+		UINT64 Elapsed;
+		UINT32 Bucket;
+
+		if(StartTime == (UINT64)0)
+			return;
+
+		Elapsed = (UINT64)(StackGetTimestamp() - StartTime);
+
+		for(Bucket = (UINT32)0; Elapsed > (UINT64)1 && Bucket < (UINT32)(STACK_LATENCY_HISTOGRAM_BUCKETS - 1); Bucket++)
+			Elapsed >>= 1;
+
+		Histogram[Bucket]++;
+	}
+#endif // end of USING_STACK_LATENCY_HISTOGRAM
+
+#if (USING_STACK_STATISTICS == 1)
+	/*
+		Counts Count items pushed onto the STACK, which has already had 
+		its size updated, and keeps track of the deepest it has been.
+	*/
+	static void StackStatsPushed(STACK *Stack, UINT32 Count)
+	{
+		Stack->Stats.Pushes += Count;
+
+		if(Stack->Size > Stack->Stats.PeakSize)
+			Stack->Stats.PeakSize = (UINT32)(Stack->Size);
+	}
+#endif // end of USING_STACK_STATISTICS
+
+#if (USING_STACK_ALLOCATORS == 1)
+	/*
+		The STACK_ALLOCATOR every STACK starts out with, which just calls
+		the StackMemAlloc() and StackMemDealloc() defines.
+	*/
+	static void *StackDefaultAlloc(void *Context, UINT32 Size)
+	{
+		(void)Context;
+
+		return StackMemAlloc(Size);
+	}
+
+	static void StackDefaultFree(void *Context, void *Memory)
+	{
+		(void)Context;
+
+		StackMemDealloc(Memory);
+	}
+#endif // end of USING_STACK_ALLOCATORS
+
+#if (USING_STACK_HUGE_PAGE_ARENA == 1)
+	/*
+		Maps BlockSize bytes, a multiple of STACK_HUGE_PAGE_SIZE, for a
+		node arena block.  Huge pages set aside with MAP_HUGETLB are tried
+		first.  Otherwise the block is mapped on a huge page boundary and
+		the kernel is asked to back it with transparent huge pages.  
+		Returns NULL if mmap() failed.
+	*/
+	static STACK_ARENA_BLOCK *StackArenaMapBlock(UINT32 BlockSize)
+	{
+		BYTE *Map, *Block;
+		size_t Extra;
+		UINT32 Backing;
+
+		#if defined(MAP_HUGETLB)
+			if((Map = (BYTE*)mmap((void*)NULL, (size_t)BlockSize, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS | MAP_HUGETLB, -1, (off_t)0)) != (BYTE*)MAP_FAILED)
+			{
+				((STACK_ARENA_BLOCK*)Map)->Backing = STACK_ARENA_BLOCK_HUGE_TLB;
+
+				return (STACK_ARENA_BLOCK*)Map;
+			}
+		#endif // end of MAP_HUGETLB
+
+		/*
+			Map a huge page more than needed and trim off the ends, so what
+			is left starts on a huge page boundary.
+		*/
+		if((Map = (BYTE*)mmap((void*)NULL, (size_t)BlockSize + (size_t)STACK_HUGE_PAGE_SIZE, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, (off_t)0)) == (BYTE*)MAP_FAILED)
+			return (STACK_ARENA_BLOCK*)NULL;
+
+		Block = (BYTE*)(((size_t)Map + (size_t)(STACK_HUGE_PAGE_SIZE - 1)) & ~(size_t)(STACK_HUGE_PAGE_SIZE - 1));
+
+		if((Extra = (size_t)(Block - Map)) != (size_t)0)
+			munmap((void*)Map, Extra);
+
+		if((Extra = (size_t)STACK_HUGE_PAGE_SIZE - Extra) != (size_t)0)
+			munmap((void*)(Block + BlockSize), Extra);
+
+		/*
+			The advice has to come before the first page is touched, or 
+			that page is already a small one.
+		*/
+		Backing = STACK_ARENA_BLOCK_MAPPED;
+
+		#if defined(MADV_HUGEPAGE)
+			if(madvise((void*)Block, (size_t)BlockSize, MADV_HUGEPAGE) == 0)
+				Backing = STACK_ARENA_BLOCK_ADVISED;
+		#endif // end of MADV_HUGEPAGE
+
+		((STACK_ARENA_BLOCK*)Block)->Backing = Backing;
+
+		return (STACK_ARENA_BLOCK*)Block;
+	}
+#endif // end of USING_STACK_HUGE_PAGE_ARENA
+
+#if (USING_STACK_NODE_ARENA == 1)
+	/*
+		Returns the size of every block of the STACK's node arena, which
+		is big enough for at least one STACK_NODE.
+	*/
+	static UINT32 StackArenaBlockSizeInBytes(STACK *Stack)
+	{
+		UINT32 BlockSize;
+
+		(void)Stack;
+
+		BlockSize = (UINT32)STACK_ARENA_BLOCK_SIZE;
+
+		if(BlockSize < StackArenaHeaderSizeInBytes + StackArenaNodeSizeInBytes(Stack))
+			BlockSize = (UINT32)(StackArenaHeaderSizeInBytes + StackArenaNodeSizeInBytes(Stack));
+
+		#if (USING_STACK_HUGE_PAGE_ARENA == 1)
+			BlockSize = (UINT32)((BlockSize + (UINT32)(STACK_HUGE_PAGE_SIZE - 1)) & ~(UINT32)(STACK_HUGE_PAGE_SIZE - 1));
+		#endif // end of USING_STACK_HUGE_PAGE_ARENA
+
+		return (UINT32)BlockSize;
+	}
+
+	/*
+		Gets a new block for the STACK's node arena from StackAllocate()
+		and starts carving STACK_NODE's out of it.  Whatever was left of
+		the last block is not used.  A huge page arena maps its blocks 
+		instead.  Returns FALSE if there wasn't enough memory.
+	*/
+	static BOOL StackArenaGrow(STACK *Stack)
+	{
+		STACK_ARENA_BLOCK *Block;
+		UINT32 BlockSize;
+
+		BlockSize = StackArenaBlockSizeInBytes(Stack);
+
+		#if (USING_STACK_HUGE_PAGE_ARENA == 1)
+			if((Block = StackArenaMapBlock(BlockSize)) == (STACK_ARENA_BLOCK*)NULL)
+				return (BOOL)FALSE;
+
+			Block->SizeInBytes = (UINT32)BlockSize;
+		#else
+			if((Block = (STACK_ARENA_BLOCK*)StackAllocate(Stack, BlockSize)) == (STACK_ARENA_BLOCK*)NULL)
+				return (BOOL)FALSE;
+		#endif // end of USING_STACK_HUGE_PAGE_ARENA
+
+		Block->Next = (STACK_ARENA_BLOCK*)(Stack->ArenaBlocks);
+		Stack->ArenaBlocks = (STACK_ARENA_BLOCK*)Block;
+		Stack->ArenaNext = (BYTE*)Block + StackArenaHeaderSizeInBytes;
+		Stack->ArenaBytesLeft = (UINT32)(BlockSize - StackArenaHeaderSizeInBytes);
+
+		return (BOOL)TRUE;
+	}
+
+	/*
+		Frees every block of the STACK's node arena, and with them every
+		STACK_NODE the STACK has, in use or not.
+	*/
+	static void StackArenaRelease(STACK *Stack)
+	{
+		STACK_ARENA_BLOCK *Block;
+
+		while((Block = (STACK_ARENA_BLOCK*)(Stack->ArenaBlocks)) != (STACK_ARENA_BLOCK*)NULL)
+		{
+			Stack->ArenaBlocks = (STACK_ARENA_BLOCK*)(Block->Next);
+
+			StackArenaFreeBlock(Stack, Block);
+		}
+
+		Stack->ArenaNext = (BYTE*)NULL;
+		Stack->ArenaBytesLeft = (UINT32)0;
+		Stack->ArenaFreeNodes = (STACK_NODE*)NULL;
+
+		#if (USING_STACK_MARK_METHODS == 1)
+			Stack->ArenaFreeFloor = (STACK_NODE*)NULL;
+			Stack->ArenaGeneration++;
+			Stack->MarkLowWater = (UINT32)0xFFFFFFFF;
+			Stack->MarkDip = (UINT32)0xFFFFFFFF;
+		#endif // end of USING_STACK_MARK_METHODS
+	}
+
+	/*
+		Frees every block of the STACK's node arena but the newest one,
+		and starts carving STACK_NODE's from the beginning of that one
+		again.  The STACK must not be holding any STACK_NODE's.
+	*/
+	static void StackArenaReset(STACK *Stack)
+	{
+		STACK_ARENA_BLOCK *Block, *TempBlock;
+
+		if((Block = (STACK_ARENA_BLOCK*)(Stack->ArenaBlocks)) != (STACK_ARENA_BLOCK*)NULL)
+		{
+			while((TempBlock = (STACK_ARENA_BLOCK*)(Block->Next)) != (STACK_ARENA_BLOCK*)NULL)
+			{
+				Block->Next = (STACK_ARENA_BLOCK*)(TempBlock->Next);
+
+				StackArenaFreeBlock(Stack, TempBlock);
+			}
+
+			Stack->ArenaNext = (BYTE*)Block + StackArenaHeaderSizeInBytes;
+			Stack->ArenaBytesLeft = (UINT32)(StackArenaBlockSizeInBytes(Stack) - StackArenaHeaderSizeInBytes);
+		}
+
+		Stack->ArenaFreeNodes = (STACK_NODE*)NULL;
+
+		#if (USING_STACK_MARK_METHODS == 1)
+			Stack->ArenaFreeFloor = (STACK_NODE*)NULL;
+			Stack->ArenaGeneration++;
+			Stack->MarkLowWater = (UINT32)0xFFFFFFFF;
+			Stack->MarkDip = (UINT32)0xFFFFFFFF;
+		#endif // end of USING_STACK_MARK_METHODS
+	}
+
+	/*
+		Called once items have been taken off of the STACK and its size
+		updated.  An empty STACK keeps one block of its node arena, so
+		pushing onto it again doesn't have to get a new one.  Only
+		StackClear() and StackShrink() hand back that last block.
+	*/
+	static void StackArenaItemsRemoved(STACK *Stack)
+	{
+		#if (USING_STACK_MARK_METHODS == 1)
+			if(Stack->Size < Stack->MarkLowWater)
+				Stack->MarkLowWater = Stack->Size;
+		#endif // end of USING_STACK_MARK_METHODS
+
+		if(StackIsEmpty(Stack))
+		{
+			Stack->TopOfStack = (STACK_NODE*)NULL;
+
+			StackArenaReset(Stack);
+		}
+	}
+#endif // end of USING_STACK_NODE_ARENA
+
+/*
+	Returns a STACK_NODE for the STACK to use.  If the STACK has a
+	STACK_NODE in its node cache then that one is reused, otherwise a
+	new one is allocated with StackAllocate().  With a node arena the
+	STACK_NODE comes out of the arena instead.  With an inline buffer
+	the STACK_NODE's in it are used before any of those.  Returns 
+	(STACK_NODE*)NULL if no STACK_NODE could be had.
+*/
+static STACK_NODE *StackAllocateNode(STACK *Stack)
+{
+	#if (USING_STACK_NODE_ARENA == 1)
+		STACK_NODE *TempStackNode;
+
+		#if (USING_STACK_MARK_METHODS == 1)
+			if((TempStackNode = (STACK_NODE*)(Stack->ArenaFreeNodes)) != (STACK_NODE*)NULL && TempStackNode != Stack->ArenaFreeFloor)
+		#else
+			if((TempStackNode = (STACK_NODE*)(Stack->ArenaFreeNodes)) != (STACK_NODE*)NULL)
+		#endif // end of USING_STACK_MARK_METHODS
+		{
+			Stack->ArenaFreeNodes = (STACK_NODE*)(TempStackNode->Next);
+
+			return (STACK_NODE*)TempStackNode;
+		}
+
+		if(Stack->ArenaBytesLeft < StackArenaNodeSizeInBytes(Stack) && !StackArenaGrow(Stack))
+		{
+			#if (USING_STACK_STATISTICS == 1)
+				Stack->Stats.AllocationFailures++;
+			#endif // end of USING_STACK_STATISTICS
+
+			return (STACK_NODE*)NULL;
+		}
+
+		TempStackNode = (STACK_NODE*)(Stack->ArenaNext);
+		Stack->ArenaNext += StackArenaNodeSizeInBytes(Stack);
+		Stack->ArenaBytesLeft -= StackArenaNodeSizeInBytes(Stack);
+
+		return (STACK_NODE*)TempStackNode;
+	#else
+	#if (USING_STACK_NODE_CACHE == 1) || (USING_STACK_INLINE_BUFFER == 1)
+		STACK_NODE *TempStackNode;
+	#endif // end of USING_STACK_NODE_CACHE or USING_STACK_INLINE_BUFFER
+
+	#if (USING_STACK_INLINE_BUFFER == 1)
+		if((TempStackNode = (STACK_NODE*)(Stack->InlineFreeNodes)) != (STACK_NODE*)NULL)
+		{
+			Stack->InlineFreeNodes = (STACK_NODE*)(TempStackNode->Next);
+			Stack->InlineNodesInUse++;
+
+			return (STACK_NODE*)TempStackNode;
+		}
+
+		if(Stack->InlineBytesUsed + StackInlineNodeSizeInBytes(Stack) <= (UINT32)sizeof(Stack->InlineBuffer))
+		{
+			TempStackNode = (STACK_NODE*)((BYTE*)(Stack->InlineBuffer) + Stack->InlineBytesUsed);
+			Stack->InlineBytesUsed += StackInlineNodeSizeInBytes(Stack);
+			Stack->InlineNodesInUse++;
+
+			return (STACK_NODE*)TempStackNode;
+		}
+	#endif // end of USING_STACK_INLINE_BUFFER
+
+	#if (USING_STACK_NODE_CACHE == 1)
+		if((TempStackNode = (STACK_NODE*)(Stack->NodeCache)) != (STACK_NODE*)NULL)
+		{
+			Stack->NodeCache = (STACK_NODE*)(TempStackNode->Next);
+			Stack->NodeCacheSize--;
+
+			return (STACK_NODE*)TempStackNode;
+		}
+	#endif // end of USING_STACK_NODE_CACHE
+
+	#if (USING_STACK_STATISTICS == 1)
+	{
+		STACK_NODE *NewStackNode;
+
+		if((NewStackNode = (STACK_NODE*)StackAllocate(Stack, StackNodeSizeInBytes(Stack))) == (STACK_NODE*)NULL)
+			Stack->Stats.AllocationFailures++;
+
+		return (STACK_NODE*)NewStackNode;
+	}
+	#else
+		(void)Stack;
+
+		return (STACK_NODE*)StackAllocate(Stack, StackNodeSizeInBytes(Stack));
+	#endif // end of USING_STACK_STATISTICS
+	#endif // end of USING_STACK_NODE_ARENA
+}
+
+/*
+	Gives back a STACK_NODE that is no longer in the STACK.  If the STACK's
+	node cache has room the STACK_NODE is kept for reuse, otherwise it is 
+	freed with StackDeallocate().  A STACK_NODE from a node arena is
+	kept for reuse until the arena is released, and one from the inline
+	buffer goes back to it.
+*/
+static void StackReleaseNode(STACK *Stack, STACK_NODE *StackNode)
 {
+	#if (USING_STACK_NODE_ARENA == 1)
+		StackNode->Next = (STACK_NODE*)(Stack->ArenaFreeNodes);
+		Stack->ArenaFreeNodes = (STACK_NODE*)StackNode;
+	#else
+		#if (USING_STACK_INLINE_BUFFER == 1)
+			if(StackIsInlineNode(Stack, StackNode))
+			{
+				StackNode->Next = (STACK_NODE*)(Stack->InlineFreeNodes);
+				Stack->InlineFreeNodes = (STACK_NODE*)StackNode;
+				Stack->InlineNodesInUse--;
+
+				return;
+			}
+		#endif // end of USING_STACK_INLINE_BUFFER
+
+		#if (USING_STACK_NODE_CACHE == 1)
+			if(Stack->NodeCacheSize < Stack->NodeCacheLimit)
+			{
+				StackNode->Next = (STACK_NODE*)(Stack->NodeCache);
+				Stack->NodeCache = (STACK_NODE*)StackNode;
+				Stack->NodeCacheSize++;
+
+				return;
+			}
+		#endif // end of USING_STACK_NODE_CACHE
+
+		(void)Stack;
+
+		StackDeallocate(Stack, (void*)StackNode);
+	#endif // end of USING_STACK_NODE_ARENA
+}
+
+#if (USING_STACK_PERSISTENT_METHODS == 1)
+	/*
+		Lets go of one reference to a STACK_NODE.  Returns TRUE if that was
+		the last one, in which case the caller now owns the STACK_NODE 
+		along with the reference it holds to the STACK_NODE below it.  
+		With only one reference there is no one to race with, so the 
+		atomic decrement is skipped.
+	*/
+	static BOOL StackDropNodeReference(STACK_NODE *StackNode)
+	{
+		if(StackAtomicLoad(&StackNode->References) == (UINT32)1)
+			return (BOOL)TRUE;
+
+		return (BOOL)(StackAtomicAdd(&StackNode->References, (UINT32)0xFFFFFFFF) == (UINT32)0);
+	}
+
+	/*
+		Gives back a STACK_NODE that was just popped off the STACK, which
+		already points at the STACK_NODE below it.  If a clone still holds
+		the popped STACK_NODE it is left to the clone, and the STACK takes
+		a reference of its own to the STACK_NODE below.
+	*/
+	static void StackReleasePoppedNode(STACK *Stack, STACK_NODE *StackNode)
+	{
+		STACK_NODE *NextStackNode;
+
+		if(StackAtomicLoad(&StackNode->References) != (UINT32)1)
+		{
+			NextStackNode = (STACK_NODE*)(StackNode->Next);
+
+			if(NextStackNode != (STACK_NODE*)NULL)
+				StackAtomicAdd(&NextStackNode->References, (UINT32)1);
+
+			if(StackAtomicAdd(&StackNode->References, (UINT32)0xFFFFFFFF) != (UINT32)0)
+				return;
+
+			/*
+				The clones let go of it in the meantime, so the reference it
+				holds to the STACK_NODE below is one too many.
+			*/
+			if(NextStackNode != (STACK_NODE*)NULL)
+				StackAtomicAdd(&NextStackNode->References, (UINT32)0xFFFFFFFF);
+		}
+
+		StackReleaseNode(Stack, StackNode);
+	}
+#else
+	#define StackReleasePoppedNode(Stack, StackNode)	StackReleaseNode(Stack, StackNode)
+#endif // end of USING_STACK_PERSISTENT_METHODS
+
+#if (USING_STACK_CHUNKED_STORAGE == 1)
+	/*
+		Returns the top STACK_NODE of the STACK if it has a free slot, 
+		otherwise puts a new empty STACK_NODE on top of the STACK and 
+		returns that.  Returns (STACK_NODE*)NULL if no STACK_NODE could be
+		had, in which case the STACK is left as it was.
+	*/
+	static STACK_NODE *StackGetNodeWithRoom(STACK *Stack)
+	{
+		STACK_NODE *TempStackNode;
+
+		TempStackNode = (STACK_NODE*)(Stack->TopOfStack);
+
+		if(TempStackNode == (STACK_NODE*)NULL || TempStackNode->Count == Stack->ElementsPerNode)
+		{
+			if((TempStackNode = (STACK_NODE*)StackAllocateNode(Stack)) == (STACK_NODE*)NULL)
+			{
+				return (STACK_NODE*)NULL;
+			}
+
+			TempStackNode->Next = (STACK_NODE*)(Stack->TopOfStack);
+			TempStackNode->Count = (UINT32)0;
+			Stack->TopOfStack = (STACK_NODE*)TempStackNode;
+
+			StackNoteBottomNode(Stack, TempStackNode);
+		}
+
+		return (STACK_NODE*)TempStackNode;
+	}
+
+	/*
+		Returns the STACK_NODE holding the top item of a STACK that isn't
+		empty.  An emptied STACK_NODE is left on top of the STACK until the
+		pop after it, so pushing and popping right at a STACK_NODE boundary
+		doesn't allocate and free a STACK_NODE every time.  If Release is
+		TRUE such a STACK_NODE is freed here and the full STACK_NODE below 
+		becomes the top.
+	*/
+	static STACK_NODE *StackGetNodeWithData(STACK *Stack, BOOL Release)
+	{
+		STACK_NODE *TempStackNode;
+
+		TempStackNode = (STACK_NODE*)(Stack->TopOfStack);
+
+		if(TempStackNode->Count == (UINT32)0)
+		{
+			if(!Release)
+				return (STACK_NODE*)(TempStackNode->Next);
+
+			Stack->TopOfStack = (STACK_NODE*)(TempStackNode->Next);
+
+			StackReleaseNode(Stack, TempStackNode);
+
+			TempStackNode = (STACK_NODE*)(Stack->TopOfStack);
+		}
+
+		return (STACK_NODE*)TempStackNode;
+	}
+
+	/*
+		Called once an item has been taken out of the top STACK_NODE and the
+		STACK's size updated.  An empty STACK never holds on to a STACK_NODE,
+		that way a STACK that has been popped empty can be released like it
+		always could.
+	*/
+	static void StackItemRemoved(STACK *Stack, STACK_NODE *StackNode)
+	{
+		if(StackIsEmpty(Stack))
+		{
+			Stack->TopOfStack = (STACK_NODE*)NULL;
+
+			StackReleaseNode(Stack, StackNode);
+		}
+	}
+#endif // end of USING_STACK_CHUNKED_STORAGE
+
+#if (USING_STACK_NODE_CACHE == 1)
+	/*
+		Frees STACK_NODE's out of the STACK's node cache with 
+		StackMemDealloc() until it holds no more than Count of them.
+	*/
+	static void StackTrimNodeCache(STACK *Stack, UINT32 Count)
+	{
+		STACK_NODE *TempStackNode;
+
+		while(Stack->NodeCacheSize > Count)
+		{
+			TempStackNode = (STACK_NODE*)(Stack->NodeCache);
+			Stack->NodeCache = (STACK_NODE*)(TempStackNode->Next);
+			Stack->NodeCacheSize--;
+
+			StackDeallocate(Stack, (void*)TempStackNode);
+		}
+	}
+#endif // end of USING_STACK_NODE_CACHE
+
+#if (USING_STACK_SPILL_METHODS == 1) || (USING_STACK_SERIALIZE_METHODS == 1) || (USING_STACK_SEARCH_METHODS == 1)
+	/*
+		The number of items in the STACK_NODE.
+	*/
+	#if (USING_STACK_CHUNKED_STORAGE == 1)
+		#define StackNodeItemCount(StackNode)		((StackNode)->Count)
+	#else
+		#define StackNodeItemCount(StackNode)		(UINT32)1
+	#endif // end of USING_STACK_CHUNKED_STORAGE
+
+	/*
+		Returns the address of item Index of the STACK_NODE, which is the 
+		data pointer itself unless the STACK is a value STACK.
+	*/
+	static BYTE *StackSlotAddress(STACK *Stack, STACK_NODE *StackNode, UINT32 Index)
+	{
+		#if (USING_STACK_CHUNKED_STORAGE == 1)
+			return (BYTE*)StackNodeSlot(Stack, StackNode, Index);
+		#else
+			(void)Stack;
+			(void)Index;
+
+			#if (USING_STACK_VALUE_METHODS == 1)
+				if(StackIsValueStack(Stack))
+					return (BYTE*)(StackNode->Data);
+			#endif // end of USING_STACK_VALUE_METHODS
+
+			return (BYTE*)&(StackNode->Data);
+		#endif // end of USING_STACK_CHUNKED_STORAGE
+	}
+#endif // end of USING_STACK_SPILL_METHODS, USING_STACK_SERIALIZE_METHODS or USING_STACK_SEARCH_METHODS
+
+#if (USING_STACK_SPILL_METHODS == 1)
+
+	/*
+		Puts a copy of one item on top of the STACK's STACK_NODE's without
+		changing the STACK's size.  Returns FALSE if no STACK_NODE could be had.
+	*/
+	static BOOL StackPlaceSlot(STACK *Stack, const BYTE *Slot)
+	{
+		STACK_NODE *TempStackNode;
+
+		#if (USING_STACK_CHUNKED_STORAGE == 1)
+			if((TempStackNode = (STACK_NODE*)StackGetNodeWithRoom(Stack)) == (STACK_NODE*)NULL)
+				return (BOOL)FALSE;
+
+			memcpy((void*)StackNodeSlot(Stack, TempStackNode, TempStackNode->Count), (const void*)Slot, StackSlotSizeInBytes(Stack));
+			TempStackNode->Count++;
+		#else
+			if((TempStackNode = (STACK_NODE*)StackAllocateNode(Stack)) == (STACK_NODE*)NULL)
+				return (BOOL)FALSE;
+
+			#if (USING_STACK_VALUE_METHODS == 1)
+				TempStackNode->Data = (void*)(TempStackNode + 1);
+			#endif // end of USING_STACK_VALUE_METHODS
+
+			memcpy((void*)StackSlotAddress(Stack, TempStackNode, (UINT32)0), (const void*)Slot, StackSlotSizeInBytes(Stack));
+
+			TempStackNode->Next = (STACK_NODE*)(Stack->TopOfStack);
+			Stack->TopOfStack = (STACK_NODE*)TempStackNode;
+		#endif // end of USING_STACK_CHUNKED_STORAGE
+
+		return (BOOL)TRUE;
+	}
+
+	/*
+		Reverses a list of STACK_NODE's and returns its new first STACK_NODE.
+	*/
+	static STACK_NODE *StackReverseNodes(STACK_NODE *StackNode)
+	{
+		STACK_NODE *Reversed, *Next;
+
+		Reversed = (STACK_NODE*)NULL;
+
+		while(StackNode != (STACK_NODE*)NULL)
+		{
+			Next = (STACK_NODE*)(StackNode->Next);
+			StackNode->Next = (STACK_NODE*)Reversed;
+			Reversed = (STACK_NODE*)StackNode;
+			StackNode = (STACK_NODE*)Next;
+		}
+
+		return (STACK_NODE*)Reversed;
+	}
+
+	/*
+		Allocates the buffer items are moved to and from the spill file in.
+		*Items is set to the number of items it has room for, at least 1.
+	*/
+	static BYTE *StackAllocateSpillBuffer(STACK *Stack, UINT32 *Items)
+	{
+		(void)Stack;
+
+		*Items = (UINT32)(STACK_SPILL_BUFFER_SIZE / StackSlotSizeInBytes(Stack));
+
+		if(*Items == (UINT32)0)
+			*Items = (UINT32)1;
+
+		return (BYTE*)StackAllocate(Stack, *Items * StackSlotSizeInBytes(Stack));
+	}
+
+	/*
+		The number of items a spill leaves in memory, and a page in brings back.
+	*/
+	static UINT32 StackSpillBatchSize(STACK *Stack, UINT32 BufferItems)
+	{
+		if(Stack->MaxInMemoryItems / 2)
+			return (UINT32)(Stack->MaxInMemoryItems / 2);
+
+		return (UINT32)BufferItems;
+	}
+
+	/*
+		Moves every item below the top half of the STACK's memory budget out
+		to the end of the spilled items in its spill file, bottom first, and
+		frees their STACK_NODE's.  If the items couldn't be written the 
+		STACK is left as it was and FALSE is returned.
+	*/
+	static BOOL StackSpill(STACK *Stack)
+	{
+		STACK_NODE *TempStackNode, *SpillNodes;
+		BYTE *Buffer;
+		UINT32 BufferItems, Buffered, Kept, Keep, Spilled, i;
+		BOOL Success;
+
+		if((Buffer = (BYTE*)StackAllocateSpillBuffer(Stack, &BufferItems)) == (BYTE*)NULL)
+			return (BOOL)FALSE;
+
+		/*
+			Walk down past the items that stay in memory.  Every STACK_NODE
+			under them is full, so they can all go.
+		*/
+		Keep = (UINT32)StackSpillBatchSize(Stack, BufferItems);
+		TempStackNode = (STACK_NODE*)(Stack->TopOfStack);
+		Kept = (UINT32)StackNodeItemCount(TempStackNode);
+
+		while(Kept < Keep && TempStackNode->Next != (STACK_NODE*)NULL)
+		{
+			TempStackNode = (STACK_NODE*)(TempStackNode->Next);
+			Kept += StackNodeItemCount(TempStackNode);
+		}
+
+		if((SpillNodes = (STACK_NODE*)(TempStackNode->Next)) == (STACK_NODE*)NULL)
+		{
+			StackDeallocate(Stack, (void*)Buffer);
+
+			return (BOOL)TRUE;
+		}
+
+		if(Stack->SpillFile == (FILE*)NULL && (Stack->SpillFile = tmpfile()) == (FILE*)NULL)
+		{
+			StackDeallocate(Stack, (void*)Buffer);
+
+			return (BOOL)FALSE;
+		}
+
+		/*
+			The items go out bottom first, so the spill file always holds the
+			spilled part of the STACK in order and a page in only has to read
+			the end of it.
+		*/
+		TempStackNode->Next = (STACK_NODE*)NULL;
+		SpillNodes = (STACK_NODE*)StackReverseNodes(SpillNodes);
+
+		Success = (BOOL)(fseek(Stack->SpillFile, (long)((UINT64)Stack->SpilledSize * StackSlotSizeInBytes(Stack)), SEEK_SET) == 0);
+		Buffered = (UINT32)0;
+		Spilled = (UINT32)0;
+
+		for(TempStackNode = SpillNodes; Success && TempStackNode != (STACK_NODE*)NULL; TempStackNode = (STACK_NODE*)(TempStackNode->Next))
+		{
+			for(i = (UINT32)0; Success && i < StackNodeItemCount(TempStackNode); i++)
+			{
+				memcpy((void*)(Buffer + (Buffered * StackSlotSizeInBytes(Stack))), (const void*)StackSlotAddress(Stack, TempStackNode, i), StackSlotSizeInBytes(Stack));
+				Spilled++;
+
+				if(++Buffered == BufferItems)
+				{
+					Success = (BOOL)(fwrite((const void*)Buffer, StackSlotSizeInBytes(Stack), Buffered, Stack->SpillFile) == Buffered);
+					Buffered = (UINT32)0;
+				}
+			}
+		}
+
+		if(Success && Buffered)
+			Success = (BOOL)(fwrite((const void*)Buffer, StackSlotSizeInBytes(Stack), Buffered, Stack->SpillFile) == Buffered);
+
+		if(Success)
+			Success = (BOOL)(fflush(Stack->SpillFile) == 0);
+
+		StackDeallocate(Stack, (void*)Buffer);
+
+		if(!Success)
+		{
+			/*
+				Put the STACK_NODE's back the way they were.
+			*/
+			for(TempStackNode = (STACK_NODE*)(Stack->TopOfStack); TempStackNode->Next != (STACK_NODE*)NULL; TempStackNode = (STACK_NODE*)(TempStackNode->Next));
+
+			TempStackNode->Next = (STACK_NODE*)StackReverseNodes(SpillNodes);
+
+			return (BOOL)FALSE;
+		}
+
+		while((TempStackNode = SpillNodes) != (STACK_NODE*)NULL)
+		{
+			SpillNodes = (STACK_NODE*)(TempStackNode->Next);
+
+			StackReleaseNode(Stack, TempStackNode);
+		}
+
+		Stack->SpilledSize += Spilled;
+
+		return (BOOL)TRUE;
+	}
+
+	/*
+		Called after items are pushed.  If the STACK is over its memory
+		budget its bottom items are spilled.  If that fails the budget is
+		turned off, rather than walking the STACK again on every push.
+	*/
+	static void StackCheckMemoryBudget(STACK *Stack)
+	{
+		if(Stack->MaxInMemoryItems && StackInMemorySize(Stack) > Stack->MaxInMemoryItems)
+		{
+			if(!StackSpill(Stack))
+				Stack->MaxInMemoryItems = (UINT32)0;
+		}
+	}
+
+	/*
+		Called once every item left in memory has been popped.  Reads the
+		top spilled items back in from the end of the spill file, in one
+		pass, and puts them in STACK_NODE's.  Returns FALSE if they couldn't
+		be read back, in which case the STACK is left as it was.
+	*/
+	static BOOL StackPageIn(STACK *Stack)
+	{
+		STACK_NODE *TempStackNode;
+		BYTE *Buffer;
+		UINT32 BufferItems, Items, Read, Chunk, i;
+		BOOL Success;
+
+		if((Buffer = (BYTE*)StackAllocateSpillBuffer(Stack, &BufferItems)) == (BYTE*)NULL)
+			return (BOOL)FALSE;
+
+		Items = (UINT32)StackSpillBatchSize(Stack, BufferItems);
+
+		if(Items > Stack->SpilledSize)
+			Items = (UINT32)(Stack->SpilledSize);
+
+		Success = (BOOL)(fseek(Stack->SpillFile, (long)((UINT64)(Stack->SpilledSize - Items) * StackSlotSizeInBytes(Stack)), SEEK_SET) == 0);
+
+		for(Read = (UINT32)0; Success && Read < Items; Read += Chunk)
+		{
+			Chunk = (UINT32)(Items - Read);
+
+			if(Chunk > BufferItems)
+				Chunk = (UINT32)BufferItems;
+
+			if(fread((void*)Buffer, StackSlotSizeInBytes(Stack), Chunk, Stack->SpillFile) != Chunk)
+			{
+				Success = (BOOL)FALSE;
+
+				break;
+			}
+
+			for(i = (UINT32)0; Success && i < Chunk; i++)
+				Success = StackPlaceSlot(Stack, Buffer + (i * StackSlotSizeInBytes(Stack)));
+		}
+
+		StackDeallocate(Stack, (void*)Buffer);
+
+		if(!Success)
+		{
+			/*
+				Nothing was in memory before, so every STACK_NODE now in the
+				STACK only holds copies of items that are still in the file.
+			*/
+			while((TempStackNode = (STACK_NODE*)(Stack->TopOfStack)) != (STACK_NODE*)NULL)
+			{
+				Stack->TopOfStack = (STACK_NODE*)(TempStackNode->Next);
+
+				StackReleaseNode(Stack, TempStackNode);
+			}
+
+			return (BOOL)FALSE;
+		}
+
+		Stack->SpilledSize -= Items;
+
+		return (BOOL)TRUE;
+	}
+
+	#if (USING_STACK_CLEAR_METHOD == 1)
+		/*
+			Frees the data of every spilled item if the STACK has a free
+			method, then closes the spill file and takes the spilled items
+			out of the STACK's size.
+		*/
+		static void StackDropSpilledItems(STACK *Stack)
+		{
+			#if(USING_STACK_DEPENDENT_FREE_METHOD == 1)
+				void *Data;
+
+				if(Stack->StackFreeMethod && !fseek(Stack->SpillFile, 0L, SEEK_SET))
+				{
+					while(Stack->SpilledSize && fread((void*)&Data, sizeof(void*), 1, Stack->SpillFile) == 1)
+					{
+						Stack->StackFreeMethod(Data);
+						Stack->SpilledSize--;
+						Stack->Size--;
+					}
+				}
+			#endif // of USING_STACK_DEPENDENT_FREE_METHOD
+
+			fclose(Stack->SpillFile);
+
+			Stack->SpillFile = (FILE*)NULL;
+			Stack->Size -= Stack->SpilledSize;
+			Stack->SpilledSize = (UINT32)0;
+		}
+	#endif // end of USING_STACK_CLEAR_METHOD
+#endif // end of USING_STACK_SPILL_METHODS
+
+STACK *CreateStack(STACK *Stack, void (*CustomFreeMethod)(void *Data))
+{
+	/*
+		If Stack is equal to (STACK*)NULL then the user wants to
+		create a new STACK in memory
+	*/
+	if(StackIsNull(Stack))
+	{
+		if((Stack = (STACK*)StackMemAlloc(sizeof(STACK))) == (STACK*)NULL)
+		{
+			return (STACK*)NULL;
+		}
+	}
+
+	/*
+		Initialize the STACK to it's defualt values.
+	*/
+	Stack->Size = (UINT32)0;
+	Stack->TopOfStack = (STACK_NODE*)NULL;
+
+	#if(USING_STACK_DEPENDENT_FREE_METHOD == 1)
+		Stack->StackFreeMethod = (void (*)(void *))CustomFreeMethod;
+	#else
+		(void)CustomFreeMethod;
+	#endif // end of USING_STACK_DEPENDENT_FREE_METHOD
+
+	#if (USING_STACK_ALLOCATORS == 1)
+		Stack->Allocator.Alloc = StackDefaultAlloc;
+		Stack->Allocator.Free = StackDefaultFree;
+		Stack->Allocator.Context = (void*)NULL;
+	#endif // end of USING_STACK_ALLOCATORS
+
+	#if (USING_STACK_NODE_CACHE == 1)
+		Stack->NodeCache = (STACK_NODE*)NULL;
+		Stack->NodeCacheSize = (UINT32)0;
+		Stack->NodeCacheLimit = (UINT32)STACK_NODE_CACHE_DEFAULT_LIMIT;
+	#endif // end of USING_STACK_NODE_CACHE
+
+	#if (USING_STACK_SPILL_METHODS == 1)
+		Stack->MaxInMemoryItems = (UINT32)0;
+		Stack->SpilledSize = (UINT32)0;
+		Stack->SpillFile = (FILE*)NULL;
+	#endif // end of USING_STACK_SPILL_METHODS
+
+	#if (USING_STACK_SERIALIZE_METHODS == 1)
+		Stack->View = (const BYTE*)NULL;
+	#endif // end of USING_STACK_SERIALIZE_METHODS
+
+	#if (USING_STACK_NODE_ARENA == 1)
+		Stack->ArenaBlocks = (STACK_ARENA_BLOCK*)NULL;
+		Stack->ArenaNext = (BYTE*)NULL;
+		Stack->ArenaBytesLeft = (UINT32)0;
+		Stack->ArenaFreeNodes = (STACK_NODE*)NULL;
+
+		#if (USING_STACK_MARK_METHODS == 1)
+			Stack->ArenaFreeFloor = (STACK_NODE*)NULL;
+			Stack->ArenaGeneration = (UINT32)0;
+			Stack->MarkSerial = (UINT32)0;
+			Stack->NewestMark = (UINT32)0;
+			Stack->NewestPrevious = (UINT32)0;
+			Stack->NewestLowWater = (UINT32)0xFFFFFFFF;
+			Stack->MarkLowWater = (UINT32)0xFFFFFFFF;
+			Stack->MarkDip = (UINT32)0xFFFFFFFF;
+		#endif // end of USING_STACK_MARK_METHODS
+	#endif // end of USING_STACK_NODE_ARENA
+
+	#if (USING_STACK_INLINE_BUFFER == 1)
+		Stack->InlineBytesUsed = (UINT32)0;
+		Stack->InlineNodesInUse = (UINT32)0;
+		Stack->InlineFreeNodes = (STACK_NODE*)NULL;
+	#endif // end of USING_STACK_INLINE_BUFFER
+
+	#if (USING_STACK_CHUNKED_STORAGE == 1)
+		Stack->ElementsPerNode = (UINT32)STACK_DEFAULT_ELEMENTS_PER_NODE;
+	#endif // end of USING_STACK_CHUNKED_STORAGE
+
+	#if (USING_STACK_VALUE_METHODS == 1)
+		Stack->ElementSize = (UINT32)0;
+	#endif // end of USING_STACK_VALUE_METHODS
+
+	#if (USING_STACK_BOUNDED_METHODS == 1)
+		Stack->Buffer = (void**)NULL;
+		Stack->Capacity = (UINT32)0;
+	#endif // end of USING_STACK_BOUNDED_METHODS
+
+	#if (USING_STACK_STATISTICS == 1)
+		StackResetStats(Stack);
+	#endif // end of USING_STACK_STATISTICS
+
+	return (STACK*)Stack;
+}
+
+#if (USING_STACK_ALLOCATORS == 1)
+	STACK *CreateStackWithAllocator(STACK *Stack, void (*CustomFreeMethod)(void *Data), const STACK_ALLOCATOR *Allocator)
+	{
+		#if (STACK_SAFE_MODE == 1)
+			if(Allocator == (const STACK_ALLOCATOR*)NULL || Allocator->Alloc == NULL || Allocator->Free == NULL)
+				return (STACK*)NULL;
+		#endif // end of STACK_SAFE_MODE
+
+		if((Stack = CreateStack(Stack, CustomFreeMethod)) == (STACK*)NULL)
+			return (STACK*)NULL;
+
+		Stack->Allocator = *Allocator;
+
+		return (STACK*)Stack;
+	}
+
+	BOOL StackSetAllocator(STACK *Stack, const STACK_ALLOCATOR *Allocator)
+	{
+		#if (STACK_SAFE_MODE == 1)
+			if(StackIsNull(Stack))
+				return (BOOL)FALSE;
+
+			if(Allocator == (const STACK_ALLOCATOR*)NULL || Allocator->Alloc == NULL || Allocator->Free == NULL)
+				return (BOOL)FALSE;
+		#endif // end of STACK_SAFE_MODE
+
+		/*
+			Anything the STACK already got from its old allocator has to go
+			back to it, so the allocator can only be changed while the STACK
+			holds no memory of its own.
+		*/
+		if(Stack->TopOfStack != (STACK_NODE*)NULL)
+			return (BOOL)FALSE;
+
+		#if (USING_STACK_NODE_CACHE == 1)
+			if(Stack->NodeCacheSize)
+				return (BOOL)FALSE;
+		#endif // end of USING_STACK_NODE_CACHE
+
+		#if (USING_STACK_NODE_ARENA == 1)
+			if(Stack->ArenaBlocks != (STACK_ARENA_BLOCK*)NULL)
+				return (BOOL)FALSE;
+		#endif // end of USING_STACK_NODE_ARENA
+
+		Stack->Allocator = *Allocator;
+
+		return (BOOL)TRUE;
+	}
+#endif // end of USING_STACK_ALLOCATORS
+
+#if (USING_STACK_CHUNKED_STORAGE == 1)
+	STACK *CreateChunkedStack(STACK *Stack, void (*CustomFreeMethod)(void *Data), UINT32 ElementsPerNode)
+	{
+		#if (STACK_SAFE_MODE == 1)
+			if(ElementsPerNode == (UINT32)0)
+				return (STACK*)NULL;
+		#endif // end of STACK_SAFE_MODE
+
+		if((Stack = CreateStack(Stack, CustomFreeMethod)) == (STACK*)NULL)
+			return (STACK*)NULL;
+
+		Stack->ElementsPerNode = (UINT32)ElementsPerNode;
+
+		return (STACK*)Stack;
+	}
+#endif // end of USING_STACK_CHUNKED_STORAGE
+
+#if (USING_STACK_VALUE_METHODS == 1)
+	STACK *CreateValueStack(STACK *Stack, UINT32 ElementSize)
+	{
+		#if (STACK_SAFE_MODE == 1)
+			if(ElementSize == (UINT32)0)
+				return (STACK*)NULL;
+		#endif // end of STACK_SAFE_MODE
+
+		/*
+			The items are copies owned by the STACK, so there is never 
+			anything for a free method to do.
+		*/
+		if((Stack = CreateStack(Stack, (void (*)(void *))NULL)) == (STACK*)NULL)
+			return (STACK*)NULL;
+
+		Stack->ElementSize = (UINT32)ElementSize;
+
+		return (STACK*)Stack;
+	}
+#endif // end of USING_STACK_VALUE_METHODS
+
+#if (USING_STACK_BOUNDED_METHODS == 1)
+	STACK *CreateBoundedStack(STACK *Stack, void (*CustomFreeMethod)(void *Data), void **Buffer, UINT32 Capacity)
+	{
+		#if (STACK_SAFE_MODE == 1)
+			if(Buffer == (void**)NULL || Capacity == (UINT32)0)
+				return (STACK*)NULL;
+		#endif // end of STACK_SAFE_MODE
+
+		if((Stack = CreateStack(Stack, CustomFreeMethod)) == (STACK*)NULL)
+			return (STACK*)NULL;
+
+		Stack->Buffer = (void**)Buffer;
+		Stack->Capacity = (UINT32)Capacity;
+
+		return (STACK*)Stack;
+	}
+#endif // end of USING_STACK_BOUNDED_METHODS
+
+#if (USING_STACK_PERSISTENT_METHODS == 1)
+	STACK *StackClone(STACK *Stack, STACK *Clone)
+	{
+		#if (STACK_SAFE_MODE == 1)
+			if(StackIsNull(Stack))
+				return (STACK*)NULL;
+		#endif // end of STACK_SAFE_MODE
+
+		/*
+			Only STACK_NODE's can be shared, a bounded STACK's buffer or a
+			view's can't.
+		*/
+		#if (USING_STACK_BOUNDED_METHODS == 1)
+			if(StackIsBounded(Stack))
+				return (STACK*)NULL;
+		#endif // end of USING_STACK_BOUNDED_METHODS
+
+		#if (USING_STACK_SERIALIZE_METHODS == 1)
+			if(StackIsView(Stack))
+				return (STACK*)NULL;
+		#endif // end of USING_STACK_SERIALIZE_METHODS
+
+		#if(USING_STACK_DEPENDENT_FREE_METHOD == 1)
+			Clone = CreateStack(Clone, Stack->StackFreeMethod);
+		#else
+			Clone = CreateStack(Clone, (void (*)(void *))NULL);
+		#endif // end of USING_STACK_DEPENDENT_FREE_METHOD
+
+		if(Clone == (STACK*)NULL)
+			return (STACK*)NULL;
+
+		/*
+			The STACK_NODE's are freed by whichever STACK lets go of them
+			last, so the clone has to free them the same way.
+		*/
+		#if (USING_STACK_ALLOCATORS == 1)
+			Clone->Allocator = Stack->Allocator;
+		#endif // end of USING_STACK_ALLOCATORS
+
+		#if (USING_STACK_VALUE_METHODS == 1)
+			Clone->ElementSize = Stack->ElementSize;
+		#endif // end of USING_STACK_VALUE_METHODS
+
+		#if (USING_STACK_NODE_CACHE == 1)
+			Clone->NodeCacheLimit = Stack->NodeCacheLimit;
+		#endif // end of USING_STACK_NODE_CACHE
+
+		/*
+			The clone points at the same top STACK_NODE, and so at every
+			STACK_NODE below it.
+		*/
+		if(Stack->TopOfStack != (STACK_NODE*)NULL)
+			StackAtomicAdd(&Stack->TopOfStack->References, (UINT32)1);
+
+		Clone->TopOfStack = (STACK_NODE*)(Stack->TopOfStack);
+		Clone->Size = Stack->Size;
+
+		return (STACK*)Clone;
+	}
+#endif // end of USING_STACK_PERSISTENT_METHODS
+
+BOOL StackPush(STACK *Stack, const void *Data)
+{
+	STACK_NODE *TempStackNode;
+
+	#if (USING_STACK_LATENCY_HISTOGRAM == 1)
+		UINT64 StartTime;
+	#endif // end of USING_STACK_LATENCY_HISTOGRAM
+
+	#if (STACK_SAFE_MODE == 1)
+		if(StackIsNull(Stack))
+			return (BOOL)FALSE;
+
+		#if (USING_STACK_VALUE_METHODS == 1)
+			if(StackIsValueStack(Stack))
+				return (BOOL)FALSE;
+		#endif // end of USING_STACK_VALUE_METHODS
+	#endif // end of STACK_SAFE_MODE
+
+	#if (USING_STACK_LATENCY_HISTOGRAM == 1)
+		StartTime = StackLatencySampleStart(Stack);
+	#endif // end of USING_STACK_LATENCY_HISTOGRAM
+
+	#if (USING_STACK_BOUNDED_METHODS == 1)
+		/*
+			A bounded STACK just fills in the next slot of its buffer.
+		*/
+		if(StackIsBounded(Stack))
+		{
+			if(StackIsFull(Stack))
+				return (BOOL)FALSE;
+
+			Stack->Buffer[Stack->Size++] = (void*)Data;
+
+			#if (USING_STACK_STATISTICS == 1)
+				StackStatsPushed(Stack, (UINT32)1);
+			#endif // end of USING_STACK_STATISTICS
+
+			#if (USING_STACK_LATENCY_HISTOGRAM == 1)
+				StackLatencySampleEnd(Stack->Stats.PushLatency, StartTime);
+			#endif // end of USING_STACK_LATENCY_HISTOGRAM
+
+			return (BOOL)TRUE;
+		}
+	#endif // end of USING_STACK_BOUNDED_METHODS
+
+	#if (USING_STACK_CHUNKED_STORAGE == 1)
+		/*
+			Only when the top STACK_NODE is full (or there isn't one) does a new
+			STACK_NODE have to be put on top of the STACK.
+		*/
+		if((TempStackNode = (STACK_NODE*)StackGetNodeWithRoom(Stack)) == (STACK_NODE*)NULL)
+		{
+			return (BOOL)FALSE;
+		}
+
+		/*
+			Store the data in the next free slot of the top STACK_NODE and
+			increment the STACK size by 1 to reflect the new Stack size.
+		*/
+		TempStackNode->Data[TempStackNode->Count++] = (void*)Data;
+		Stack->Size++;
+	#else
+		/*
+			Get a STACK_NODE, either out of the node cache or from StackMemAlloc().
+		*/
+		if((TempStackNode = (STACK_NODE*)StackAllocateNode(Stack)) == (STACK_NODE*)NULL)
+		{
+			return (BOOL)FALSE;
+		}
+
+		/*
+			Place the newly allocated STACK_NODE on top of the STACK have the new
+			STACK_NODE point to the old top of stack.
+
+			Also have the new STACK_NODE point to the data passed in by the user.
+
+			Also increment the STACK size by 1 to reflect the new Stack size.
+		*/
+		TempStackNode->Next = (STACK_NODE*)(Stack->TopOfStack);
+		TempStackNode->Data = (void*)Data;
+		Stack->TopOfStack = (STACK_NODE*)TempStackNode;
+
+		StackNoteBottomNode(Stack, TempStackNode);
+
+		#if (USING_STACK_PERSISTENT_METHODS == 1)
+			TempStackNode->References = (UINT32)1;
+		#endif // end of USING_STACK_PERSISTENT_METHODS
+		Stack->Size++;
+	#endif // end of USING_STACK_CHUNKED_STORAGE
+
+	#if (USING_STACK_SPILL_METHODS == 1)
+		StackCheckMemoryBudget(Stack);
+	#endif // end of USING_STACK_SPILL_METHODS
+
+	#if (USING_STACK_STATISTICS == 1)
+		StackStatsPushed(Stack, (UINT32)1);
+	#endif // end of USING_STACK_STATISTICS
+
+	#if (USING_STACK_LATENCY_HISTOGRAM == 1)
+		StackLatencySampleEnd(Stack->Stats.PushLatency, StartTime);
+	#endif // end of USING_STACK_LATENCY_HISTOGRAM
+
+	return (BOOL)TRUE;
+}
+
+void *StackPop(STACK *Stack)
+{
+	void *Data;
+	STACK_NODE *TempStackNode;
+
+	#if (USING_STACK_LATENCY_HISTOGRAM == 1)
+		UINT64 StartTime;
+	#endif // end of USING_STACK_LATENCY_HISTOGRAM
+
+	#if (STACK_SAFE_MODE == 1)
+		if(StackIsNull(Stack))
+			return (void*)NULL;
+	
+		if(StackIsEmpty(Stack))
+			return (void*)NULL;
+
+		#if (USING_STACK_VALUE_METHODS == 1)
+			if(StackIsValueStack(Stack))
+				return (void*)NULL;
+		#endif // end of USING_STACK_VALUE_METHODS
+	#endif // end of STACK_SAFE_MODE
+
+	#if (USING_STACK_SPILL_METHODS == 1)
+		if(StackNeedsPageIn(Stack) && !StackPageIn(Stack))
+			return (void*)NULL;
+	#endif // end of USING_STACK_SPILL_METHODS
+
+	#if (USING_STACK_LATENCY_HISTOGRAM == 1)
+		StartTime = StackLatencySampleStart(Stack);
+	#endif // end of USING_STACK_LATENCY_HISTOGRAM
+
+	#if (USING_STACK_BOUNDED_METHODS == 1)
+		if(StackIsBounded(Stack))
+		{
+			Data = (void*)(Stack->Buffer[--Stack->Size]);
+
+			#if (USING_STACK_NODE_ARENA == 1)
+				StackArenaItemsRemoved(Stack);
+			#endif // end of USING_STACK_NODE_ARENA
+
+			#if (USING_STACK_STATISTICS == 1)
+				Stack->Stats.Pops++;
+			#endif // end of USING_STACK_STATISTICS
+
+			#if (USING_STACK_LATENCY_HISTOGRAM == 1)
+				StackLatencySampleEnd(Stack->Stats.PopLatency, StartTime);
+			#endif // end of USING_STACK_LATENCY_HISTOGRAM
+
+			return (void*)Data;
+		}
+	#endif // end of USING_STACK_BOUNDED_METHODS
+
+	#if (USING_STACK_CHUNKED_STORAGE == 1)
+		TempStackNode = (STACK_NODE*)StackGetNodeWithData(Stack, (BOOL)TRUE);
+
+		/*
+			Take the data out of the last used slot of the top STACK_NODE and
+			decrement the STACK's size to reflect the change.
+		*/
+		Data = (void*)(TempStackNode->Data[--TempStackNode->Count]);
+		Stack->Size--;
+
+		StackItemRemoved(Stack, TempStackNode);
+	#else
+		TempStackNode = (STACK_NODE*)(Stack->TopOfStack);
+
+		/*
+			Read in the top STACK_NODE's data to a temp pointer for returning later.
+			Decrement the STACK's size to reflect the change and then free the top
+			STACK_NODE from the STACK and have the new top of Stack point to the 
+			next STACK_NODE in the Stack.
+		*/
+		Data = (void*)(TempStackNode->Data);
+		Stack->Size--;
+		Stack->TopOfStack = (STACK_NODE*)(Stack->TopOfStack->Next);
+		
+		StackReleasePoppedNode(Stack, TempStackNode);
+	#endif // end of USING_STACK_CHUNKED_STORAGE
+
+	#if (USING_STACK_NODE_ARENA == 1)
+		StackArenaItemsRemoved(Stack);
+	#endif // end of USING_STACK_NODE_ARENA
+
+	#if (USING_STACK_STATISTICS == 1)
+		Stack->Stats.Pops++;
+	#endif // end of USING_STACK_STATISTICS
+
+	#if (USING_STACK_LATENCY_HISTOGRAM == 1)
+		StackLatencySampleEnd(Stack->Stats.PopLatency, StartTime);
+	#endif // end of USING_STACK_LATENCY_HISTOGRAM
+
+	return (void*)Data;
+}
+
+#if (USING_STACK_PUSH_MANY_METHOD == 1)
+	BOOL StackPushMany(STACK *Stack, void **Data, UINT32 Count)
+	{
+		STACK_NODE *NewTopOfStack, *TempStackNode;
+
+		#if (STACK_SAFE_MODE == 1)
+			if(StackIsNull(Stack))
+				return (BOOL)FALSE;
+
+			if(Count && Data == (void**)NULL)
+				return (BOOL)FALSE;
+
+			#if (USING_STACK_VALUE_METHODS == 1)
+				if(StackIsValueStack(Stack))
+					return (BOOL)FALSE;
+			#endif // end of USING_STACK_VALUE_METHODS
+		#endif // end of STACK_SAFE_MODE
+
+		if(Count == (UINT32)0)
+			return (BOOL)TRUE;
+
+		#if (USING_STACK_BOUNDED_METHODS == 1)
+			if(StackIsBounded(Stack))
+			{
+				UINT32 i;
+
+				/*
+					The whole batch has to fit, or none of it is pushed.
+				*/
+				if(Count > Stack->Capacity - Stack->Size)
+					return (BOOL)FALSE;
+
+				for(i = (UINT32)0; i < Count; i++)
+					Stack->Buffer[Stack->Size + i] = (void*)(Data[i]);
+
+				Stack->Size += Count;
+
+				#if (USING_STACK_STATISTICS == 1)
+					StackStatsPushed(Stack, Count);
+				#endif // end of USING_STACK_STATISTICS
+
+				return (BOOL)TRUE;
+			}
+		#endif // end of USING_STACK_BOUNDED_METHODS
+
+		NewTopOfStack = (STACK_NODE*)NULL;
+
+		#if (USING_STACK_CHUNKED_STORAGE == 1)
+		{
+			UINT32 FreeSlots, NumberOfNodes, Index, Slots;
+
+			/*
+				First work out how much of the batch fits in the free slots of
+				the top STACK_NODE, and how many new STACK_NODE's the rest needs.
+			*/
+			TempStackNode = (STACK_NODE*)(Stack->TopOfStack);
+			FreeSlots = (TempStackNode == (STACK_NODE*)NULL) ? (UINT32)0 : (UINT32)(Stack->ElementsPerNode - TempStackNode->Count);
+
+			if(Count > FreeSlots)
+				NumberOfNodes = (UINT32)((Count - FreeSlots + Stack->ElementsPerNode - 1) / Stack->ElementsPerNode);
+			else
+				NumberOfNodes = (UINT32)0;
+
+			/*
+				Get all the new STACK_NODE's before touching the STACK, so that
+				running out of memory leaves the STACK as it was.  They are
+				chained with the last one to be filled first in the chain.
+			*/
+			while(NumberOfNodes--)
+			{
+				if((TempStackNode = (STACK_NODE*)StackAllocateNode(Stack)) == (STACK_NODE*)NULL)
+				{
+					while((TempStackNode = NewTopOfStack) != (STACK_NODE*)NULL)
+					{
+						NewTopOfStack = (STACK_NODE*)(TempStackNode->Next);
+
+						StackReleaseNode(Stack, TempStackNode);
+					}
+
+					return (BOOL)FALSE;
+				}
+
+				TempStackNode->Count = (UINT32)0;
+				TempStackNode->Next = (STACK_NODE*)NewTopOfStack;
+				NewTopOfStack = (STACK_NODE*)TempStackNode;
+			}
+
+			/*
+				Fill the top STACK_NODE, then each new STACK_NODE in turn while
+				pushing it on top of the STACK.
+			*/
+			Index = (UINT32)0;
+			TempStackNode = (STACK_NODE*)(Stack->TopOfStack);
+
+			if(TempStackNode == (STACK_NODE*)NULL || TempStackNode->Count == Stack->ElementsPerNode)
+			{
+				TempStackNode = (STACK_NODE*)NewTopOfStack;
+				NewTopOfStack = (STACK_NODE*)(NewTopOfStack->Next);
+				TempStackNode->Next = (STACK_NODE*)(Stack->TopOfStack);
+				Stack->TopOfStack = (STACK_NODE*)TempStackNode;
+
+				StackNoteBottomNode(Stack, TempStackNode);
+			}
+
+			for(;;)
+			{
+				Slots = (UINT32)(Stack->ElementsPerNode - TempStackNode->Count);
+
+				if(Slots > Count - Index)
+					Slots = (UINT32)(Count - Index);
+
+				while(Slots--)
+					TempStackNode->Data[TempStackNode->Count++] = (void*)(Data[Index++]);
+
+				if(Index == Count)
+					break;
+
+				TempStackNode = (STACK_NODE*)NewTopOfStack;
+				NewTopOfStack = (STACK_NODE*)(NewTopOfStack->Next);
+				TempStackNode->Next = (STACK_NODE*)(Stack->TopOfStack);
+				Stack->TopOfStack = (STACK_NODE*)TempStackNode;
+			}
+		}
+		#else
+		{
+			STACK_NODE *NewBottomNode;
+			UINT32 i;
+
+			NewBottomNode = (STACK_NODE*)NULL;
+
+			/*
+				Build the whole batch as a chain of STACK_NODE's off to the side,
+				Data[Count - 1] on top, so running out of memory leaves the
+				STACK as it was.
+			*/
+			for(i = (UINT32)0; i < Count; i++)
+			{
+				if((TempStackNode = (STACK_NODE*)StackAllocateNode(Stack)) == (STACK_NODE*)NULL)
+				{
+					while((TempStackNode = NewTopOfStack) != (STACK_NODE*)NULL)
+					{
+						NewTopOfStack = (STACK_NODE*)(TempStackNode->Next);
+
+						StackReleaseNode(Stack, TempStackNode);
+					}
+
+					return (BOOL)FALSE;
+				}
+
+				TempStackNode->Data = (void*)(Data[i]);
+				TempStackNode->Next = (STACK_NODE*)NewTopOfStack;
+				NewTopOfStack = (STACK_NODE*)TempStackNode;
+
+				#if (USING_STACK_PERSISTENT_METHODS == 1)
+					TempStackNode->References = (UINT32)1;
+				#endif // end of USING_STACK_PERSISTENT_METHODS
+
+				if(NewBottomNode == (STACK_NODE*)NULL)
+					NewBottomNode = (STACK_NODE*)TempStackNode;
+			}
+
+			/*
+				Splice the chain on top of the STACK in one go.
+			*/
+			NewBottomNode->Next = (STACK_NODE*)(Stack->TopOfStack);
+			Stack->TopOfStack = (STACK_NODE*)NewTopOfStack;
+
+			StackNoteBottomNode(Stack, NewBottomNode);
+		}
+		#endif // end of USING_STACK_CHUNKED_STORAGE
+
+		Stack->Size += Count;
+
+		#if (USING_STACK_SPILL_METHODS == 1)
+			StackCheckMemoryBudget(Stack);
+		#endif // end of USING_STACK_SPILL_METHODS
+
+		#if (USING_STACK_STATISTICS == 1)
+			StackStatsPushed(Stack, Count);
+		#endif // end of USING_STACK_STATISTICS
+
+		return (BOOL)TRUE;
+	}
+#endif // end of USING_STACK_PUSH_MANY_METHOD
+
+#if (USING_STACK_POP_MANY_METHOD == 1)
+	UINT32 StackPopMany(STACK *Stack, void **Data, UINT32 Count)
+	{
+		STACK_NODE *TempStackNode;
+		UINT32 i;
+
+		#if (STACK_SAFE_MODE == 1)
+			if(StackIsNull(Stack))
+				return (UINT32)0;
+
+			if(Data == (void**)NULL)
+				return (UINT32)0;
+
+			#if (USING_STACK_VALUE_METHODS == 1)
+				if(StackIsValueStack(Stack))
+					return (UINT32)0;
+			#endif // end of USING_STACK_VALUE_METHODS
+		#endif // end of STACK_SAFE_MODE
+
+		/*
+			Never pop more than the STACK holds.
+		*/
+		if(Count > Stack->Size)
+			Count = (UINT32)(Stack->Size);
+
+		i = (UINT32)0;
+
+		#if (USING_STACK_BOUNDED_METHODS == 1)
+			if(StackIsBounded(Stack))
+			{
+				for(; i < Count; i++)
+					Data[i] = (void*)(Stack->Buffer[Stack->Size - 1 - i]);
+			}
+		#endif // end of USING_STACK_BOUNDED_METHODS
+
+		while(i < Count)
+		{
+			#if (USING_STACK_SPILL_METHODS == 1)
+				/*
+					Everything left in memory has been popped, read the next
+					items back in from the spill file.
+				*/
+				if(Stack->Size - i == Stack->SpilledSize && !StackPageIn(Stack))
+				{
+					Count = (UINT32)i;
+
+					break;
+				}
+			#endif // end of USING_STACK_SPILL_METHODS
+
+			TempStackNode = (STACK_NODE*)(Stack->TopOfStack);
+
+			#if (USING_STACK_CHUNKED_STORAGE == 1)
+				/*
+					Empty out the top STACK_NODE from its top slot down, and
+					only free it once it has nothing left in it.
+				*/
+				while(TempStackNode->Count && i < Count)
+					Data[i++] = (void*)(TempStackNode->Data[--TempStackNode->Count]);
+
+				if(TempStackNode->Count)
+					break;
+			#else
+				Data[i++] = (void*)(TempStackNode->Data);
+			#endif // end of USING_STACK_CHUNKED_STORAGE
+
+			Stack->TopOfStack = (STACK_NODE*)(TempStackNode->Next);
+
+			StackReleasePoppedNode(Stack, TempStackNode);
+		}
+
+		Stack->Size -= Count;
+
+		#if (USING_STACK_NODE_ARENA == 1)
+			StackArenaItemsRemoved(Stack);
+		#endif // end of USING_STACK_NODE_ARENA
+
+		#if (USING_STACK_STATISTICS == 1)
+			Stack->Stats.Pops += Count;
+		#endif // end of USING_STACK_STATISTICS
+
+		return (UINT32)Count;
+	}
+#endif // end of USING_STACK_POP_MANY_METHOD
+
+#if (USING_STACK_SPLICE_METHODS == 1)
+	/*
+		Returns TRUE if STACK_NODE's can be moved from one of the STACK's to
+		the other.  Both have to lay their STACK_NODE's out the same way,
+		get them from the same STACK_ALLOCATOR and free their data with 
+		the same free method.
+	*/
+	static BOOL StackCanShareNodes(STACK *Stack1, STACK *Stack2)
+	{
+		#if (USING_STACK_BOUNDED_METHODS == 1)
+			if(StackIsBounded(Stack1) || StackIsBounded(Stack2))
+				return (BOOL)FALSE;
+		#endif // end of USING_STACK_BOUNDED_METHODS
+
+		#if (USING_STACK_SERIALIZE_METHODS == 1)
+			if(StackIsView(Stack1) || StackIsView(Stack2))
+				return (BOOL)FALSE;
+		#endif // end of USING_STACK_SERIALIZE_METHODS
+
+		#if (USING_STACK_CHUNKED_STORAGE == 1)
+			if(Stack1->ElementsPerNode != Stack2->ElementsPerNode)
+				return (BOOL)FALSE;
+		#endif // end of USING_STACK_CHUNKED_STORAGE
+
+		#if (USING_STACK_VALUE_METHODS == 1)
+			if(Stack1->ElementSize != Stack2->ElementSize)
+				return (BOOL)FALSE;
+		#endif // end of USING_STACK_VALUE_METHODS
+
+		#if(USING_STACK_DEPENDENT_FREE_METHOD == 1)
+			if(Stack1->StackFreeMethod != Stack2->StackFreeMethod)
+				return (BOOL)FALSE;
+		#endif // end of USING_STACK_DEPENDENT_FREE_METHOD
+
+		#if (USING_STACK_ALLOCATORS == 1)
+			if(Stack1->Allocator.Alloc != Stack2->Allocator.Alloc || Stack1->Allocator.Free != Stack2->Allocator.Free || Stack1->Allocator.Context != Stack2->Allocator.Context)
+				return (BOOL)FALSE;
+		#endif // end of USING_STACK_ALLOCATORS
+
+		return (BOOL)TRUE;
+	}
+
+	BOOL StackSplice(STACK *Destination, STACK *Source)
+	{
+		#if (STACK_SAFE_MODE == 1)
+			if(StackIsNull(Destination) || StackIsNull(Source) || Destination == Source)
+				return (BOOL)FALSE;
+		#endif // end of STACK_SAFE_MODE
+
+		if(!StackCanShareNodes(Destination, Source))
+			return (BOOL)FALSE;
+
+		if(StackIsEmpty(Source))
+			return (BOOL)TRUE;
+
+		#if (USING_STACK_CHUNKED_STORAGE == 1)
+			/*
+				Only the top STACK_NODE may be empty, so an emptied one on top of
+				Destination has to go before it ends up in the middle.
+			*/
+			if(!StackIsEmpty(Destination))
+				StackGetNodeWithData(Destination, (BOOL)TRUE);
+		#endif // end of USING_STACK_CHUNKED_STORAGE
+
+		/*
+			Hang Destination's STACK_NODE's under the bottom of Source, and
+			make the top of Source the top of Destination.
+		*/
+		Source->BottomOfStack->Next = (STACK_NODE*)(Destination->TopOfStack);
+
+		if(Destination->TopOfStack == (STACK_NODE*)NULL)
+			Destination->BottomOfStack = (STACK_NODE*)(Source->BottomOfStack);
+
+		Destination->TopOfStack = (STACK_NODE*)(Source->TopOfStack);
+		Destination->Size += Source->Size;
+
+		#if (USING_STACK_STATISTICS == 1)
+			StackStatsPushed(Destination, Source->Size);
+			Source->Stats.Pops += Source->Size;
+		#endif // end of USING_STACK_STATISTICS
+
+		Source->TopOfStack = (STACK_NODE*)NULL;
+		Source->Size = (UINT32)0;
+
+		return (BOOL)TRUE;
+	}
+
+	STACK *StackSplitTop(STACK *Stack, UINT32 Count, STACK *Top)
+	{
+		STACK_NODE *TempStackNode;
+		UINT32 Items;
+
+		#if (USING_STACK_CHUNKED_STORAGE == 1)
+			STACK_NODE *PreviousStackNode, *NewStackNode;
+			UINT32 Moved;
+		#endif // end of USING_STACK_CHUNKED_STORAGE
+
+		#if (STACK_SAFE_MODE == 1)
+			if(StackIsNull(Stack) || Stack == Top)
+				return (STACK*)NULL;
+		#endif // end of STACK_SAFE_MODE
+
+		if(Count > Stack->Size)
+			return (STACK*)NULL;
+
+		#if (USING_STACK_BOUNDED_METHODS == 1)
+			if(StackIsBounded(Stack))
+				return (STACK*)NULL;
+		#endif // end of USING_STACK_BOUNDED_METHODS
+
+		#if (USING_STACK_SERIALIZE_METHODS == 1)
+			if(StackIsView(Stack))
+				return (STACK*)NULL;
+		#endif // end of USING_STACK_SERIALIZE_METHODS
+
+		/*
+			Find the STACK_NODE holding the item Count down from the top, and
+			the STACK_NODE above it.
+		*/
+		TempStackNode = (STACK_NODE*)NULL;
+		Items = (UINT32)0;
+
+		#if (USING_STACK_CHUNKED_STORAGE == 1)
+			PreviousStackNode = (STACK_NODE*)NULL;
+		#endif // end of USING_STACK_CHUNKED_STORAGE
+
+		if(Count)
+		{
+			#if (USING_STACK_CHUNKED_STORAGE == 1)
+				StackGetNodeWithData(Stack, (BOOL)TRUE);
+			#endif // end of USING_STACK_CHUNKED_STORAGE
+
+			TempStackNode = (STACK_NODE*)(Stack->TopOfStack);
+
+			for(;;)
+			{
+				#if (USING_STACK_CHUNKED_STORAGE == 1)
+					Items += TempStackNode->Count;
+				#else
+					Items++;
+				#endif // end of USING_STACK_CHUNKED_STORAGE
+
+				if(Items >= Count)
+					break;
+
+				#if (USING_STACK_CHUNKED_STORAGE == 1)
+					PreviousStackNode = (STACK_NODE*)TempStackNode;
+				#endif // end of USING_STACK_CHUNKED_STORAGE
+
+				TempStackNode = (STACK_NODE*)(TempStackNode->Next);
+			}
+		}
+
+		#if (USING_STACK_CHUNKED_STORAGE == 1)
+			/*
+				If the cut falls inside a STACK_NODE, the items of it that go
+				with Top need a STACK_NODE of their own.  It is had before
+				anything is changed, so running out of memory leaves the 
+				STACK as it was.
+			*/
+			NewStackNode = (STACK_NODE*)NULL;
+
+			if(Items > Count && (NewStackNode = (STACK_NODE*)StackAllocateNode(Stack)) == (STACK_NODE*)NULL)
+				return (STACK*)NULL;
+		#endif // end of USING_STACK_CHUNKED_STORAGE
+
+		#if(USING_STACK_DEPENDENT_FREE_METHOD == 1)
+			Top = CreateStack(Top, Stack->StackFreeMethod);
+		#else
+			Top = CreateStack(Top, (void (*)(void *))NULL);
+		#endif // end of USING_STACK_DEPENDENT_FREE_METHOD
+
+		if(Top == (STACK*)NULL)
+		{
+			#if (USING_STACK_CHUNKED_STORAGE == 1)
+				if(NewStackNode != (STACK_NODE*)NULL)
+					StackReleaseNode(Stack, NewStackNode);
+			#endif // end of USING_STACK_CHUNKED_STORAGE
+
+			return (STACK*)NULL;
+		}
+
+		/*
+			Top lays out, allocates and frees its STACK_NODE's just like Stack,
+			so the STACK_NODE's can go back and forth between them.
+		*/
+		#if (USING_STACK_ALLOCATORS == 1)
+			Top->Allocator = Stack->Allocator;
+		#endif // end of USING_STACK_ALLOCATORS
+
+		#if (USING_STACK_CHUNKED_STORAGE == 1)
+			Top->ElementsPerNode = Stack->ElementsPerNode;
+		#endif // end of USING_STACK_CHUNKED_STORAGE
+
+		#if (USING_STACK_VALUE_METHODS == 1)
+			Top->ElementSize = Stack->ElementSize;
+		#endif // end of USING_STACK_VALUE_METHODS
+
+		#if (USING_STACK_NODE_CACHE == 1)
+			Top->NodeCacheLimit = Stack->NodeCacheLimit;
+		#endif // end of USING_STACK_NODE_CACHE
+
+		if(!Count)
+			return (STACK*)Top;
+
+		#if (USING_STACK_CHUNKED_STORAGE == 1)
+			if(NewStackNode != (STACK_NODE*)NULL)
+			{
+				/*
+					Move the top Moved items of TempStackNode into the new
+					STACK_NODE, which becomes the bottom of Top.  TempStackNode
+					stays with Stack as its top.
+				*/
+				Moved = (UINT32)(Count - (Items - TempStackNode->Count));
+				TempStackNode->Count -= Moved;
+
+				memcpy((void*)StackNodeSlot(Stack, NewStackNode, 0), (const void*)StackNodeSlot(Stack, TempStackNode, TempStackNode->Count), Moved * StackSlotSizeInBytes(Stack));
+				NewStackNode->Count = (UINT32)Moved;
+				NewStackNode->Next = (STACK_NODE*)NULL;
+
+				if(PreviousStackNode != (STACK_NODE*)NULL)
+				{
+					PreviousStackNode->Next = (STACK_NODE*)NewStackNode;
+					Top->TopOfStack = (STACK_NODE*)(Stack->TopOfStack);
+				}
+				else
+				{
+					Top->TopOfStack = (STACK_NODE*)NewStackNode;
+				}
+
+				Top->BottomOfStack = (STACK_NODE*)NewStackNode;
+				Stack->TopOfStack = (STACK_NODE*)TempStackNode;
+			}
+			else
+		#endif // end of USING_STACK_CHUNKED_STORAGE
+		{
+			/*
+				The cut falls right under TempStackNode, so everything from the
+				top down to it just changes hands.
+			*/
+			Top->TopOfStack = (STACK_NODE*)(Stack->TopOfStack);
+			Top->BottomOfStack = (STACK_NODE*)TempStackNode;
+			Stack->TopOfStack = (STACK_NODE*)(TempStackNode->Next);
+			TempStackNode->Next = (STACK_NODE*)NULL;
+		}
+
+		Top->Size = (UINT32)Count;
+		Stack->Size -= Count;
+
+		#if (USING_STACK_STATISTICS == 1)
+			StackStatsPushed(Top, Count);
+			Stack->Stats.Pops += Count;
+		#endif // end of USING_STACK_STATISTICS
+
+		return (STACK*)Top;
+	}
+#endif // end of USING_STACK_SPLICE_METHODS
+
+#if (USING_STACK_VALUE_METHODS == 1)
+	BOOL StackPushValue(STACK *Stack, const void *Value)
+	{
+		STACK_NODE *TempStackNode;
+
+		#if (STACK_SAFE_MODE == 1)
+			if(StackIsNull(Stack))
+				return (BOOL)FALSE;
+
+			if(!StackIsValueStack(Stack) || Value == (const void*)NULL)
+				return (BOOL)FALSE;
+		#endif // end of STACK_SAFE_MODE
+
+		#if (USING_STACK_SERIALIZE_METHODS == 1)
+			/*
+				A view can't be written to, its items are in someone else's buffer.
+			*/
+			if(StackIsView(Stack))
+				return (BOOL)FALSE;
+		#endif // end of USING_STACK_SERIALIZE_METHODS
+
+		#if (USING_STACK_CHUNKED_STORAGE == 1)
+			if((TempStackNode = (STACK_NODE*)StackGetNodeWithRoom(Stack)) == (STACK_NODE*)NULL)
+			{
+				return (BOOL)FALSE;
+			}
+
+			memcpy((void*)StackNodeSlot(Stack, TempStackNode, TempStackNode->Count), Value, Stack->ElementSize);
+			TempStackNode->Count++;
+		#else
+			if((TempStackNode = (STACK_NODE*)StackAllocateNode(Stack)) == (STACK_NODE*)NULL)
+			{
+				return (BOOL)FALSE;
+			}
+
+			/*
+				The item lives right after the STACK_NODE, and Data points at it
+				so StackPeek() works on a value STACK just like any other.
+			*/
+			TempStackNode->Data = (void*)(TempStackNode + 1);
+			memcpy(TempStackNode->Data, Value, Stack->ElementSize);
+
+			TempStackNode->Next = (STACK_NODE*)(Stack->TopOfStack);
+			Stack->TopOfStack = (STACK_NODE*)TempStackNode;
+
+			StackNoteBottomNode(Stack, TempStackNode);
+
+			#if (USING_STACK_PERSISTENT_METHODS == 1)
+				TempStackNode->References = (UINT32)1;
+			#endif // end of USING_STACK_PERSISTENT_METHODS
+		#endif // end of USING_STACK_CHUNKED_STORAGE
+
+		Stack->Size++;
+
+		#if (USING_STACK_SPILL_METHODS == 1)
+			StackCheckMemoryBudget(Stack);
+		#endif // end of USING_STACK_SPILL_METHODS
+
+		#if (USING_STACK_STATISTICS == 1)
+			StackStatsPushed(Stack, (UINT32)1);
+		#endif // end of USING_STACK_STATISTICS
+
+		return (BOOL)TRUE;
+	}
+
+	BOOL StackPopValue(STACK *Stack, void *Value)
+	{
+		STACK_NODE *TempStackNode;
+
+		#if (STACK_SAFE_MODE == 1)
+			if(StackIsNull(Stack))
+				return (BOOL)FALSE;
+
+			if(!StackIsValueStack(Stack) || Value == (void*)NULL)
+				return (BOOL)FALSE;
+		#endif // end of STACK_SAFE_MODE
+
+		if(StackIsEmpty(Stack))
+			return (BOOL)FALSE;
+
+		#if (USING_STACK_SERIALIZE_METHODS == 1)
+			/*
+				Popping a view only moves its top down, the buffer is left alone.
+			*/
+			if(StackIsView(Stack))
+			{
+				memcpy(Value, (const void*)StackViewTop(Stack), Stack->ElementSize);
+				Stack->Size--;
+
+				#if (USING_STACK_STATISTICS == 1)
+					Stack->Stats.Pops++;
+				#endif // end of USING_STACK_STATISTICS
+
+				return (BOOL)TRUE;
+			}
+		#endif // end of USING_STACK_SERIALIZE_METHODS
+
+		#if (USING_STACK_SPILL_METHODS == 1)
+			if(StackNeedsPageIn(Stack) && !StackPageIn(Stack))
+				return (BOOL)FALSE;
+		#endif // end of USING_STACK_SPILL_METHODS
+
+		#if (USING_STACK_CHUNKED_STORAGE == 1)
+			TempStackNode = (STACK_NODE*)StackGetNodeWithData(Stack, (BOOL)TRUE);
+
+			TempStackNode->Count--;
+			memcpy(Value, (const void*)StackNodeSlot(Stack, TempStackNode, TempStackNode->Count), Stack->ElementSize);
+			Stack->Size--;
+
+			StackItemRemoved(Stack, TempStackNode);
+		#else
+			TempStackNode = (STACK_NODE*)(Stack->TopOfStack);
+
+			memcpy(Value, (const void*)(TempStackNode->Data), Stack->ElementSize);
+			Stack->Size--;
+			Stack->TopOfStack = (STACK_NODE*)(TempStackNode->Next);
+
+			StackReleasePoppedNode(Stack, TempStackNode);
+		#endif // end of USING_STACK_CHUNKED_STORAGE
+
+		#if (USING_STACK_NODE_ARENA == 1)
+			StackArenaItemsRemoved(Stack);
+		#endif // end of USING_STACK_NODE_ARENA
+
+		#if (USING_STACK_STATISTICS == 1)
+			Stack->Stats.Pops++;
+		#endif // end of USING_STACK_STATISTICS
+
+		return (BOOL)TRUE;
+	}
+
+	BOOL StackPeekValue(STACK *Stack, void *Value)
+	{
+		STACK_NODE *TempStackNode;
+
+		#if (STACK_SAFE_MODE == 1)
+			if(StackIsNull(Stack))
+				return (BOOL)FALSE;
+
+			if(!StackIsValueStack(Stack) || Value == (void*)NULL)
+				return (BOOL)FALSE;
+		#endif // end of STACK_SAFE_MODE
+
+		if(StackIsEmpty(Stack))
+			return (BOOL)FALSE;
+
+		#if (USING_STACK_SERIALIZE_METHODS == 1)
+			if(StackIsView(Stack))
+			{
+				memcpy(Value, (const void*)StackViewTop(Stack), Stack->ElementSize);
+
+				return (BOOL)TRUE;
+			}
+		#endif // end of USING_STACK_SERIALIZE_METHODS
+
+		#if (USING_STACK_SPILL_METHODS == 1)
+			if(StackNeedsPageIn(Stack) && !StackPageIn(Stack))
+				return (BOOL)FALSE;
+		#endif // end of USING_STACK_SPILL_METHODS
+
+		#if (USING_STACK_CHUNKED_STORAGE == 1)
+			TempStackNode = (STACK_NODE*)StackGetNodeWithData(Stack, (BOOL)FALSE);
+
+			memcpy(Value, (const void*)StackNodeSlot(Stack, TempStackNode, TempStackNode->Count - 1), Stack->ElementSize);
+		#else
+			TempStackNode = (STACK_NODE*)(Stack->TopOfStack);
+
+			memcpy(Value, (const void*)(TempStackNode->Data), Stack->ElementSize);
+		#endif // end of USING_STACK_CHUNKED_STORAGE
+
+		return (BOOL)TRUE;
+	}
+#endif // end of USING_STACK_VALUE_METHODS
+
+#if (USING_STACK_PEEK_METHOD == 1)
+	void *StackPeek(STACK *Stack)
+	{
+		#if (STACK_SAFE_MODE == 1)
+			if(StackIsNull(Stack))
+				return (void*)NULL;
+		
+			if(StackIsEmpty(Stack))
+				return (void*)NULL;
+		#endif // end of STACK_SAFE_MODE
+
+		#if (USING_STACK_BOUNDED_METHODS == 1)
+			if(StackIsBounded(Stack))
+				return (void*)(Stack->Buffer[Stack->Size - 1]);
+		#endif // end of USING_STACK_BOUNDED_METHODS
+
+		#if (USING_STACK_SERIALIZE_METHODS == 1)
+			if(StackIsView(Stack))
+				return (void*)StackViewTop(Stack);
+		#endif // end of USING_STACK_SERIALIZE_METHODS
+
+		#if (USING_STACK_SPILL_METHODS == 1)
+			if(StackNeedsPageIn(Stack) && !StackPageIn(Stack))
+				return (void*)NULL;
+		#endif // end of USING_STACK_SPILL_METHODS
+
+		#if (USING_STACK_CHUNKED_STORAGE == 1)
+		{
+			STACK_NODE *TempStackNode;
+
+			/*
+				The top STACK_NODE may have been emptied by StackPop(), in which
+				case the data is at the top of the STACK_NODE below it.
+			*/
+			TempStackNode = (STACK_NODE*)StackGetNodeWithData(Stack, (BOOL)FALSE);
+
+			#if (USING_STACK_VALUE_METHODS == 1)
+				/*
+					A value STACK hands out the address of the top item itself.
+				*/
+				if(Stack->ElementSize)
+					return (void*)StackNodeSlot(Stack, TempStackNode, TempStackNode->Count - 1);
+			#endif // end of USING_STACK_VALUE_METHODS
+
+			return (void*)(TempStackNode->Data[TempStackNode->Count - 1]);
+		}
+		#else
+			/*
+				Return the data pointed to by the first STACK_NODE.
+			*/
+			return (void*)(Stack->TopOfStack->Data);
+		#endif // end of USING_STACK_CHUNKED_STORAGE
+	}
+#endif // end of USING_STACK_PEEK_METHOD
+
+#if (USING_STACK_SEARCH_METHODS == 1)
+	/*
+		The data StackPeek() would hand out for an item, given its slot.
+	*/
+	#if (USING_STACK_VALUE_METHODS == 1)
+		#define StackSlotData(Stack, Slot)			(StackIsValueStack(Stack) ? (void*)(Slot) : *(void**)(Slot))
+	#else
+		#define StackSlotData(Stack, Slot)			(*(void**)(Slot))
+	#endif // end of USING_STACK_VALUE_METHODS
+
+	/*
+		Called by StackScan() with each run of Count slots that are next to
+		each other in memory, bottom first, starting with the run on top of
+		the STACK.  Depth is how far the last slot of the run is from the
+		top of the STACK.  Returns TRUE to stop the scan.
+	*/
+	typedef BOOL (*STACK_SCAN_METHOD)(STACK *Stack, const BYTE *Slots, UINT32 Count, UINT32 Depth, void *Context);
+
+	typedef struct
+	{
+		BOOL (*Method)(void *Data, void *Context);
+		void *Context;
+	}STACK_FOR_EACH_TASK;
+
+	typedef struct
+	{
+		const void *Data;
+		UINT32 Depth;
+	}STACK_SEARCH_TASK;
+
+	#if defined(STACK_SIMD_AVX2) || defined(STACK_SIMD_SSE2)
+		/*
+			Returns the highest bit set in a compare mask, which isn't 0.
+		*/
+		static UINT32 StackHighestBit(int Mask)
+		{
+			UINT32 Bit;
+
+			for(Bit = (UINT32)0; Mask >>= 1; Bit++);
+
+			return (UINT32)Bit;
+		}
+	#endif // end of STACK_SIMD_AVX2 or STACK_SIMD_SSE2
+
+	/*
+		Returns the index of the last of the Count data pointers at Slots
+		that is equal to Data, or STACK_NOT_FOUND.
+	*/
+	static UINT32 StackFindPointer(void *const *Slots, UINT32 Count, const void *Data)
+	{
+		UINT32 i;
+
+		i = (UINT32)Count;
+
+		#if defined(STACK_SIMD_AVX2)
+		{
+			__m256i Needle;
+			int Upper, Lower;
+
+			/*
+				Two vectors of 4 pointers each are compared per pass, the
+				ones nearest the top of the STACK first.
+			*/
+			Needle = _mm256_set1_epi64x((long long)(size_t)Data);
+
+			while(i >= (UINT32)8)
+			{
+				i -= (UINT32)8;
+
+				Upper = _mm256_movemask_pd(_mm256_castsi256_pd(_mm256_cmpeq_epi64(_mm256_loadu_si256((const __m256i*)(Slots + i + 4)), Needle)));
+				Lower = _mm256_movemask_pd(_mm256_castsi256_pd(_mm256_cmpeq_epi64(_mm256_loadu_si256((const __m256i*)(Slots + i)), Needle)));
+
+				if(Upper)
+					return (UINT32)(i + 4 + StackHighestBit(Upper));
+
+				if(Lower)
+					return (UINT32)(i + StackHighestBit(Lower));
+			}
+		}
+		#elif defined(STACK_SIMD_SSE2) && (__SIZEOF_POINTER__ == 8)
+		{
+			__m128i Needle, Upper, Lower;
+			int UpperMask, LowerMask;
+
+			/*
+				SSE2 can only compare 32 bits at a time, so a pointer is
+				equal when both of its halves are.
+			*/
+			Needle = _mm_set1_epi64x((long long)(size_t)Data);
+
+			while(i >= (UINT32)4)
+			{
+				i -= (UINT32)4;
+
+				Upper = _mm_cmpeq_epi32(_mm_loadu_si128((const __m128i*)(Slots + i + 2)), Needle);
+				Lower = _mm_cmpeq_epi32(_mm_loadu_si128((const __m128i*)(Slots + i)), Needle);
+
+				UpperMask = _mm_movemask_pd(_mm_castsi128_pd(_mm_and_si128(Upper, _mm_shuffle_epi32(Upper, _MM_SHUFFLE(2, 3, 0, 1)))));
+				LowerMask = _mm_movemask_pd(_mm_castsi128_pd(_mm_and_si128(Lower, _mm_shuffle_epi32(Lower, _MM_SHUFFLE(2, 3, 0, 1)))));
+
+				if(UpperMask)
+					return (UINT32)(i + 2 + StackHighestBit(UpperMask));
+
+				if(LowerMask)
+					return (UINT32)(i + StackHighestBit(LowerMask));
+			}
+		}
+		#elif defined(STACK_SIMD_SSE2)
+		{
+			__m128i Needle;
+			int Upper, Lower;
+
+			Needle = _mm_set1_epi32((int)(size_t)Data);
+
+			while(i >= (UINT32)8)
+			{
+				i -= (UINT32)8;
+
+				Upper = _mm_movemask_ps(_mm_castsi128_ps(_mm_cmpeq_epi32(_mm_loadu_si128((const __m128i*)(Slots + i + 4)), Needle)));
+				Lower = _mm_movemask_ps(_mm_castsi128_ps(_mm_cmpeq_epi32(_mm_loadu_si128((const __m128i*)(Slots + i)), Needle)));
+
+				if(Upper)
+					return (UINT32)(i + 4 + StackHighestBit(Upper));
+
+				if(Lower)
+					return (UINT32)(i + StackHighestBit(Lower));
+			}
+		}
+		#endif // end of STACK_SIMD_AVX2
+
+		while(i--)
+		{
+			if(Slots[i] == Data)
+				return (UINT32)i;
+		}
+
+		return STACK_NOT_FOUND;
+	}
+
+	#if (USING_STACK_SPILL_METHODS == 1)
+		/*
+			Hands the spilled items of the STACK to Method, a buffer at a
+			time.  The spill file is bottom first, so it is read from the
+			end back.  Returns FALSE if the spill file couldn't be read.
+		*/
+		static BOOL StackScanSpilled(STACK *Stack, STACK_SCAN_METHOD Method, void *Context, UINT32 Depth)
+		{
+			BYTE *Buffer;
+			UINT32 BufferItems, Left, Count;
+			BOOL Success;
+
+			if((Buffer = (BYTE*)StackAllocateSpillBuffer(Stack, &BufferItems)) == (BYTE*)NULL)
+				return (BOOL)FALSE;
+
+			Left = (UINT32)(Stack->SpilledSize);
+			Success = (BOOL)TRUE;
+
+			while(Left)
+			{
+				Count = (UINT32)(Left < BufferItems ? Left : BufferItems);
+				Left -= Count;
+
+				if(fseek(Stack->SpillFile, (long)((UINT64)Left * StackSlotSizeInBytes(Stack)), SEEK_SET) || fread((void*)Buffer, StackSlotSizeInBytes(Stack), Count, Stack->SpillFile) != Count)
+				{
+					Success = (BOOL)FALSE;
+
+					break;
+				}
+
+				if(Method(Stack, Buffer, Count, Depth, Context))
+					break;
+
+				Depth += Count;
+			}
+
+			StackDeallocate(Stack, (void*)Buffer);
+
+			return (BOOL)Success;
+		}
+	#endif // end of USING_STACK_SPILL_METHODS
+
+	/*
+		Hands every item of the STACK to Method in runs, top first, without
+		changing the STACK.  Returns FALSE if the spilled items couldn't be
+		read.
+	*/
+	static BOOL StackScan(STACK *Stack, STACK_SCAN_METHOD Method, void *Context)
+	{
+		STACK_NODE *TempStackNode;
+		UINT32 Depth;
+
+		if(StackIsEmpty(Stack))
+			return (BOOL)TRUE;
+
+		#if (USING_STACK_SERIALIZE_METHODS == 1)
+			if(StackIsView(Stack))
+			{
+				Method(Stack, Stack->View, Stack->Size, (UINT32)0, Context);
+
+				return (BOOL)TRUE;
+			}
+		#endif // end of USING_STACK_SERIALIZE_METHODS
+
+		#if (USING_STACK_BOUNDED_METHODS == 1)
+			if(StackIsBounded(Stack))
+			{
+				Method(Stack, (const BYTE*)(Stack->Buffer), Stack->Size, (UINT32)0, Context);
+
+				return (BOOL)TRUE;
+			}
+		#endif // end of USING_STACK_BOUNDED_METHODS
+
+		Depth = (UINT32)0;
+
+		for(TempStackNode = (STACK_NODE*)(Stack->TopOfStack); TempStackNode != (STACK_NODE*)NULL; TempStackNode = (STACK_NODE*)(TempStackNode->Next))
+		{
+			if(Method(Stack, (const BYTE*)StackSlotAddress(Stack, TempStackNode, (UINT32)0), StackNodeItemCount(TempStackNode), Depth, Context))
+				return (BOOL)TRUE;
+
+			Depth += StackNodeItemCount(TempStackNode);
+		}
+
+		#if (USING_STACK_SPILL_METHODS == 1)
+			if(Stack->SpilledSize)
+				return StackScanSpilled(Stack, Method, Context, Depth);
+		#endif // end of USING_STACK_SPILL_METHODS
+
+		return (BOOL)TRUE;
+	}
+
+	static BOOL StackForEachRun(STACK *Stack, const BYTE *Slots, UINT32 Count, UINT32 Depth, void *Context)
+	{
+		STACK_FOR_EACH_TASK *Task;
+
+		(void)Stack;
+		(void)Depth;
+
+		Task = (STACK_FOR_EACH_TASK*)Context;
+
+		while(Count--)
+		{
+			if(!Task->Method(StackSlotData(Stack, Slots + (Count * StackSlotSizeInBytes(Stack))), Task->Context))
+				return (BOOL)TRUE;
+		}
+
+		return (BOOL)FALSE;
+	}
+
+	static BOOL StackIndexOfRun(STACK *Stack, const BYTE *Slots, UINT32 Count, UINT32 Depth, void *Context)
+	{
+		STACK_SEARCH_TASK *Task;
+		UINT32 i;
+
+		(void)Stack;
+
+		Task = (STACK_SEARCH_TASK*)Context;
+
+		#if (USING_STACK_VALUE_METHODS == 1)
+			if(StackIsValueStack(Stack))
+			{
+				for(i = (UINT32)Count; i--; )
+				{
+					if(!memcmp((const void*)(Slots + (i * Stack->ElementSize)), Task->Data, Stack->ElementSize))
+					{
+						Task->Depth = (UINT32)(Depth + (Count - 1 - i));
+
+						return (BOOL)TRUE;
+					}
+				}
+
+				return (BOOL)FALSE;
+			}
+		#endif // end of USING_STACK_VALUE_METHODS
+
+		if((i = StackFindPointer((void *const*)Slots, Count, Task->Data)) == STACK_NOT_FOUND)
+			return (BOOL)FALSE;
+
+		Task->Depth = (UINT32)(Depth + (Count - 1 - i));
+
+		return (BOOL)TRUE;
+	}
+
+	BOOL StackForEach(STACK *Stack, BOOL (*Method)(void *Data, void *Context), void *Context)
+	{
+		STACK_FOR_EACH_TASK Task;
+
+		#if (STACK_SAFE_MODE == 1)
+			if(StackIsNull(Stack) || Method == NULL)
+				return (BOOL)FALSE;
+		#endif // end of STACK_SAFE_MODE
+
+		Task.Method = Method;
+		Task.Context = Context;
+
+		return StackScan(Stack, StackForEachRun, (void*)&Task);
+	}
+
+	UINT32 StackIndexOf(STACK *Stack, const void *Data)
+	{
+		STACK_SEARCH_TASK Task;
+
+		#if (STACK_SAFE_MODE == 1)
+			if(StackIsNull(Stack))
+				return STACK_NOT_FOUND;
+		#endif // end of STACK_SAFE_MODE
+
+		Task.Data = Data;
+		Task.Depth = STACK_NOT_FOUND;
+
+		StackScan(Stack, StackIndexOfRun, (void*)&Task);
+
+		return (UINT32)(Task.Depth);
+	}
+
+	BOOL StackContains(STACK *Stack, const void *Data)
+	{
+		return (BOOL)(StackIndexOf(Stack, Data) != STACK_NOT_FOUND);
+	}
+
+	void *StackPeekAt(STACK *Stack, UINT32 Depth)
+	{
+		STACK_NODE *TempStackNode;
+
+		#if (STACK_SAFE_MODE == 1)
+			if(StackIsNull(Stack))
+				return (void*)NULL;
+		#endif // end of STACK_SAFE_MODE
+
+		if(Depth >= Stack->Size)
+			return (void*)NULL;
+
+		#if (USING_STACK_SERIALIZE_METHODS == 1)
+			if(StackIsView(Stack))
+				return (void*)(Stack->View + ((Stack->Size - 1 - Depth) * Stack->ElementSize));
+		#endif // end of USING_STACK_SERIALIZE_METHODS
+
+		#if (USING_STACK_BOUNDED_METHODS == 1)
+			if(StackIsBounded(Stack))
+				return (void*)(Stack->Buffer[Stack->Size - 1 - Depth]);
+		#endif // end of USING_STACK_BOUNDED_METHODS
+
+		for(TempStackNode = (STACK_NODE*)(Stack->TopOfStack); TempStackNode != (STACK_NODE*)NULL; TempStackNode = (STACK_NODE*)(TempStackNode->Next))
+		{
+			if(Depth < StackNodeItemCount(TempStackNode))
+				return StackSlotData(Stack, StackSlotAddress(Stack, TempStackNode, StackNodeItemCount(TempStackNode) - 1 - Depth));
+
+			Depth -= StackNodeItemCount(TempStackNode);
+		}
+
+		#if (USING_STACK_SPILL_METHODS == 1)
+		{
+			void *Data;
+
+			/*
+				Depth is now how far down into the spilled items the item is.
+				A value STACK hands out the address of its items, which a
+				spilled item doesn't have.
+			*/
+			#if (USING_STACK_VALUE_METHODS == 1)
+				if(StackIsValueStack(Stack))
+					return (void*)NULL;
+			#endif // end of USING_STACK_VALUE_METHODS
+
+			if(fseek(Stack->SpillFile, (long)((UINT64)(Stack->SpilledSize - 1 - Depth) * sizeof(void*)), SEEK_SET) || fread((void*)&Data, sizeof(void*), 1, Stack->SpillFile) != 1)
+				return (void*)NULL;
+
+			return (void*)Data;
+		}
+		#else
+			return (void*)NULL;
+		#endif // end of USING_STACK_SPILL_METHODS
+	}
+#endif // end of USING_STACK_SEARCH_METHODS
+
+#if ((USING_STACK_CLEAR_METHOD == 1) || (USING_STACK_MARK_METHODS == 1)) && (USING_STACK_DEPENDENT_FREE_METHOD == 1)
+	/*
+		Calls FreeMethod on every piece of data in the STACK_NODE, top slot
+		first, so the data is freed in the same order StackPop() would have
+		returned it.
+	*/
+	static void StackFreeNodeData(STACK_NODE *StackNode, void (*FreeMethod)(void *Data))
+	{
+		#if (USING_STACK_CHUNKED_STORAGE == 1)
+			while(StackNode->Count)
+				FreeMethod((void*)(StackNode->Data[--StackNode->Count]));
+		#else
+			FreeMethod((void*)(StackNode->Data));
+		#endif // end of USING_STACK_CHUNKED_STORAGE
+	}
+#endif // end of USING_STACK_CLEAR_METHOD or USING_STACK_MARK_METHODS, and USING_STACK_DEPENDENT_FREE_METHOD
+
+#if (USING_STACK_PARALLEL_FREE == 1)
+	/*
+		The run of STACK_NODE's one thread frees the data of for StackClear().
+	*/
+	typedef struct
+	{
+		void (*FreeMethod)(void *Data);
+		STACK_NODE *FirstNode;
+		UINT32 NumberOfNodes;
+	}STACK_PARALLEL_FREE_TASK;
+
+	static void *StackParallelFreeWorker(void *Argument)
+	{
+		STACK_PARALLEL_FREE_TASK *Task;
+		STACK_NODE *TempStackNode;
+
+		Task = (STACK_PARALLEL_FREE_TASK*)Argument;
+		TempStackNode = (STACK_NODE*)(Task->FirstNode);
+
+		while(Task->NumberOfNodes--)
+		{
+			StackFreeNodeData(TempStackNode, Task->FreeMethod);
+
+			TempStackNode = (STACK_NODE*)(TempStackNode->Next);
+		}
+
+		return (void*)NULL;
+	}
+
+	/*
+		The threads StackClear() hands runs to.  They are started the first
+		time a STACK's data is freed in parallel and kept for every clear 
+		after that, each waiting for StackParallelFreeBatch to move past 
+		the last batch it did.  StackParallelFreeLock is held by the one
+		StackClear() using them, StackParallelFreeMutex guards the rest.
+	*/
+	static pthread_mutex_t StackParallelFreeLock = PTHREAD_MUTEX_INITIALIZER;
+	static pthread_mutex_t StackParallelFreeMutex = PTHREAD_MUTEX_INITIALIZER;
+	static pthread_cond_t StackParallelFreeWork = PTHREAD_COND_INITIALIZER;
+	static pthread_cond_t StackParallelFreeDone = PTHREAD_COND_INITIALIZER;
+	static STACK_PARALLEL_FREE_TASK StackParallelFreeTasks[STACK_PARALLEL_FREE_THREADS];
+	static BOOL StackParallelFreeStarted[STACK_PARALLEL_FREE_THREADS];
+	static UINT32 StackParallelFreeSeen[STACK_PARALLEL_FREE_THREADS];
+	static UINT32 StackParallelFreeBatch = (UINT32)0;
+	static UINT32 StackParallelFreePending = (UINT32)0;
+
+	/*
+		Runs on each thread of the pool, Argument being the index of the
+		task it does out of every batch.
+	*/
+	static void *StackParallelFreeThread(void *Argument)
+	{
+		size_t i;
+
+		i = (size_t)Argument;
+
+		for(;;)
+		{
+			pthread_mutex_lock(&StackParallelFreeMutex);
+
+			while(StackParallelFreeSeen[i] == StackParallelFreeBatch)
+				pthread_cond_wait(&StackParallelFreeWork, &StackParallelFreeMutex);
+
+			StackParallelFreeSeen[i] = StackParallelFreeBatch;
+
+			pthread_mutex_unlock(&StackParallelFreeMutex);
+
+			StackParallelFreeWorker((void*)&StackParallelFreeTasks[i]);
+
+			pthread_mutex_lock(&StackParallelFreeMutex);
+
+			if(--StackParallelFreePending == (UINT32)0)
+				pthread_cond_signal(&StackParallelFreeDone);
+
+			pthread_mutex_unlock(&StackParallelFreeMutex);
+		}
+
+		return (void*)NULL;
+	}
+
+	/*
+		Frees the data of every STACK_NODE in the STACK with FreeMethod, 
+		split into STACK_PARALLEL_FREE_THREADS runs of about the same number
+		of items.  The calling thread takes the first run and hands the 
+		rest to the pool, starting any of its threads that aren't running 
+		yet.  A run whose thread couldn't be started is done by the calling
+		thread too, as is every run if another StackClear() is using the 
+		pool.  The STACK_NODE's themselves are left in the STACK.
+	*/
+	static void StackFreeDataInParallel(STACK *Stack, void (*FreeMethod)(void *Data))
+	{
+		STACK_PARALLEL_FREE_TASK Tasks[STACK_PARALLEL_FREE_THREADS];
+		StackThread Thread;
+		STACK_NODE *TempStackNode;
+		UINT32 i, Items, ItemsPerTask, Started;
+
+		/*
+			One walk down the STACK to cut it into runs.  The last run takes
+			whatever is left.
+		*/
+		ItemsPerTask = (UINT32)(Stack->Size / STACK_PARALLEL_FREE_THREADS + 1);
+		TempStackNode = (STACK_NODE*)(Stack->TopOfStack);
+
+		for(i = (UINT32)0; i < (UINT32)STACK_PARALLEL_FREE_THREADS; i++)
+		{
+			Tasks[i].FreeMethod = FreeMethod;
+			Tasks[i].FirstNode = (STACK_NODE*)TempStackNode;
+			Tasks[i].NumberOfNodes = (UINT32)0;
+
+			Items = (UINT32)0;
+
+			while(TempStackNode != (STACK_NODE*)NULL && (Items < ItemsPerTask || i == (UINT32)(STACK_PARALLEL_FREE_THREADS - 1)))
+			{
+				#if (USING_STACK_CHUNKED_STORAGE == 1)
+					Items += TempStackNode->Count;
+				#else
+					Items++;
+				#endif // end of USING_STACK_CHUNKED_STORAGE
+
+				Tasks[i].NumberOfNodes++;
+				TempStackNode = (STACK_NODE*)(TempStackNode->Next);
+			}
+		}
+
+		if(pthread_mutex_trylock(&StackParallelFreeLock))
+		{
+			for(i = (UINT32)0; i < (UINT32)STACK_PARALLEL_FREE_THREADS; i++)
+				StackParallelFreeWorker((void*)&Tasks[i]);
+
+			return;
+		}
+
+		pthread_mutex_lock(&StackParallelFreeMutex);
+
+		Started = (UINT32)0;
+
+		for(i = (UINT32)1; i < (UINT32)STACK_PARALLEL_FREE_THREADS; i++)
+		{
+			StackParallelFreeTasks[i] = Tasks[i];
+
+			if(!StackParallelFreeStarted[i])
+			{
+				StackParallelFreeSeen[i] = StackParallelFreeBatch;
+
+				if((StackParallelFreeStarted[i] = (BOOL)StackThreadCreate(&Thread, StackParallelFreeThread, (void*)(size_t)i)))
+					StackThreadDetach(Thread);
+			}
+
+			if(StackParallelFreeStarted[i])
+				Started++;
+		}
+
+		StackParallelFreePending = (UINT32)Started;
+		StackParallelFreeBatch++;
+
+		pthread_cond_broadcast(&StackParallelFreeWork);
+		pthread_mutex_unlock(&StackParallelFreeMutex);
+
+		StackParallelFreeWorker((void*)&Tasks[0]);
+
+		for(i = (UINT32)1; i < (UINT32)STACK_PARALLEL_FREE_THREADS; i++)
+		{
+			if(!StackParallelFreeStarted[i])
+				StackParallelFreeWorker((void*)&Tasks[i]);
+		}
+
+		pthread_mutex_lock(&StackParallelFreeMutex);
+
+		while(StackParallelFreePending)
+			pthread_cond_wait(&StackParallelFreeDone, &StackParallelFreeMutex);
+
+		pthread_mutex_unlock(&StackParallelFreeMutex);
+		pthread_mutex_unlock(&StackParallelFreeLock);
+	}
+#endif // end of USING_STACK_PARALLEL_FREE
+
+#if (USING_STACK_CLEAR_METHOD == 1)
+	BOOL StackClear(STACK *Stack)
+	{
+		#if (USING_STACK_NODE_ARENA != 1) || (USING_STACK_DEPENDENT_FREE_METHOD == 1)
+			STACK_NODE *TempStackNode;
+		#endif // end of USING_STACK_NODE_ARENA or USING_STACK_DEPENDENT_FREE_METHOD
+
+		#if(USING_STACK_DEPENDENT_FREE_METHOD == 1)
+			void (*FreeMethod)(void *Data);
+		#endif // end of USING_STACK_DEPENDENT_FREE_METHOD
+	
+		#if (STACK_SAFE_MODE == 1)
+			if(StackIsNull(Stack))
+				return (BOOL)FALSE;
+		#endif // end of STACK_SAFE_MODE
+
+		#if (USING_STACK_STATISTICS == 1)
+			Stack->Stats.Clears++;
+		#endif // end of USING_STACK_STATISTICS
+
+		#if (USING_STACK_SPILL_METHODS == 1)
+			/*
+				A STACK that was popped empty can still have its spill file open.
+			*/
+			if(Stack->SpillFile != (FILE*)NULL)
+				StackDropSpilledItems(Stack);
+		#endif // end of USING_STACK_SPILL_METHODS
+
+		#if (STACK_SAFE_MODE == 1)
+			if(StackIsEmpty(Stack))
+				return (BOOL)TRUE;
+		#endif // end of STACK_SAFE_MODE
+
+		#if (USING_STACK_BOUNDED_METHODS == 1)
+			if(StackIsBounded(Stack))
+			{
+				#if(USING_STACK_DEPENDENT_FREE_METHOD == 1)
+					if(Stack->StackFreeMethod)
+					{
+						while(Stack->Size)
+							Stack->StackFreeMethod((void*)(Stack->Buffer[--Stack->Size]));
+					}
+				#endif // of USING_STACK_DEPENDENT_FREE_METHOD
+
+				Stack->Size = (UINT32)0;
+
+				return (BOOL)TRUE;
+			}
+		#endif // end of USING_STACK_BOUNDED_METHODS
+
+		#if (USING_STACK_SERIALIZE_METHODS == 1)
+			/*
+				A view owns none of its items, so there is nothing to free.
+			*/
+			if(StackIsView(Stack))
+			{
+				Stack->Size = (UINT32)0;
+
+				return (BOOL)TRUE;
+			}
+		#endif // end of USING_STACK_SERIALIZE_METHODS
+
+		#if(USING_STACK_DEPENDENT_FREE_METHOD == 1)
+			FreeMethod = Stack->StackFreeMethod;
+
+			#if (USING_STACK_PARALLEL_FREE == 1)
+				/*
+					A big enough STACK has its data freed by several threads at
+					once, after which only the STACK_NODE's are left to free.
+				*/
+				if(FreeMethod && Stack->Size >= (UINT32)STACK_PARALLEL_FREE_THRESHOLD)
+				{
+					StackFreeDataInParallel(Stack, FreeMethod);
+
+					FreeMethod = (void (*)(void *))NULL;
+				}
+			#endif // end of USING_STACK_PARALLEL_FREE
+		#endif // of USING_STACK_DEPENDENT_FREE_METHOD
+
+		#if (USING_STACK_NODE_ARENA == 1)
+			/*
+				Every STACK_NODE lives in the arena, so once the data is freed
+				the whole arena is handed back a block at a time.
+			*/
+			#if(USING_STACK_DEPENDENT_FREE_METHOD == 1)
+				if(FreeMethod)
+				{
+					for(TempStackNode = (STACK_NODE*)(Stack->TopOfStack); TempStackNode != (STACK_NODE*)NULL; TempStackNode = (STACK_NODE*)(TempStackNode->Next))
+						StackFreeNodeData(TempStackNode, FreeMethod);
+				}
+			#endif // of USING_STACK_DEPENDENT_FREE_METHOD
+
+			StackArenaRelease(Stack);
+			Stack->TopOfStack = (STACK_NODE*)NULL;
+		#else
+			/*
+				Use TempStackNode as an iterator to go through the STACK.
+				Start off at the beginning of the STACK.
+			*/
+			TempStackNode = (STACK_NODE*)(Stack->TopOfStack);
+		
+			/*
+				Whie TempStackNode is not NULL then proceed to free it's current
+				STACK_NODE, and the data if required by user with calls to 
+				StackMemDealloc().
+			*/
+			while(TempStackNode != (STACK_NODE*)NULL)
+			{
+				Stack->TopOfStack = (STACK_NODE*)(Stack->TopOfStack->Next);
+
+				#if (USING_STACK_PERSISTENT_METHODS == 1)
+					/*
+						From here down the STACK_NODE's are shared with a clone,
+						which keeps them and their data.
+					*/
+					if(!StackDropNodeReference(TempStackNode))
+					{
+						Stack->TopOfStack = (STACK_NODE*)NULL;
+
+						break;
+					}
+				#endif // end of USING_STACK_PERSISTENT_METHODS
+		
+				#if(USING_STACK_DEPENDENT_FREE_METHOD == 1)
+					if(FreeMethod)
+						StackFreeNodeData(TempStackNode, FreeMethod);
+				#endif // of USING_STACK_DEPENDENT_FREE_METHOD
+
+				StackReleaseNode(Stack, TempStackNode);  // caches the node or frees it with StackMemDealloc()
+
+				TempStackNode = (STACK_NODE*)(Stack->TopOfStack); 
+			}
+		#endif // end of USING_STACK_NODE_ARENA
+	
+		/*
+			Set the STACK back to as if it was just newly created.  Stack->TopOfStack
+			was automatically placed to (STACK*)NULL when it did it's last iteration
+			in the above while loop.  So as a result we don't need to set it to 
+			(STACK_NODE*)NULL.  It was already done for us.
+		*/
+		Stack->Size = (UINT32)0;
+	
+		return (BOOL)TRUE;
+	}
+#endif // end of USING_STACK_CLEAR_METHOD
+
+#if (USING_STACK_MARK_METHODS == 1)
+	BOOL StackMark(STACK *Stack, STACK_MARK *Mark)
+	{
+		#if (STACK_SAFE_MODE == 1)
+			if(StackIsNull(Stack) || Mark == (STACK_MARK*)NULL)
+				return (BOOL)FALSE;
+		#endif // end of STACK_SAFE_MODE
+
+		#if (USING_STACK_SERIALIZE_METHODS == 1)
+			if(StackIsView(Stack))
+				return (BOOL)FALSE;
+		#endif // end of USING_STACK_SERIALIZE_METHODS
+
+		#if (USING_STACK_CHUNKED_STORAGE == 1)
+			/*
+				An emptied top STACK_NODE could be freed and reused before the
+				rewind, so it is freed now instead.
+			*/
+			if(Stack->TopOfStack != (STACK_NODE*)NULL)
+				StackGetNodeWithData(Stack, (BOOL)TRUE);
+
+			Mark->TopCount = (Stack->TopOfStack == (STACK_NODE*)NULL) ? (UINT32)0 : (UINT32)(Stack->TopOfStack->Count);
+		#endif // end of USING_STACK_CHUNKED_STORAGE
+
+		Mark->Size = Stack->Size;
+		Mark->TopOfStack = (STACK_NODE*)(Stack->TopOfStack);
+		Mark->ArenaBlocks = (STACK_ARENA_BLOCK*)(Stack->ArenaBlocks);
+		Mark->ArenaNext = (BYTE*)(Stack->ArenaNext);
+		Mark->ArenaBytesLeft = Stack->ArenaBytesLeft;
+		Mark->ArenaFreeNodes = (STACK_NODE*)(Stack->ArenaFreeNodes);
+		Mark->ArenaFreeFloor = (STACK_NODE*)(Stack->ArenaFreeFloor);
+		Mark->ArenaGeneration = Stack->ArenaGeneration;
+		Mark->Serial = ++Stack->MarkSerial;
+		Mark->PreviousMark = Stack->NewestMark;
+		Mark->LowWater = Stack->MarkLowWater;
+
+		if(Stack->MarkLowWater < Stack->MarkDip)
+			Stack->MarkDip = Stack->MarkLowWater;
+
+		/*
+			From here on only STACK_NODE's carved out after the mark are 
+			reused, so everything the arena held before it stays put.
+		*/
+		Stack->ArenaFreeFloor = (STACK_NODE*)(Stack->ArenaFreeNodes);
+		Stack->NewestMark = Mark->Serial;
+		Stack->NewestPrevious = Mark->PreviousMark;
+		Stack->NewestLowWater = Mark->LowWater;
+		Stack->MarkLowWater = (UINT32)0xFFFFFFFF;
+
+		return (BOOL)TRUE;
+	}
+
+	BOOL StackRewind(STACK *Stack, const STACK_MARK *Mark, BOOL FreeData)
+	{
+		STACK_ARENA_BLOCK *Block;
+		UINT32 LowWater;
+
+		#if(USING_STACK_DEPENDENT_FREE_METHOD == 1)
+			STACK_NODE *TempStackNode;
+			void (*FreeMethod)(void *Data);
+		#else
+			(void)FreeData;
+		#endif // end of USING_STACK_DEPENDENT_FREE_METHOD
+
+		#if (STACK_SAFE_MODE == 1)
+			if(StackIsNull(Stack) || Mark == (const STACK_MARK*)NULL)
+				return (BOOL)FALSE;
+		#endif // end of STACK_SAFE_MODE
+
+		if(Stack->Size < Mark->Size)
+			return (BOOL)FALSE;
+
+		/*
+			Going back to an empty STACK is the same as clearing it, so such
+			a mark is always good.  Any other mark is lost once the arena it
+			was made in has been handed back, or once the STACK has been
+			popped below it, since its STACK_NODE's may hold other items by
+			now.
+		*/
+		if(Mark->Size)
+		{
+			if(Mark->ArenaGeneration != Stack->ArenaGeneration)
+				return (BOOL)FALSE;
+
+			LowWater = Stack->MarkLowWater;
+
+			if(Mark->Serial != Stack->NewestMark)
+			{
+				/*
+					How far the STACK was popped between this mark and the 
+					newest one is only known if the newest one was made right
+					after it.  Otherwise everything popped before the newest
+					mark counts.
+				*/
+				if(Mark->Serial == Stack->NewestPrevious)
+				{
+					if(Stack->NewestLowWater < LowWater)
+						LowWater = Stack->NewestLowWater;
+				}
+				else if(Stack->MarkDip < LowWater)
+				{
+					LowWater = Stack->MarkDip;
+				}
+			}
+
+			if(LowWater < Mark->Size)
+				return (BOOL)FALSE;
+
+			for(Block = (STACK_ARENA_BLOCK*)(Stack->ArenaBlocks); Block != Mark->ArenaBlocks; Block = (STACK_ARENA_BLOCK*)(Block->Next))
+			{
+				if(Block == (STACK_ARENA_BLOCK*)NULL)
+					return (BOOL)FALSE;
+			}
+		}
+
+		/*
+			The mark becomes the newest one again.  Every mark made after it
+			is above where the STACK is going back to, and is lost.
+		*/
+		if(Stack->MarkLowWater < Stack->MarkDip)
+			Stack->MarkDip = Stack->MarkLowWater;
+
+		if(Mark->Size < Stack->MarkDip)
+			Stack->MarkDip = Mark->Size;
+
+		Stack->NewestMark = Mark->Serial;
+		Stack->NewestPrevious = Mark->PreviousMark;
+		Stack->NewestLowWater = Mark->LowWater;
+		Stack->MarkLowWater = (UINT32)0xFFFFFFFF;
+
+		#if(USING_STACK_DEPENDENT_FREE_METHOD == 1)
+			FreeMethod = FreeData ? Stack->StackFreeMethod : (void (*)(void *))NULL;
+		#endif // end of USING_STACK_DEPENDENT_FREE_METHOD
+
+		#if (USING_STACK_STATISTICS == 1)
+			Stack->Stats.Pops += Stack->Size - Mark->Size;
+		#endif // end of USING_STACK_STATISTICS
+
+		#if (USING_STACK_BOUNDED_METHODS == 1)
+			if(StackIsBounded(Stack))
+			{
+				#if(USING_STACK_DEPENDENT_FREE_METHOD == 1)
+					if(FreeMethod)
+					{
+						while(Stack->Size > Mark->Size)
+							FreeMethod(Stack->Buffer[--Stack->Size]);
+					}
+				#endif // end of USING_STACK_DEPENDENT_FREE_METHOD
+
+				Stack->Size = Mark->Size;
+
+				return (BOOL)TRUE;
+			}
+		#endif // end of USING_STACK_BOUNDED_METHODS
+
+		#if(USING_STACK_DEPENDENT_FREE_METHOD == 1)
+			/*
+				The data above the mark is freed in one pass, top first, before
+				the STACK_NODE's holding it go back to the arena.
+			*/
+			if(FreeMethod)
+			{
+				for(TempStackNode = (STACK_NODE*)(Stack->TopOfStack); TempStackNode != Mark->TopOfStack; TempStackNode = (STACK_NODE*)(TempStackNode->Next))
+					StackFreeNodeData(TempStackNode, FreeMethod);
+
+				#if (USING_STACK_CHUNKED_STORAGE == 1)
+					if((TempStackNode = (STACK_NODE*)(Mark->TopOfStack)) != (STACK_NODE*)NULL)
+					{
+						while(TempStackNode->Count > Mark->TopCount)
+							FreeMethod((void*)(TempStackNode->Data[--TempStackNode->Count]));
+					}
+				#endif // end of USING_STACK_CHUNKED_STORAGE
+			}
+		#endif // end of USING_STACK_DEPENDENT_FREE_METHOD
+
+		Stack->TopOfStack = (STACK_NODE*)(Mark->TopOfStack);
+		Stack->Size = Mark->Size;
+
+		#if (USING_STACK_CHUNKED_STORAGE == 1)
+			if(Stack->TopOfStack != (STACK_NODE*)NULL)
+				Stack->TopOfStack->Count = Mark->TopCount;
+		#endif // end of USING_STACK_CHUNKED_STORAGE
+
+		/*
+			An empty STACK only keeps one block of its arena.
+		*/
+		if(StackIsEmpty(Stack))
+		{
+			StackArenaReset(Stack);
+
+			return (BOOL)TRUE;
+		}
+
+		/*
+			Every STACK_NODE above the mark was carved out of the arena after
+			it, so winding the arena back frees them all at once.  Blocks the
+			arena got since the mark are handed back whole.
+		*/
+		while((Block = (STACK_ARENA_BLOCK*)(Stack->ArenaBlocks)) != Mark->ArenaBlocks)
+		{
+			Stack->ArenaBlocks = (STACK_ARENA_BLOCK*)(Block->Next);
+
+			StackArenaFreeBlock(Stack, Block);
+		}
+
+		Stack->ArenaNext = (BYTE*)(Mark->ArenaNext);
+		Stack->ArenaBytesLeft = Mark->ArenaBytesLeft;
+		Stack->ArenaFreeNodes = (STACK_NODE*)(Mark->ArenaFreeNodes);
+		Stack->ArenaFreeFloor = (STACK_NODE*)(Mark->ArenaFreeFloor);
+
+		return (BOOL)TRUE;
+	}
+#endif // end of USING_STACK_MARK_METHODS
+
+#if (USING_STACK_HUGE_PAGE_ARENA == 1)
+	BOOL StackGetHugePageCoverage(STACK *Stack, STACK_HUGE_PAGE_COVERAGE *Coverage)
+	{
+		STACK_ARENA_BLOCK *Block;
+
+		#if (STACK_SAFE_MODE == 1)
+			if(StackIsNull(Stack))
+				return (BOOL)FALSE;
+
+			if(Coverage == (STACK_HUGE_PAGE_COVERAGE*)NULL)
+				return (BOOL)FALSE;
+		#endif // end of STACK_SAFE_MODE
+
+		Coverage->ArenaBytes = (UINT64)0;
+		Coverage->HugeTlbBytes = (UINT64)0;
+		Coverage->AdvisedBytes = (UINT64)0;
+
+		for(Block = (STACK_ARENA_BLOCK*)(Stack->ArenaBlocks); Block != (STACK_ARENA_BLOCK*)NULL; Block = (STACK_ARENA_BLOCK*)(Block->Next))
+		{
+			Coverage->ArenaBytes += Block->SizeInBytes;
+
+			if(Block->Backing == STACK_ARENA_BLOCK_HUGE_TLB)
+				Coverage->HugeTlbBytes += Block->SizeInBytes;
+			else if(Block->Backing == STACK_ARENA_BLOCK_ADVISED)
+				Coverage->AdvisedBytes += Block->SizeInBytes;
+		}
+
+		return (BOOL)TRUE;
+	}
+#endif // end of USING_STACK_HUGE_PAGE_ARENA
+
+#if (USING_STACK_NODE_CACHE == 1)
+	BOOL StackReserve(STACK *Stack, UINT32 Count)
+	{
+		STACK_NODE *TempStackNode;
+
+		#if (STACK_SAFE_MODE == 1)
+			if(StackIsNull(Stack))
+				return (BOOL)FALSE;
+		#endif // end of STACK_SAFE_MODE
+
+		/*
+			Make sure the cache is allowed to hold everything we are
+			about to put into it, otherwise StackPop() would just free
+			the reserved STACK_NODE's again.
+		*/
+		if(Stack->NodeCacheLimit < Count)
+			Stack->NodeCacheLimit = (UINT32)Count;
+
+		/*
+			Keep allocating STACK_NODE's into the cache until it holds
+			enough for Count calls to StackPush().
+		*/
+		while(Stack->NodeCacheSize < Count)
+		{
+			if((TempStackNode = (STACK_NODE*)StackAllocate(Stack, StackNodeSizeInBytes(Stack))) == (STACK_NODE*)NULL)
+			{
+				#if (USING_STACK_STATISTICS == 1)
+					Stack->Stats.AllocationFailures++;
+				#endif // end of USING_STACK_STATISTICS
+
+				return (BOOL)FALSE;
+			}
+
+			TempStackNode->Next = (STACK_NODE*)(Stack->NodeCache);
+			Stack->NodeCache = (STACK_NODE*)TempStackNode;
+			Stack->NodeCacheSize++;
+		}
+
+		return (BOOL)TRUE;
+	}
+#endif // end of USING_STACK_NODE_CACHE
+
+#if (USING_STACK_NODE_CACHE == 1) || (USING_STACK_NODE_ARENA == 1)
+	BOOL StackShrink(STACK *Stack)
+	{
+		#if (STACK_SAFE_MODE == 1)
+			if(StackIsNull(Stack))
+				return (BOOL)FALSE;
+		#endif // end of STACK_SAFE_MODE
+
+		#if (USING_STACK_NODE_ARENA == 1)
+			/*
+				The block an empty STACK kept of its arena is handed back.
+				A STACK that isn't empty keeps its whole arena.
+			*/
+			if(StackIsEmpty(Stack))
+				StackArenaRelease(Stack);
+		#else
+			StackTrimNodeCache(Stack, (UINT32)0);
+		#endif // end of USING_STACK_NODE_ARENA
+
+		return (BOOL)TRUE;
+	}
+#endif // end of USING_STACK_NODE_CACHE or USING_STACK_NODE_ARENA
+
+#if (USING_STACK_NODE_CACHE == 1)
+	BOOL StackSetNodeCacheLimit(STACK *Stack, UINT32 Limit)
+	{
+		#if (STACK_SAFE_MODE == 1)
+			if(StackIsNull(Stack))
+				return (BOOL)FALSE;
+		#endif // end of STACK_SAFE_MODE
+
+		Stack->NodeCacheLimit = (UINT32)Limit;
+
+		/*
+			If the cache is already holding more than the new limit
+			then hand the extra STACK_NODE's back.
+		*/
+		StackTrimNodeCache(Stack, Limit);
+
+		return (BOOL)TRUE;
+	}
+#endif // end of USING_STACK_NODE_CACHE
+
+#if (USING_STACK_GET_SIZE_METHOD == 1)
+	UINT32 StackGetSize(STACK *Stack)
+	{
+		#if (STACK_SAFE_MODE == 1)
+			if(StackIsNull(Stack))
+				return (UINT32)0;
+		#endif // end of STACK_SAFE_MODE
+
+		/*
+			Return the Stack's size.
+		*/
+		return (UINT32)(Stack->Size);
+	}
+#endif // end of USING_STACK_GET_SIZE_METHOD
+
+#if (USING_STACK_GET_SIZE_IN_BYTES_METHOD == 1)
+	UINT32 StackGetSizeInBytes(STACK *Stack, UINT32 DataSizeInBytes)
+	{
+		UINT32 Size;
+	
+		#if (STACK_SAFE_MODE == 1)
+			if(StackIsNull(Stack))
+				return (UINT32)0;	
+		#endif // end of STACK_SAFE_MODE	
+
+		#if (USING_STACK_BOUNDED_METHODS == 1)
+			/*
+				A bounded STACK takes up its whole buffer however full it is.
+			*/
+			if(StackIsBounded(Stack))
+				return (UINT32)(sizeof(STACK) + ((Stack->Capacity) * sizeof(void*)) + ((Stack->Size) * DataSizeInBytes));
+		#endif // end of USING_STACK_BOUNDED_METHODS
+
+		#if (USING_STACK_SERIALIZE_METHODS == 1)
+			/*
+				A view's items are in the caller's buffer, not the STACK.
+			*/
+			if(StackIsView(Stack))
+				return (UINT32)sizeof(STACK);
+		#endif // end of USING_STACK_SERIALIZE_METHODS
+
+		/*
+			If the STACK is empty then we just need to return
+			the size of a STACK in bytes.  A STACK with all of its items
+			spilled can still be holding on to an emptied STACK_NODE.
+		*/
+		if(Stack->TopOfStack == (STACK_NODE*)NULL)
+			return (UINT32)(sizeof(STACK) + ((Stack->Size) * DataSizeInBytes));
+	
+		/*
+			Start off with the size of a STACK in bytes.
+		*/
+		Size = (UINT32)sizeof(STACK);
+
+		#if (USING_STACK_INLINE_BUFFER == 1)
+			/*
+				The STACK_NODE's in the inline buffer are counted with the
+				rest below, but they are already part of the STACK.
+			*/
+			Size -= (UINT32)(Stack->InlineNodesInUse * StackNodeSizeInBytes(Stack));
+		#endif // end of USING_STACK_INLINE_BUFFER
+	
+		#if (USING_STACK_CHUNKED_STORAGE == 1)
+		{
+			UINT32 NumberOfNodes;
+
+			#if (USING_STACK_SPLICE_METHODS == 1)
+				STACK_NODE *TempStackNode;
+
+				/*
+					StackSplice() and StackSplitTop() leave STACK_NODE's that
+					aren't full in the middle of the STACK, so they have to be
+					counted one by one.
+				*/
+				NumberOfNodes = (UINT32)0;
+
+				for(TempStackNode = (STACK_NODE*)(Stack->TopOfStack); TempStackNode != (STACK_NODE*)NULL; TempStackNode = (STACK_NODE*)(TempStackNode->Next))
+					NumberOfNodes++;
+			#else
+				/*
+					Every STACK_NODE below the top one is full, so the number of
+					STACK_NODE's follows from the number of items in memory.  The
+					top STACK_NODE might also be one StackPop() has emptied.
+				*/
+				NumberOfNodes = (UINT32)((StackInMemorySize(Stack) + Stack->ElementsPerNode - 1) / Stack->ElementsPerNode);
+
+				if(Stack->TopOfStack->Count == (UINT32)0)
+					NumberOfNodes++;
+			#endif // end of USING_STACK_SPLICE_METHODS
+
+			Size += (UINT32)(NumberOfNodes * StackNodeSizeInBytes(Stack));
+
+			/*
+				A value STACK's items are already inside its STACK_NODE's.
+			*/
+			#if (USING_STACK_VALUE_METHODS == 1)
+				if(StackIsValueStack(Stack))
+					return (UINT32)Size;
+			#endif // end of USING_STACK_VALUE_METHODS
+
+			Size += (UINT32)((Stack->Size) * DataSizeInBytes);
+		}
+		#else
+			#if (USING_STACK_VALUE_METHODS == 1)
+				if(StackIsValueStack(Stack))
+					return (UINT32)(Size + (StackInMemorySize(Stack) * StackNodeSizeInBytes(Stack)));
+			#endif // end of USING_STACK_VALUE_METHODS
+
+			/*
+				If the user passed in a value for DataSizeInBytes then use this value
+				to calculate the size of the STACK.  Otherwise we just use the number
+				of STACK_NODE's multiplied by the size of the STACK.  Only the items
+				in memory have a STACK_NODE, the data of every item is still around.
+			*/
+			Size += (UINT32)(StackInMemorySize(Stack) * (UINT32)sizeof(STACK_NODE));
+
+			if(DataSizeInBytes)
+			{
+				Size += (UINT32)((Stack->Size) * DataSizeInBytes);
+			}
+		#endif // end of USING_STACK_CHUNKED_STORAGE
+	
+		return (UINT32)Size;
+	}
+#endif // end of USING_STACK_GET_SIZE_IN_BYTES_METHOD
+
+#if (USING_STACK_SPILL_METHODS == 1)
+	BOOL StackSetMemoryBudget(STACK *Stack, UINT32 BudgetInBytes)
+	{
+		UINT32 BytesPerItem;
+
+		#if (STACK_SAFE_MODE == 1)
+			if(StackIsNull(Stack))
+				return (BOOL)FALSE;
+
+			#if (USING_STACK_BOUNDED_METHODS == 1)
+				if(StackIsBounded(Stack))
+					return (BOOL)FALSE;
+			#endif // end of USING_STACK_BOUNDED_METHODS
+
+			#if (USING_STACK_SERIALIZE_METHODS == 1)
+				if(StackIsView(Stack))
+					return (BOOL)FALSE;
+			#endif // end of USING_STACK_SERIALIZE_METHODS
+		#endif // end of STACK_SAFE_MODE
+
+		/*
+			Turn the budget into the number of items whose STACK_NODE's fit in
+			it, always leaving room for at least two so a spill has something
+			to keep and something to move.
+		*/
+		#if (USING_STACK_CHUNKED_STORAGE == 1)
+			BytesPerItem = (UINT32)((StackNodeSizeInBytes(Stack) + Stack->ElementsPerNode - 1) / Stack->ElementsPerNode);
+		#else
+			BytesPerItem = (UINT32)StackNodeSizeInBytes(Stack);
+		#endif // end of USING_STACK_CHUNKED_STORAGE
+
+		Stack->MaxInMemoryItems = (UINT32)(BudgetInBytes / BytesPerItem);
+
+		if(BudgetInBytes && Stack->MaxInMemoryItems < (UINT32)2)
+			Stack->MaxInMemoryItems = (UINT32)2;
+
+		/*
+			A STACK already over the new budget is spilled right away.
+		*/
+		if(Stack->MaxInMemoryItems && StackInMemorySize(Stack) > Stack->MaxInMemoryItems)
+			return StackSpill(Stack);
+
+		return (BOOL)TRUE;
+	}
+
+	UINT32 StackGetSpilledSize(STACK *Stack)
+	{
+		#if (STACK_SAFE_MODE == 1)
+			if(StackIsNull(Stack))
+				return (UINT32)0;
+		#endif // end of STACK_SAFE_MODE
+
+		return (UINT32)(Stack->SpilledSize);
+	}
+
+	UINT64 StackGetSpilledSizeInBytes(STACK *Stack)
+	{
+		#if (STACK_SAFE_MODE == 1)
+			if(StackIsNull(Stack))
+				return (UINT64)0;
+		#endif // end of STACK_SAFE_MODE
+
+		return (UINT64)(Stack->SpilledSize) * StackSlotSizeInBytes(Stack);
+	}
+#endif // end of USING_STACK_SPILL_METHODS
+
+#if (USING_STACK_SERIALIZE_METHODS == 1)
+	/*
+		Copies one item of ElementSize bytes to Out.  Slot is where the
+		STACK keeps the item, which on a value STACK is the item itself and
+		on any other STACK is its data pointer.
+	*/
+	static void StackSerializeItem(STACK *Stack, BYTE *Out, const BYTE *Slot, UINT32 ElementSize)
+	{
+		const void *Data;
+
+		if(StackIsValueStack(Stack))
+			Data = (const void*)Slot;
+		else
+			memcpy((void*)&Data, (const void*)Slot, sizeof(void*));
+
+		memcpy((void*)Out, Data, ElementSize);
+	}
+
+	/*
+		Copies the STACK_SERIAL_HEADER out of the start of Buffer, which may
+		not be aligned, and checks that it is one StackSerialize() wrote and
+		that all of its items are in the buffer.
+	*/
+	static BOOL StackReadSerialHeader(STACK_SERIAL_HEADER *Header, const void *Buffer, UINT32 BufferSize)
+	{
+		if(BufferSize < (UINT32)sizeof(STACK_SERIAL_HEADER))
+			return (BOOL)FALSE;
+
+		memcpy((void*)Header, Buffer, sizeof(STACK_SERIAL_HEADER));
+
+		if(Header->Magic != STACK_SERIAL_MAGIC || Header->Version != STACK_SERIAL_VERSION || Header->ElementSize == (UINT32)0)
+			return (BOOL)FALSE;
+
+		/*
+			The items are only good on a machine laid out like the one that
+			wrote them.
+		*/
+		if(Header->ByteOrder != STACK_SERIAL_BYTE_ORDER || Header->WordSize != (UINT32)sizeof(void*))
+			return (BOOL)FALSE;
+
+		return (BOOL)(Header->Size <= (BufferSize - (UINT32)sizeof(STACK_SERIAL_HEADER)) / Header->ElementSize);
+	}
+
+	UINT32 StackGetSerializedSize(STACK *Stack, UINT32 ElementSize)
+	{
+		#if (STACK_SAFE_MODE == 1)
+			if(StackIsNull(Stack))
+				return (UINT32)0;
+		#endif // end of STACK_SAFE_MODE
+
+		if(StackIsValueStack(Stack))
+			ElementSize = (UINT32)(Stack->ElementSize);
+
+		if(ElementSize == (UINT32)0)
+			return (UINT32)0;
+
+		/*
+			The whole buffer has to be describable with a UINT32.
+		*/
+		if(Stack->Size > ((UINT32)0xFFFFFFFF - (UINT32)sizeof(STACK_SERIAL_HEADER)) / ElementSize)
+			return (UINT32)0;
+
+		return (UINT32)(sizeof(STACK_SERIAL_HEADER) + (Stack->Size * ElementSize));
+	}
+
+	UINT32 StackSerialize(STACK *Stack, UINT32 ElementSize, void *Buffer, UINT32 BufferSize)
+	{
+		STACK_SERIAL_HEADER Header;
+		STACK_NODE *TempStackNode;
+		BYTE *Out;
+		UINT32 SerializedSize, i;
+
+		#if (STACK_SAFE_MODE == 1)
+			if(StackIsNull(Stack) || Buffer == (void*)NULL)
+				return (UINT32)0;
+		#endif // end of STACK_SAFE_MODE
+
+		if((SerializedSize = StackGetSerializedSize(Stack, ElementSize)) == (UINT32)0 || SerializedSize > BufferSize)
+			return (UINT32)0;
+
+		if(StackIsValueStack(Stack))
+			ElementSize = (UINT32)(Stack->ElementSize);
+
+		Header.Magic = STACK_SERIAL_MAGIC;
+		Header.Version = STACK_SERIAL_VERSION;
+		Header.ByteOrder = STACK_SERIAL_BYTE_ORDER;
+		Header.WordSize = (UINT32)sizeof(void*);
+		Header.ElementSize = (UINT32)ElementSize;
+		Header.Size = (UINT32)(Stack->Size);
+
+		memcpy(Buffer, (const void*)&Header, sizeof(STACK_SERIAL_HEADER));
+
+		/*
+			The items go out bottom first, but the STACK is walked from the
+			top, so they are written from the end of the buffer backwards.
+		*/
+		Out = (BYTE*)Buffer + SerializedSize;
+
+		if(StackIsView(Stack))
+		{
+			memcpy((void*)((BYTE*)Buffer + sizeof(STACK_SERIAL_HEADER)), (const void*)(Stack->View), Stack->Size * ElementSize);
+
+			return (UINT32)SerializedSize;
+		}
+
+		#if (USING_STACK_BOUNDED_METHODS == 1)
+			if(StackIsBounded(Stack))
+			{
+				for(i = (UINT32)(Stack->Size); i--; )
+				{
+					Out -= ElementSize;
+					StackSerializeItem(Stack, Out, (const BYTE*)&(Stack->Buffer[i]), ElementSize);
+				}
+
+				return (UINT32)SerializedSize;
+			}
+		#endif // end of USING_STACK_BOUNDED_METHODS
+
+		for(TempStackNode = (STACK_NODE*)(Stack->TopOfStack); TempStackNode != (STACK_NODE*)NULL; TempStackNode = (STACK_NODE*)(TempStackNode->Next))
+		{
+			for(i = (UINT32)StackNodeItemCount(TempStackNode); i--; )
+			{
+				Out -= ElementSize;
+				StackSerializeItem(Stack, Out, (const BYTE*)StackSlotAddress(Stack, TempStackNode, i), ElementSize);
+			}
+		}
+
+		#if (USING_STACK_SPILL_METHODS == 1)
+			/*
+				The spilled items are already bottom first in the spill file, 
+				so they are read straight into the front of the buffer.
+			*/
+			if(Stack->SpilledSize)
+			{
+				BYTE Slot[sizeof(void*)];
+
+				Out = (BYTE*)Buffer + sizeof(STACK_SERIAL_HEADER);
+
+				if(fseek(Stack->SpillFile, 0L, SEEK_SET))
+					return (UINT32)0;
+
+				if(StackIsValueStack(Stack))
+				{
+					if(fread((void*)Out, ElementSize, Stack->SpilledSize, Stack->SpillFile) != Stack->SpilledSize)
+						return (UINT32)0;
+				}
+				else
+				{
+					for(i = (UINT32)0; i < Stack->SpilledSize; i++, Out += ElementSize)
+					{
+						if(fread((void*)Slot, sizeof(void*), 1, Stack->SpillFile) != 1)
+							return (UINT32)0;
+
+						StackSerializeItem(Stack, Out, Slot, ElementSize);
+					}
+				}
+			}
+		#endif // end of USING_STACK_SPILL_METHODS
+
+		return (UINT32)SerializedSize;
+	}
+
+	BOOL StackDeserialize(STACK *Stack, const void *Buffer, UINT32 BufferSize)
+	{
+		STACK_SERIAL_HEADER Header;
+		const BYTE *In;
+		void *Data;
+		UINT32 Pushed, i;
+
+		#if (STACK_SAFE_MODE == 1)
+			if(StackIsNull(Stack) || Buffer == (const void*)NULL)
+				return (BOOL)FALSE;
+		#endif // end of STACK_SAFE_MODE
+
+		if(!StackReadSerialHeader(&Header, Buffer, BufferSize))
+			return (BOOL)FALSE;
+
+		if(StackIsView(Stack))
+			return (BOOL)FALSE;
+
+		/*
+			A value STACK can only take items of its own size.  It also needs
+			somewhere to pop items into if they have to be taken back off.
+		*/
+		Data = (void*)NULL;
+
+		if(StackIsValueStack(Stack))
+		{
+			if(Stack->ElementSize != Header.ElementSize)
+				return (BOOL)FALSE;
+
+			if((Data = StackAllocate(Stack, Header.ElementSize)) == (void*)NULL)
+				return (BOOL)FALSE;
+		}
+
+		In = (const BYTE*)Buffer + sizeof(STACK_SERIAL_HEADER);
+
+		/*
+			The items are bottom first, so pushing them in order puts them
+			back the way they were.  A STACK of data pointers gets its own
+			copy of each item, for its free method to free later.
+		*/
+		for(i = (UINT32)0; i < Header.Size; i++, In += Header.ElementSize)
+		{
+			if(StackIsValueStack(Stack))
+			{
+				if(!StackPushValue(Stack, (const void*)In))
+					break;
+			}
+			else
+			{
+				void *Copy;
+
+				if((Copy = StackAllocate(Stack, Header.ElementSize)) == (void*)NULL)
+					break;
+
+				memcpy(Copy, (const void*)In, Header.ElementSize);
+
+				if(!StackPush(Stack, (const void*)Copy))
+				{
+					StackDeallocate(Stack, Copy);
+
+					break;
+				}
+			}
+		}
+
+		/*
+			If not everything could be pushed, take back off what was, so
+			the STACK is left as it was.
+		*/
+		if(i < Header.Size)
+		{
+			Pushed = (UINT32)i;
+
+			while(Pushed--)
+			{
+				if(StackIsValueStack(Stack))
+					StackPopValue(Stack, Data);
+				else
+					StackDeallocate(Stack, StackPop(Stack));
+			}
+		}
+
+		if(Data != (void*)NULL)
+			StackDeallocate(Stack, Data);
+
+		return (BOOL)(i == Header.Size);
+	}
+
+	STACK *CreateStackView(STACK *Stack, const void *Buffer, UINT32 BufferSize)
+	{
+		STACK_SERIAL_HEADER Header;
+
+		#if (STACK_SAFE_MODE == 1)
+			if(Buffer == (const void*)NULL)
+				return (STACK*)NULL;
+		#endif // end of STACK_SAFE_MODE
+
+		if(!StackReadSerialHeader(&Header, Buffer, BufferSize))
+			return (STACK*)NULL;
+
+		if((Stack = CreateValueStack(Stack, Header.ElementSize)) == (STACK*)NULL)
+			return (STACK*)NULL;
+
+		Stack->View = (const BYTE*)Buffer + sizeof(STACK_SERIAL_HEADER);
+		Stack->Size = (UINT32)(Header.Size);
+
+		return (STACK*)Stack;
+	}
+#endif // end of USING_STACK_SERIALIZE_METHODS
+
+#if (USING_STACK_STATISTICS == 1)
+	BOOL StackGetStats(STACK *Stack, STACK_STATS *Stats)
+	{
+		#if (STACK_SAFE_MODE == 1)
+			if(StackIsNull(Stack))
+				return (BOOL)FALSE;
+
+			if(Stats == (STACK_STATS*)NULL)
+				return (BOOL)FALSE;
+		#endif // end of STACK_SAFE_MODE
+
+		*Stats = Stack->Stats;
+
+		return (BOOL)TRUE;
+	}
+
+	BOOL StackResetStats(STACK *Stack)
+	{
+		#if (USING_STACK_LATENCY_HISTOGRAM == 1)
+			UINT32 i;
+		#endif // end of USING_STACK_LATENCY_HISTOGRAM
+
+		#if (STACK_SAFE_MODE == 1)
+			if(StackIsNull(Stack))
+				return (BOOL)FALSE;
+		#endif // end of STACK_SAFE_MODE
+
+		/*
+			The peak starts over from how deep the STACK is right now.
+		*/
+		Stack->Stats.Pushes = (UINT64)0;
+		Stack->Stats.Pops = (UINT64)0;
+		Stack->Stats.PeakSize = (UINT32)(Stack->Size);
+		Stack->Stats.AllocationFailures = (UINT32)0;
+		Stack->Stats.Clears = (UINT32)0;
+
+		#if (USING_STACK_LATENCY_HISTOGRAM == 1)
+			Stack->Stats.SampleCountdown = (UINT32)STACK_LATENCY_SAMPLE_PERIOD;
+
+			for(i = (UINT32)0; i < (UINT32)STACK_LATENCY_HISTOGRAM_BUCKETS; i++)
+			{
+				Stack->Stats.PushLatency[i] = (UINT32)0;
+				Stack->Stats.PopLatency[i] = (UINT32)0;
+			}
+		#endif // end of USING_STACK_LATENCY_HISTOGRAM
+
+		return (BOOL)TRUE;
+	}
+#endif // end of USING_STACK_STATISTICS
+
+#if (USING_STACK_CONCURRENT_METHODS == 1)
+	/*
+		Every thread that pops from a CONCURRENT_STACK owns one of these.
+		Before a thread reads a CONCURRENT_STACK_NODE that another thread
+		could pop and free, it publishes the node's address in Hazard.
+		Popped nodes go into the thread's RetiredList, and are only freed
+		once no Hazard of any thread points at them.  This is also what
+		protects against ABA, as a node can't be freed and handed out again
+		by StackMemAlloc() while some thread is still comparing against it.
+	*/
+	typedef struct _StackHazardRecord
+	{
+		/**
+		* The CONCURRENT_STACK_NODE this thread is about to read, or NULL.
+		*/
+		CONCURRENT_STACK_NODE *Hazard;
+
+		/**
+		* Non zero while a thread owns this record.
+		*/
+		UINT32 Active;
+
+		/**
+		* The popped CONCURRENT_STACK_NODE's waiting to be freed.
+		*/
+		CONCURRENT_STACK_NODE *RetiredList;
+
+		/**
+		* The number of CONCURRENT_STACK_NODE's in RetiredList.
+		*/
+		UINT32 RetiredCount;
+
+		/**
+		* The next record in StackHazardRecords.  Records are never removed.
+		*/
+		struct _StackHazardRecord *Next;
+
+		#if (USING_STACK_ELIMINATION_BACKOFF == 1)
+			/**
+			* How many slots of an elimination array this thread picks from.
+			* Grows when the thread keeps colliding and shrinks when it keeps
+			* waiting for nobody.
+			*/
+			UINT32 EliminationRange;
+
+			/**
+			* The state of this thread's random slot picker.
+			*/
+			UINT32 RandomSeed;
+		#endif // end of USING_STACK_ELIMINATION_BACKOFF
+
+		BYTE Padding[STACK_CACHE_LINE_SIZE];
+	}STACK_HAZARD_RECORD;
+
+	/*
+		Every STACK_HAZARD_RECORD ever created, and how many there are.
+	*/
+	static STACK_HAZARD_RECORD *StackHazardRecords = (STACK_HAZARD_RECORD*)NULL;
+	static UINT32 StackHazardRecordCount = (UINT32)0;
+
+	/*
+		The STACK_HAZARD_RECORD the calling thread owns, if any.
+	*/
+	static StackThreadLocal STACK_HAZARD_RECORD *StackThreadHazardRecord = (STACK_HAZARD_RECORD*)NULL;
+
+	#if (USING_STACK_NODE_MAGAZINES == 1)
+		/*
+			A magazine of free CONCURRENT_STACK_NODE's.  Only the CPU or
+			thread it belongs to ever touches it.
+		*/
+		typedef struct _StackMagazine
+		{
+			/**
+			* The number of CONCURRENT_STACK_NODE's in Nodes.  Changing it
+			* is what commits a take or a put.
+			*/
+			UINT32 Count;
+
+			CONCURRENT_STACK_NODE *Nodes[STACK_MAGAZINE_SIZE];
+
+			BYTE Padding[STACK_CACHE_LINE_SIZE];
+		}STACK_MAGAZINE;
+
+		/*
+			The magazine of a thread that can't use a CPU's magazine.
+		*/
+		static StackThreadLocal STACK_MAGAZINE StackThreadMagazine;
+
+		/*
+			Full batches of free CONCURRENT_STACK_NODE's the magazines are 
+			refilled from and drained to.  The nodes of a batch are chained
+			through Next, and batches through the Data of their first node.
+		*/
+		static pthread_mutex_t StackDepotLock = PTHREAD_MUTEX_INITIALIZER;
+		static CONCURRENT_STACK_NODE *StackDepot = (CONCURRENT_STACK_NODE*)NULL;
+		static UINT32 StackDepotBatches = (UINT32)0;
+
+		#if defined(STACK_MAGAZINES_USE_RSEQ)
+			static STACK_MAGAZINE StackCpuMagazines[STACK_MAGAZINE_MAX_CPUS];
+
+			/*
+				The calling thread's rseq area, which glibc registered with
+				the kernel when the thread started.
+			*/
+			#define StackRseqArea()					((volatile struct rseq*)((BYTE*)__builtin_thread_pointer() + __rseq_offset))
+
+			/*
+				The start of a restartable sequence: the struct rseq_cs the 
+				kernel reads, and storing its address in the rseq area.  If
+				the thread is preempted, migrated or gets a signal between 
+				label 1 and label 2, the kernel moves it to label 4.
+			*/
+			#define STACK_RSEQ_BEGIN												\
+				".pushsection __rseq_cs, \"aw\"\n\t"								\
+				".balign 32\n\t"													\
+				"3:\n\t"															\
+				".long 0, 0\n\t"													\
+				".quad 1f, (2f - 1f), 4f\n\t"										\
+				".popsection\n\t"													\
+				"leaq 3b(%%rip), %%rax\n\t"										\
+				"movq %%rax, %[RseqCs]\n\t"										\
+				"1:\n\t"															\
+				"cmpl %[Cpu], %[CurrentCpu]\n\t"									\
+				"jnz 4f\n\t"
+
+			/*
+				The end of a restartable sequence, right after its commit, and
+				the abort handler with the signature the kernel checks for in
+				front of it.
+			*/
+			#define STACK_RSEQ_END													\
+				"2:\n\t"															\
+				".pushsection __rseq_failure, \"ax\"\n\t"							\
+				".byte 0x0f, 0xb9, 0x3d\n\t"										\
+				".long 0x53053053\n\t"												\
+				"4:\n\t"															\
+				"jmp %l[Abort]\n\t"												\
+				".popsection\n\t"
+
+			/*
+				Takes the top CONCURRENT_STACK_NODE out of the magazine of CPU
+				Cpu.  Returns 1 if it did, 0 if the magazine was empty, and -1
+				if the sequence was restarted, in which case nothing changed.
+			*/
+			static int StackRseqMagazineTake(STACK_MAGAZINE *Magazine, UINT32 Cpu, CONCURRENT_STACK_NODE **StackNode)
+			{
+				volatile struct rseq *Rseq;
+
+				Rseq = StackRseqArea();
+
+				__asm__ __volatile__ goto(
+					STACK_RSEQ_BEGIN
+					"movl %[Count], %%ecx\n\t"
+					"testl %%ecx, %%ecx\n\t"
+					"jz %l[Empty]\n\t"
+					"decl %%ecx\n\t"
+					"movq (%[Nodes], %%rcx, 8), %%rax\n\t"
+					"movq %%rax, (%[StackNode])\n\t"
+					"movl %%ecx, %[Count]\n\t"
+					STACK_RSEQ_END
+					:
+					: [RseqCs] "m" (Rseq->rseq_cs), [Cpu] "r" (Cpu), [CurrentCpu] "m" (Rseq->cpu_id), [Count] "m" (Magazine->Count), [Nodes] "r" (Magazine->Nodes), [StackNode] "r" (StackNode)
+					: "memory", "cc", "rax", "rcx"
+					: Empty, Abort);
+
+				return 1;
+
+			Empty:
+				return 0;
+
+			Abort:
+				return -1;
+			}
+
+			/*
+				Puts StackNode on top of the magazine of CPU Cpu.  Returns 1 if
+				it did, 0 if the magazine was full, and -1 if the sequence was
+				restarted, in which case nothing changed.
+			*/
+			static int StackRseqMagazinePut(STACK_MAGAZINE *Magazine, UINT32 Cpu, CONCURRENT_STACK_NODE *StackNode)
+			{
+				volatile struct rseq *Rseq;
+
+				Rseq = StackRseqArea();
+
+				__asm__ __volatile__ goto(
+					STACK_RSEQ_BEGIN
+					"movl %[Count], %%ecx\n\t"
+					"cmpl %[Size], %%ecx\n\t"
+					"jae %l[Full]\n\t"
+					"movq %[StackNode], (%[Nodes], %%rcx, 8)\n\t"
+					"incl %%ecx\n\t"
+					"movl %%ecx, %[Count]\n\t"
+					STACK_RSEQ_END
+					:
+					: [RseqCs] "m" (Rseq->rseq_cs), [Cpu] "r" (Cpu), [CurrentCpu] "m" (Rseq->cpu_id), [Count] "m" (Magazine->Count), [Nodes] "r" (Magazine->Nodes), [StackNode] "r" (StackNode), [Size] "i" (STACK_MAGAZINE_SIZE)
+					: "memory", "cc", "rax", "rcx"
+					: Full, Abort);
+
+				return 1;
+
+			Full:
+				return 0;
+
+			Abort:
+				return -1;
+			}
+		#endif // end of STACK_MAGAZINES_USE_RSEQ
+
+		/*
+			Takes a CONCURRENT_STACK_NODE out of the magazine of the CPU the
+			thread is on, or out of the thread's own magazine.  Returns 
+			FALSE if the magazine was empty.
+		*/
+		static BOOL StackMagazineTake(CONCURRENT_STACK_NODE **StackNode)
+		{
+			#if defined(STACK_MAGAZINES_USE_RSEQ)
+				UINT32 Cpu;
+				int Result;
+
+				/*
+					cpu_id is never below STACK_MAGAZINE_MAX_CPUS for a thread
+					that isn't registered, as it is negative then.
+				*/
+				if(__rseq_size)
+				{
+					while((Cpu = StackRseqArea()->cpu_id) < (UINT32)STACK_MAGAZINE_MAX_CPUS)
+					{
+						if((Result = StackRseqMagazineTake(&StackCpuMagazines[Cpu], Cpu, StackNode)) >= 0)
+							return (BOOL)(Result > 0);
+					}
+				}
+			#endif // end of STACK_MAGAZINES_USE_RSEQ
+
+			if(StackThreadMagazine.Count == (UINT32)0)
+				return (BOOL)FALSE;
+
+			*StackNode = (CONCURRENT_STACK_NODE*)(StackThreadMagazine.Nodes[--StackThreadMagazine.Count]);
+
+			return (BOOL)TRUE;
+		}
+
+		/*
+			Puts a CONCURRENT_STACK_NODE into the magazine of the CPU the
+			thread is on, or into the thread's own magazine.  Returns FALSE
+			if the magazine was full.
+		*/
+		static BOOL StackMagazinePut(CONCURRENT_STACK_NODE *StackNode)
+		{
+			#if defined(STACK_MAGAZINES_USE_RSEQ)
+				UINT32 Cpu;
+				int Result;
+
+				if(__rseq_size)
+				{
+					while((Cpu = StackRseqArea()->cpu_id) < (UINT32)STACK_MAGAZINE_MAX_CPUS)
+					{
+						if((Result = StackRseqMagazinePut(&StackCpuMagazines[Cpu], Cpu, StackNode)) >= 0)
+							return (BOOL)(Result > 0);
+					}
+				}
+			#endif // end of STACK_MAGAZINES_USE_RSEQ
+
+			if(StackThreadMagazine.Count == (UINT32)STACK_MAGAZINE_SIZE)
+				return (BOOL)FALSE;
+
+			StackThreadMagazine.Nodes[StackThreadMagazine.Count++] = (CONCURRENT_STACK_NODE*)StackNode;
+
+			return (BOOL)TRUE;
+		}
+
+		/*
+			Hands a batch of CONCURRENT_STACK_NODE's chained through Next to
+			the depot, or frees them with StackMemDealloc() if the depot is
+			full.
+		*/
+		static void StackDepotPut(CONCURRENT_STACK_NODE *Batch)
+		{
+			CONCURRENT_STACK_NODE *TempStackNode;
+
+			pthread_mutex_lock(&StackDepotLock);
+
+			if(StackDepotBatches < (UINT32)STACK_DEPOT_MAX_BATCHES)
+			{
+				Batch->Data = (void*)StackDepot;
+				StackDepot = (CONCURRENT_STACK_NODE*)Batch;
+				StackDepotBatches++;
+
+				pthread_mutex_unlock(&StackDepotLock);
+
+				return;
+			}
+
+			pthread_mutex_unlock(&StackDepotLock);
+
+			while((TempStackNode = Batch) != (CONCURRENT_STACK_NODE*)NULL)
+			{
+				Batch = (CONCURRENT_STACK_NODE*)(TempStackNode->Next);
+
+				StackMemDealloc((void*)TempStackNode);
+			}
+		}
+
+		/*
+			Returns a batch of CONCURRENT_STACK_NODE's chained through Next 
+			out of the depot, or (CONCURRENT_STACK_NODE*)NULL if it is empty.
+		*/
+		static CONCURRENT_STACK_NODE *StackDepotTake(void)
+		{
+			CONCURRENT_STACK_NODE *Batch;
+
+			pthread_mutex_lock(&StackDepotLock);
+
+			if((Batch = StackDepot) != (CONCURRENT_STACK_NODE*)NULL)
+			{
+				StackDepot = (CONCURRENT_STACK_NODE*)(Batch->Data);
+				StackDepotBatches--;
+			}
+
+			pthread_mutex_unlock(&StackDepotLock);
+
+			return (CONCURRENT_STACK_NODE*)Batch;
+		}
+
+		/*
+			Returns a CONCURRENT_STACK_NODE for a push.  An empty magazine is
+			refilled with a batch from the depot, and only when that is empty
+			too is StackMemAlloc() called.
+		*/
+		static CONCURRENT_STACK_NODE *StackAcquireConcurrentNode(void)
+		{
+			CONCURRENT_STACK_NODE *TempStackNode, *Batch, *NextStackNode;
+
+			if(StackMagazineTake(&TempStackNode))
+				return (CONCURRENT_STACK_NODE*)TempStackNode;
+
+			if((TempStackNode = (CONCURRENT_STACK_NODE*)StackDepotTake()) == (CONCURRENT_STACK_NODE*)NULL)
+				return (CONCURRENT_STACK_NODE*)StackMemAlloc(sizeof(CONCURRENT_STACK_NODE));
+
+			/*
+				Keep the first node of the batch and put the rest in the 
+				magazine.  Next is read first, as another thread on this CPU
+				may take a node as soon as it is in.
+			*/
+			Batch = (CONCURRENT_STACK_NODE*)(TempStackNode->Next);
+
+			while(Batch != (CONCURRENT_STACK_NODE*)NULL)
+			{
+				NextStackNode = (CONCURRENT_STACK_NODE*)(Batch->Next);
+
+				if(!StackMagazinePut(Batch))
+				{
+					StackDepotPut(Batch);
+
+					break;
+				}
+
+				Batch = (CONCURRENT_STACK_NODE*)NextStackNode;
+			}
+
+			return (CONCURRENT_STACK_NODE*)TempStackNode;
+		}
+
+		/*
+			Gives back a CONCURRENT_STACK_NODE no thread can be reading 
+			anymore.  A full magazine has half of its nodes moved to the
+			depot as one batch, along with this one.
+		*/
+		static void StackReleaseConcurrentNode(CONCURRENT_STACK_NODE *StackNode)
+		{
+			CONCURRENT_STACK_NODE *TempStackNode;
+			UINT32 i;
+
+			if(StackMagazinePut(StackNode))
+				return;
+
+			StackNode->Next = (CONCURRENT_STACK_NODE*)NULL;
+
+			for(i = (UINT32)1; i < (UINT32)(STACK_MAGAZINE_SIZE / 2) && StackMagazineTake(&TempStackNode); i++)
+			{
+				TempStackNode->Next = (CONCURRENT_STACK_NODE*)StackNode;
+				StackNode = (CONCURRENT_STACK_NODE*)TempStackNode;
+			}
+
+			StackDepotPut(StackNode);
+		}
+
+		/*
+			Moves everything in the thread's own magazine to the depot, so 
+			it isn't lost when the thread exits.
+		*/
+		static void StackDrainThreadMagazine(void)
+		{
+			CONCURRENT_STACK_NODE *Batch, *TempStackNode;
+
+			if(StackThreadMagazine.Count == (UINT32)0)
+				return;
+
+			Batch = (CONCURRENT_STACK_NODE*)NULL;
+
+			while(StackThreadMagazine.Count)
+			{
+				TempStackNode = (CONCURRENT_STACK_NODE*)(StackThreadMagazine.Nodes[--StackThreadMagazine.Count]);
+				TempStackNode->Next = (CONCURRENT_STACK_NODE*)Batch;
+				Batch = (CONCURRENT_STACK_NODE*)TempStackNode;
+			}
+
+			StackDepotPut(Batch);
+		}
+	#else
+		#define StackAcquireConcurrentNode()			(CONCURRENT_STACK_NODE*)StackMemAlloc(sizeof(CONCURRENT_STACK_NODE))
+		#define StackReleaseConcurrentNode(StackNode)	StackMemDealloc((void*)(StackNode))
+	#endif // end of USING_STACK_NODE_MAGAZINES
+
 	/*
-		If Stack is equal to (STACK*)NULL then the user wants to
-		create a new STACK in memory
+		Returns the calling thread's STACK_HAZARD_RECORD.  The first time
+		a thread calls this it takes over a record another thread gave up
+		with ConcurrentStackReleaseThread(), or allocates a new one.
+		Returns (STACK_HAZARD_RECORD*)NULL if StackMemAlloc() fails.
 	*/
-	if(StackIsNull(Stack))
+	static STACK_HAZARD_RECORD *StackGetHazardRecord(void)
 	{
-		if((Stack = (STACK*)StackMemAlloc(sizeof(STACK))) == (STACK*)NULL)
+		STACK_HAZARD_RECORD *Record;
+
+		if((Record = StackThreadHazardRecord) != (STACK_HAZARD_RECORD*)NULL)
+			return (STACK_HAZARD_RECORD*)Record;
+
+		/*
+			First try to reuse a record some thread is done with.
+		*/
+		for(Record = (STACK_HAZARD_RECORD*)StackAtomicLoad(&StackHazardRecords); Record != (STACK_HAZARD_RECORD*)NULL; Record = Record->Next)
 		{
-			return (STACK*)NULL;
+			if(StackAtomicLoad(&Record->Active) == (UINT32)0 && StackAtomicCompareAndSwap(&Record->Active, (UINT32)0, (UINT32)1))
+			{
+				StackThreadHazardRecord = (STACK_HAZARD_RECORD*)Record;
+
+				return (STACK_HAZARD_RECORD*)Record;
+			}
 		}
+
+		/*
+			Otherwise make a new one and link it in to the front of
+			StackHazardRecords.
+		*/
+		if((Record = (STACK_HAZARD_RECORD*)StackMemAlloc(sizeof(STACK_HAZARD_RECORD))) == (STACK_HAZARD_RECORD*)NULL)
+			return (STACK_HAZARD_RECORD*)NULL;
+
+		Record->Hazard = (CONCURRENT_STACK_NODE*)NULL;
+		Record->Active = (UINT32)1;
+		Record->RetiredList = (CONCURRENT_STACK_NODE*)NULL;
+		Record->RetiredCount = (UINT32)0;
+
+		do
+		{
+			Record->Next = (STACK_HAZARD_RECORD*)StackAtomicLoad(&StackHazardRecords);
+		}while(!StackAtomicCompareAndSwap(&StackHazardRecords, Record->Next, Record));
+
+		#if (USING_STACK_ELIMINATION_BACKOFF == 1)
+			/*
+				Seed each thread's slot picker differently off of how many
+				records there are.
+			*/
+			Record->EliminationRange = (UINT32)1;
+			Record->RandomSeed = (UINT32)(StackAtomicAdd(&StackHazardRecordCount, (UINT32)1) * (UINT32)2654435761UL);
+		#else
+			StackAtomicAdd(&StackHazardRecordCount, (UINT32)1);
+		#endif // end of USING_STACK_ELIMINATION_BACKOFF
+
+		StackThreadHazardRecord = (STACK_HAZARD_RECORD*)Record;
+
+		return (STACK_HAZARD_RECORD*)Record;
 	}
 
 	/*
-		Initialize the STACK to it's defualt values.
+		Frees every CONCURRENT_STACK_NODE in the record's RetiredList that
+		no thread has published as its Hazard.  The rest stay in the list.
 	*/
-	Stack->Size = (UINT32)0;
-	Stack->TopOfStack = (STACK_NODE*)NULL;
+	static void StackScanRetiredNodes(STACK_HAZARD_RECORD *Record)
+	{
+		CONCURRENT_STACK_NODE **Hazards, **MoreHazards, *TempStackNode, *StillHazardous;
+		STACK_HAZARD_RECORD *TempRecord;
+		UINT32 NumberOfHazards, MaxHazards, i;
 
-	#if(USING_STACK_DEPENDENT_FREE_METHOD == 1)
-		Stack->StackFreeMethod = (void (*)(void *))CustomFreeMethod;
-	#endif // end of USING_STACK_DEPENDENT_FREE_METHOD
+		/*
+			Take a snapshot of every published Hazard.  A record is linked
+			in before StackHazardRecordCount counts it, so there can be more
+			records than were counted.  Every one of them has to be looked
+			at, so the snapshot is made bigger whenever it fills up.
+		*/
+		MaxHazards = (UINT32)(StackAtomicLoad(&StackHazardRecordCount) + 1);
 
-	return (STACK*)Stack;
-}
+		if((Hazards = (CONCURRENT_STACK_NODE**)StackMemAlloc(MaxHazards * sizeof(CONCURRENT_STACK_NODE*))) == (CONCURRENT_STACK_NODE**)NULL)
+			return;
 
-BOOL StackPush(STACK *Stack, const void *Data)
-{
-	STACK_NODE *TempStackNode;
+		NumberOfHazards = (UINT32)0;
 
-	#if (STACK_SAFE_MODE == 1)
-		if(StackIsNull(Stack))
-			return (BOOL)FALSE;
-	#endif // end of STACK_SAFE_MODE
+		for(TempRecord = (STACK_HAZARD_RECORD*)StackAtomicLoad(&StackHazardRecords); TempRecord != (STACK_HAZARD_RECORD*)NULL; TempRecord = TempRecord->Next)
+		{
+			if((TempStackNode = (CONCURRENT_STACK_NODE*)StackAtomicLoad(&TempRecord->Hazard)) == (CONCURRENT_STACK_NODE*)NULL)
+				continue;
+
+			if(NumberOfHazards == MaxHazards)
+			{
+				/*
+					Without a full snapshot no node can be freed safely, so
+					the scan is left for next time.
+				*/
+				if((MoreHazards = (CONCURRENT_STACK_NODE**)StackMemAlloc(2 * MaxHazards * sizeof(CONCURRENT_STACK_NODE*))) == (CONCURRENT_STACK_NODE**)NULL)
+				{
+					StackMemDealloc((void*)Hazards);
+
+					return;
+				}
+
+				for(i = (UINT32)0; i < NumberOfHazards; i++)
+					MoreHazards[i] = (CONCURRENT_STACK_NODE*)(Hazards[i]);
+
+				StackMemDealloc((void*)Hazards);
+
+				Hazards = (CONCURRENT_STACK_NODE**)MoreHazards;
+				MaxHazards *= 2;
+			}
+
+			Hazards[NumberOfHazards++] = (CONCURRENT_STACK_NODE*)TempStackNode;
+		}
+
+		/*
+			Now go through the RetiredList freeing every node that wasn't
+			in the snapshot.
+		*/
+		StillHazardous = (CONCURRENT_STACK_NODE*)NULL;
+		Record->RetiredCount = (UINT32)0;
+
+		while((TempStackNode = (CONCURRENT_STACK_NODE*)(Record->RetiredList)) != (CONCURRENT_STACK_NODE*)NULL)
+		{
+			Record->RetiredList = (CONCURRENT_STACK_NODE*)(TempStackNode->Next);
+
+			for(i = (UINT32)0; i < NumberOfHazards; i++)
+			{
+				if(Hazards[i] == TempStackNode)
+					break;
+			}
+
+			if(i == NumberOfHazards)
+			{
+				StackReleaseConcurrentNode(TempStackNode);
+			}
+			else
+			{
+				StackAtomicStore(&TempStackNode->Next, (CONCURRENT_STACK_NODE*)StillHazardous);
+				StillHazardous = (CONCURRENT_STACK_NODE*)TempStackNode;
+				Record->RetiredCount++;
+			}
+		}
+
+		Record->RetiredList = (CONCURRENT_STACK_NODE*)StillHazardous;
+
+		StackMemDealloc((void*)Hazards);
+	}
 
 	/*
-		Allocate room in memory for a new STACK_NODE.
+		Puts a popped CONCURRENT_STACK_NODE into the record's RetiredList
+		and scans the list once enough nodes have built up.
 	*/
-	if((TempStackNode = (STACK_NODE*)StackMemAlloc(sizeof(STACK_NODE))) == (STACK_NODE*)NULL)
+	static void StackRetireNode(STACK_HAZARD_RECORD *Record, CONCURRENT_STACK_NODE *StackNode)
 	{
-		return (BOOL)FALSE;
+		/*
+			Threads that read the node as the top before it was popped can
+			still be reading Next, so it is overwritten atomically.
+		*/
+		StackAtomicStore(&StackNode->Next, (CONCURRENT_STACK_NODE*)(Record->RetiredList));
+		Record->RetiredList = (CONCURRENT_STACK_NODE*)StackNode;
+
+		if(++Record->RetiredCount >= (UINT32)(STACK_HAZARD_SCAN_THRESHOLD + (2 * StackAtomicLoad(&StackHazardRecordCount))))
+			StackScanRetiredNodes(Record);
 	}
 
-	/*
-		Place the newly allocated STACK_NODE on top of the STACK have the new
-		STACK_NODE point to the old top of stack.
+	#if (USING_STACK_ELIMINATION_BACKOFF == 1)
+		/*
+			Placed in an elimination slot by a pop to tell the waiting push
+			that its node was taken.
+		*/
+		static CONCURRENT_STACK_NODE StackEliminationTaken;
 
-		Also have the new STACK_NODE point to the data passed in by the user.
+		/*
+			Picks one of the first EliminationRange slots of the CONCURRENT_STACK's
+			elimination array at random (xorshift).
+		*/
+		static STACK_ELIMINATION_SLOT *StackGetEliminationSlot(CONCURRENT_STACK *Stack, STACK_HAZARD_RECORD *Record)
+		{
+			UINT32 Seed;
 
-		Also increment the STACK size by 1 to reflect the new Stack size.
-	*/
-	TempStackNode->Next = (STACK_NODE*)(Stack->TopOfStack);
-	TempStackNode->Data = (void*)Data;
-	Stack->TopOfStack = (STACK_NODE*)TempStackNode;
-	Stack->Size++;
+			Seed = Record->RandomSeed;
+			Seed ^= Seed << 13;
+			Seed ^= Seed >> 17;
+			Seed ^= Seed << 5;
+			Record->RandomSeed = (UINT32)Seed;
 
-	return (BOOL)TRUE;
-}
+			return (STACK_ELIMINATION_SLOT*)&(Stack->EliminationArray[Seed % Record->EliminationRange]);
+		}
 
-void *StackPop(STACK *Stack)
-{
-	void *Data;
-	STACK_NODE *TempStackNode;
+		/*
+			Called when a thread found its slot already taken by someone else.
+			Spread out over more slots.
+		*/
+		static void StackEliminationCollided(STACK_HAZARD_RECORD *Record)
+		{
+			if(Record->EliminationRange < (UINT32)STACK_ELIMINATION_ARRAY_SIZE)
+				Record->EliminationRange++;
+		}
 
-	#if (STACK_SAFE_MODE == 1)
-		if(StackIsNull(Stack))
-			return (void*)NULL;
-	
-		if(StackIsEmpty(Stack))
-			return (void*)NULL;
-	#endif // end of STACK_SAFE_MODE
+		/*
+			Called when a thread found nobody to pair up with.  Pull in to
+			fewer slots so the threads that are left meet more often.
+		*/
+		static void StackEliminationMissed(STACK_HAZARD_RECORD *Record)
+		{
+			if(Record->EliminationRange > (UINT32)1)
+				Record->EliminationRange--;
+		}
 
-	/*
-		Read in the top STACK_NODE's data to a temp pointer for returning later.
-		Decrement the STACK's size to reflect the change and then free the top
-		STACK_NODE from the STACK and have the new top of Stack point to the 
-		next STACK_NODE in the Stack.
-	*/
-	TempStackNode = (STACK_NODE*)(Stack->TopOfStack);
-	Data = (void*)(TempStackNode->Data);
-	Stack->Size--;
-	Stack->TopOfStack = (STACK_NODE*)(Stack->TopOfStack->Next);
-	
-	StackMemDealloc((void*)(TempStackNode));
+		/*
+			Offers StackNode in an elimination slot and waits a while for a
+			pop to take it.  Returns TRUE if a pop took it, in which case the
+			push is done and the node belongs to that pop.
+		*/
+		static BOOL StackEliminationPush(CONCURRENT_STACK *Stack, STACK_HAZARD_RECORD *Record, CONCURRENT_STACK_NODE *StackNode)
+		{
+			STACK_ELIMINATION_SLOT *Slot;
+			UINT32 i;
 
-	return (void*)Data;
-}
+			Slot = (STACK_ELIMINATION_SLOT*)StackGetEliminationSlot(Stack, Record);
 
-#if (USING_STACK_PEEK_METHOD == 1)
-	void *StackPeek(STACK *Stack)
+			if(!StackAtomicCompareAndSwap(&Slot->Offer, (CONCURRENT_STACK_NODE*)NULL, StackNode))
+			{
+				StackEliminationCollided(Record);
+
+				return (BOOL)FALSE;
+			}
+
+			for(i = (UINT32)0; i < (UINT32)STACK_ELIMINATION_SPIN; i++)
+			{
+				if(StackAtomicLoad(&Slot->Offer) == &StackEliminationTaken)
+					break;
+			}
+
+			/*
+				Try to take the offer back.  If that fails a pop has taken it,
+				and only we may free the slot up again.
+			*/
+			if(i == (UINT32)STACK_ELIMINATION_SPIN && StackAtomicCompareAndSwap(&Slot->Offer, StackNode, (CONCURRENT_STACK_NODE*)NULL))
+			{
+				StackEliminationMissed(Record);
+
+				return (BOOL)FALSE;
+			}
+
+			StackAtomicStore(&Slot->Offer, (CONCURRENT_STACK_NODE*)NULL);
+
+			return (BOOL)TRUE;
+		}
+
+		/*
+			Looks in an elimination slot for a push to pair up with.  Returns
+			TRUE and the pushed data in *Data if one was taken.
+		*/
+		static BOOL StackEliminationPop(CONCURRENT_STACK *Stack, STACK_HAZARD_RECORD *Record, void **Data)
+		{
+			STACK_ELIMINATION_SLOT *Slot;
+			CONCURRENT_STACK_NODE *Offer;
+
+			Slot = (STACK_ELIMINATION_SLOT*)StackGetEliminationSlot(Stack, Record);
+			Offer = (CONCURRENT_STACK_NODE*)StackAtomicLoad(&Slot->Offer);
+
+			if(Offer == (CONCURRENT_STACK_NODE*)NULL || Offer == &StackEliminationTaken)
+			{
+				StackEliminationMissed(Record);
+
+				return (BOOL)FALSE;
+			}
+
+			if(!StackAtomicCompareAndSwap(&Slot->Offer, Offer, &StackEliminationTaken))
+			{
+				StackEliminationCollided(Record);
+
+				return (BOOL)FALSE;
+			}
+
+			/*
+				The node was never on the CONCURRENT_STACK, but it goes through
+				the retired list like any other popped node.
+			*/
+			*Data = (void*)(Offer->Data);
+
+			StackRetireNode(Record, Offer);
+
+			return (BOOL)TRUE;
+		}
+	#endif // end of USING_STACK_ELIMINATION_BACKOFF
+
+	CONCURRENT_STACK *CreateConcurrentStack(CONCURRENT_STACK *Stack, void (*CustomFreeMethod)(void *Data))
 	{
-		#if (STACK_SAFE_MODE == 1)
-			if(StackIsNull(Stack))
-				return (void*)NULL;
-		
-			if(StackIsEmpty(Stack))
-				return (void*)NULL;
-		#endif // end of STACK_SAFE_MODE
+		/*
+			If Stack is equal to (CONCURRENT_STACK*)NULL then the user wants to
+			create a new CONCURRENT_STACK in memory
+		*/
+		if(Stack == (CONCURRENT_STACK*)NULL)
+		{
+			if((Stack = (CONCURRENT_STACK*)StackMemAlloc(sizeof(CONCURRENT_STACK))) == (CONCURRENT_STACK*)NULL)
+			{
+				return (CONCURRENT_STACK*)NULL;
+			}
+		}
 
 		/*
-			Return the data pointed to by the first STACK_NODE.
+			Initialize the CONCURRENT_STACK to it's defualt values.  No
+			other thread can be using it yet.
 		*/
-		return (void*)(Stack->TopOfStack->Data);
+		Stack->TopOfStack = (CONCURRENT_STACK_NODE*)NULL;
+		Stack->Size = (UINT32)0;
+
+		#if(USING_STACK_DEPENDENT_FREE_METHOD == 1)
+			Stack->StackFreeMethod = (void (*)(void *))CustomFreeMethod;
+		#endif // end of USING_STACK_DEPENDENT_FREE_METHOD
+
+		#if (USING_STACK_ELIMINATION_BACKOFF == 1)
+		{
+			UINT32 i;
+
+			Stack->UsingElimination = (BOOL)FALSE;
+
+			for(i = (UINT32)0; i < (UINT32)STACK_ELIMINATION_ARRAY_SIZE; i++)
+				Stack->EliminationArray[i].Offer = (CONCURRENT_STACK_NODE*)NULL;
+		}
+		#endif // end of USING_STACK_ELIMINATION_BACKOFF
+
+		return (CONCURRENT_STACK*)Stack;
 	}
-#endif // end of USING_STACK_PEEK_METHOD
 
-#if (USING_STACK_CLEAR_METHOD == 1)
-	BOOL StackClear(STACK *Stack)
+	#if (USING_STACK_ELIMINATION_BACKOFF == 1)
+		CONCURRENT_STACK *CreateEliminationStack(CONCURRENT_STACK *Stack, void (*CustomFreeMethod)(void *Data))
+		{
+			if((Stack = CreateConcurrentStack(Stack, CustomFreeMethod)) == (CONCURRENT_STACK*)NULL)
+				return (CONCURRENT_STACK*)NULL;
+
+			Stack->UsingElimination = (BOOL)TRUE;
+
+			return (CONCURRENT_STACK*)Stack;
+		}
+	#endif // end of USING_STACK_ELIMINATION_BACKOFF
+
+	BOOL ConcurrentStackPush(CONCURRENT_STACK *Stack, const void *Data)
 	{
-		STACK_NODE *TempStackNode;
-	
+		CONCURRENT_STACK_NODE *TempStackNode;
+
 		#if (STACK_SAFE_MODE == 1)
-			if(StackIsNull(Stack))
+			if(Stack == (CONCURRENT_STACK*)NULL)
 				return (BOOL)FALSE;
-	
-			if(StackIsEmpty(Stack))
-				return (BOOL)TRUE;
 		#endif // end of STACK_SAFE_MODE
 
+		if((TempStackNode = (CONCURRENT_STACK_NODE*)StackAcquireConcurrentNode()) == (CONCURRENT_STACK_NODE*)NULL)
+		{
+			return (BOOL)FALSE;
+		}
+
+		TempStackNode->Data = (void*)Data;
+
 		/*
-			Use TempStackNode as an iterator to go through the STACK.
-			Start off at the beginning of the STACK.
+			Count the node before anyone can pop it, so a pop that gets to
+			it first never takes Size below 0.
 		*/
-		TempStackNode = (STACK_NODE*)(Stack->TopOfStack);
-	
+		StackAtomicAdd(&Stack->Size, (UINT32)1);
+
 		/*
-			Whie TempStackNode is not NULL then proceed to free it's current
-			STACK_NODE, and the data if required by user with calls to 
-			StackMemDealloc().
+			Keep trying to swing TopOfStack from the top we last saw over to
+			the new node.  Pushing never reads through another thread's node
+			so it doesn't need a Hazard.
 		*/
-		while(TempStackNode != (STACK_NODE*)NULL)
+		for(;;)
 		{
-			Stack->TopOfStack = (STACK_NODE*)(Stack->TopOfStack->Next);
-	
-			#if(USING_STACK_DEPENDENT_FREE_METHOD == 1)
-				if(Stack->StackFreeMethod)
-					Stack->StackFreeMethod((void*)(TempStackNode->Data));
-			#endif // of USING_STACK_DEPENDENT_FREE_METHOD
+			TempStackNode->Next = (CONCURRENT_STACK_NODE*)StackAtomicLoad(&Stack->TopOfStack);
+
+			if(StackAtomicCompareAndSwap(&Stack->TopOfStack, TempStackNode->Next, TempStackNode))
+				break;
 
-			StackMemDealloc((void*)TempStackNode);  // StackMemDealloc defined in StackConfig.h
+			#if (USING_STACK_ELIMINATION_BACKOFF == 1)
+			{
+				STACK_HAZARD_RECORD *Record;
 
-			TempStackNode = (STACK_NODE*)(Stack->TopOfStack); 
+				/*
+					Lost the race for the top, see if a pop in the same spot
+					will take the data directly.  The CONCURRENT_STACK never
+					sees the pair, so the node is taken back out of Size.
+				*/
+				if(Stack->UsingElimination && (Record = (STACK_HAZARD_RECORD*)StackGetHazardRecord()) != (STACK_HAZARD_RECORD*)NULL)
+				{
+					if(StackEliminationPush(Stack, Record, TempStackNode))
+					{
+						StackAtomicAdd(&Stack->Size, (UINT32)-1);
+
+						return (BOOL)TRUE;
+					}
+				}
+			}
+			#endif // end of USING_STACK_ELIMINATION_BACKOFF
 		}
-	
-		/*
-			Set the STACK back to as if it was just newly created.  Stack->TopOfStack
-			was automatically placed to (STACK*)NULL when it did it's last iteration
-			in the above while loop.  So as a result we don't need to set it to 
-			(STACK_NODE*)NULL.  It was already done for us.
-		*/
-		Stack->Size = (UINT32)0;
-	
+
 		return (BOOL)TRUE;
 	}
-#endif // end of USING_STACK_CLEAR_METHOD
 
-#if (USING_STACK_GET_SIZE_METHOD == 1)
-	UINT32 StackGetSize(STACK *Stack)
+	void *ConcurrentStackPop(CONCURRENT_STACK *Stack)
 	{
+		CONCURRENT_STACK_NODE *TempStackNode;
+		STACK_HAZARD_RECORD *Record;
+		void *Data;
+
 		#if (STACK_SAFE_MODE == 1)
-			if(StackIsNull(Stack))
-				return (UINT32)0;
+			if(Stack == (CONCURRENT_STACK*)NULL)
+				return (void*)NULL;
 		#endif // end of STACK_SAFE_MODE
 
+		if((Record = (STACK_HAZARD_RECORD*)StackGetHazardRecord()) == (STACK_HAZARD_RECORD*)NULL)
+			return (void*)NULL;
+
+		for(;;)
+		{
+			if((TempStackNode = (CONCURRENT_STACK_NODE*)StackAtomicLoad(&Stack->TopOfStack)) == (CONCURRENT_STACK_NODE*)NULL)
+			{
+				StackAtomicStore(&Record->Hazard, (CONCURRENT_STACK_NODE*)NULL);
+
+				return (void*)NULL;
+			}
+
+			/*
+				Publish the node as our Hazard and then make sure it is still
+				the top.  If it is, nobody can free it until we clear our 
+				Hazard, so reading its Next is safe.
+			*/
+			StackAtomicStore(&Record->Hazard, TempStackNode);
+
+			if(StackAtomicLoad(&Stack->TopOfStack) != TempStackNode)
+				continue;
+
+			if(StackAtomicCompareAndSwap(&Stack->TopOfStack, TempStackNode, StackAtomicLoad(&TempStackNode->Next)))
+				break;
+
+			#if (USING_STACK_ELIMINATION_BACKOFF == 1)
+				/*
+					Lost the race for the top, see if a push is waiting to hand
+					its data over directly.
+				*/
+				if(Stack->UsingElimination && StackEliminationPop(Stack, Record, &Data))
+				{
+					StackAtomicStore(&Record->Hazard, (CONCURRENT_STACK_NODE*)NULL);
+
+					return (void*)Data;
+				}
+			#endif // end of USING_STACK_ELIMINATION_BACKOFF
+		}
+
+		StackAtomicStore(&Record->Hazard, (CONCURRENT_STACK_NODE*)NULL);
+		StackAtomicAdd(&Stack->Size, (UINT32)-1);
+
 		/*
-			Return the Stack's size.
+			The node is ours now, but other threads might still be reading
+			its Next, so it can't be freed right away.
 		*/
-		return (UINT32)(Stack->Size);
+		Data = (void*)(TempStackNode->Data);
+
+		StackRetireNode(Record, TempStackNode);
+
+		return (void*)Data;
 	}
-#endif // end of USING_STACK_GET_SIZE_METHOD
 
-#if (USING_STACK_GET_SIZE_IN_BYTES_METHOD == 1)
-	UINT32 StackGetSizeInBytes(STACK *Stack, UINT32 DataSizeInBytes)
+	BOOL ConcurrentStackClear(CONCURRENT_STACK *Stack)
 	{
-		UINT32 Size;
-	
+		void *Data;
+
 		#if (STACK_SAFE_MODE == 1)
-			if(StackIsNull(Stack))
-				return (UINT32)0;	
-		#endif // end of STACK_SAFE_MODE	
+			if(Stack == (CONCURRENT_STACK*)NULL)
+				return (BOOL)FALSE;
+		#endif // end of STACK_SAFE_MODE
 
 		/*
-			If the STACK is empty then we just need to return
-			the size of a STACK in bytes.
-		*/
-		if(StackIsEmpty(Stack))
-			return (UINT32)sizeof(STACK);
-	
-		/*
-			Start off with the size of a STACK in bytes.
-		*/
-		Size = (UINT32)sizeof(STACK);
-	
-		/*
-			If the user passed in a value for DataSizeInBytes then use this value
-			to calculate the size of the STACK.  Otherwise we just use the number
-			of STACK_NODE's multiplied by the size of the STACK.
+			Pop until the CONCURRENT_STACK is empty, freeing the data of each
+			node along the way if the user supplied a method for it.  Other
+			threads can keep pushing and popping while this runs.
 		*/
-		if(DataSizeInBytes)
-		{
-			Size += (UINT32)((Stack->Size) * (DataSizeInBytes + (UINT32)sizeof(STACK_NODE)));
-		}
-		else
+		while(StackAtomicLoad(&Stack->TopOfStack) != (CONCURRENT_STACK_NODE*)NULL)
 		{
-			Size += (UINT32)((Stack->Size) * (UINT32)sizeof(STACK_NODE));
+			Data = ConcurrentStackPop(Stack);
+
+			#if(USING_STACK_DEPENDENT_FREE_METHOD == 1)
+				if(Stack->StackFreeMethod && Data)
+					Stack->StackFreeMethod((void*)Data);
+			#endif // end of USING_STACK_DEPENDENT_FREE_METHOD
 		}
-	
-		return (UINT32)Size;
+
+		return (BOOL)TRUE;
 	}
-#endif // end of USING_STACK_GET_SIZE_IN_BYTES_METHOD
+
+	UINT32 ConcurrentStackGetSize(CONCURRENT_STACK *Stack)
+	{
+		#if (STACK_SAFE_MODE == 1)
+			if(Stack == (CONCURRENT_STACK*)NULL)
+				return (UINT32)0;
+		#endif // end of STACK_SAFE_MODE
+
+		return (UINT32)StackAtomicLoad(&Stack->Size);
+	}
+
+	void ConcurrentStackReleaseThread(void)
+	{
+		STACK_HAZARD_RECORD *Record;
+
+		if((Record = StackThreadHazardRecord) == (STACK_HAZARD_RECORD*)NULL)
+			return;
+
+		/*
+			Free whatever can be freed now.  Any nodes still in use by other
+			threads stay in the record for the next thread that takes it over.
+		*/
+		StackAtomicStore(&Record->Hazard, (CONCURRENT_STACK_NODE*)NULL);
+		StackScanRetiredNodes(Record);
+
+		#if (USING_STACK_NODE_MAGAZINES == 1)
+			StackDrainThreadMagazine();
+		#endif // end of USING_STACK_NODE_MAGAZINES
+
+		StackThreadHazardRecord = (STACK_HAZARD_RECORD*)NULL;
+		StackAtomicStore(&Record->Active, (UINT32)0);
+	}
+#endif // end of USING_STACK_CONCURRENT_METHODS
 
 #if (USING_STACK_GET_LIBRARY_VERSION == 1)
 
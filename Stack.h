@@ -26,6 +26,10 @@
 #include "StackConfig.h"
 #include "StackObject.h"
 
+#ifdef __cplusplus
+	extern "C" {
+#endif // end of __cplusplus
+
 /*
 	Function: STACK *CreateStack(STACK *Stack)
 
@@ -44,7 +48,10 @@
 
 	Description: Creates a new STACK in memory.
 
-	Notes: None
+	Notes: With USING_STACK_INLINE_BUFFER defined as 1 the first 
+	STACK_NODE's of the STACK are kept inside of it, so a STACK made in
+	the caller's memory needs no StackMemAlloc() while it is shallow.
+	Such a STACK must not be copied or moved after its first push.
 */
 /**
 		* @brief Initializes a STACK, and can create a STACK.
@@ -54,12 +61,267 @@
 		a piece of data that a STACK_NODE points to.
 		* @return *STACK - The address of the STACK in memory.  If a STACK could
 		not be allocated, returns a NULL STACK pointer.
-		* @note None
+		* @note With USING_STACK_INLINE_BUFFER a STACK must not be copied or moved after its first push.
 		* @sa StackMemAlloc()
 		* @since v1.0
 */
 STACK *CreateStack(STACK *Stack, void (*CustomFreeMethod)(void *Data));
 
+/*
+	Function: STACK *CreateStackWithAllocator(STACK *Stack, void (*CustomFreeMethod)(void *Data), const STACK_ALLOCATOR *Allocator)
+
+	Parameters:
+		STACK *Stack - The address at which the STACK will be inititalized.
+		If NULL is passed in then this method will create a STACK out of a
+		the heap with a call to StackMemAlloc()(User Supplied Define).
+
+		void(*CustomFreeMethod)(void *Data) - A pointer to a method that the
+		user defines.  Each time a STACK_NODE is deleted this method will
+		be called to delete the data at the STACK_NODE.
+
+		const STACK_ALLOCATOR *Allocator - Where the STACK gets the memory
+		for its STACK_NODE's from.  It is copied into the STACK.
+
+	Returns:
+		STACK* - The address at which the newly initialized STACK resides
+		in memory.  If a new STACK could not be created or Allocator is
+		missing a method then (STACK*)NULL is returned.
+
+	Description: Creates a new STACK in memory that gets its STACK_NODE's,
+	cached STACK_NODE's, arena blocks and spill buffers from Allocator
+	instead of StackMemAlloc().  The STACK itself still comes from
+	StackMemAlloc() when Stack is NULL.  StackAllocators.h has allocators
+	for memory on a NUMA node and for memory local to each thread.
+
+	Notes: USING_STACK_ALLOCATORS in StackConfig.h must be defined as 1 to use method.
+*/
+/**
+		* @brief Initializes a STACK that gets its memory from Allocator, and can create a STACK.
+		* @param *Stack- A pointer to an already allocate STACK or a NULL STACK
+		pointer to create a STACK from StackMemAlloc().
+		* @param *CustomFreeMethod - A method called by the STACK Library to delete
+		a piece of data that a STACK_NODE points to.
+		* @param *Allocator - The STACK_ALLOCATOR the STACK gets its STACK_NODE's from.
+		* @return *STACK - The address of the STACK in memory.  If a STACK could
+		not be allocated, returns a NULL STACK pointer.
+		* @note USING_STACK_ALLOCATORS in StackConfig.h must be defined as 1 to use method.
+		* @sa CreateStack(), StackSetAllocator()
+		* @since v1.05
+*/
+#if (USING_STACK_ALLOCATORS == 1)
+	STACK *CreateStackWithAllocator(STACK *Stack, void (*CustomFreeMethod)(void *Data), const STACK_ALLOCATOR *Allocator);
+#endif // end of USING_STACK_ALLOCATORS
+
+/*
+	Function: BOOL StackSetAllocator(STACK *Stack, const STACK_ALLOCATOR *Allocator)
+
+	Parameters:
+		STACK *Stack - The STACK to give a new allocator.
+		const STACK_ALLOCATOR *Allocator - The allocator to copy into the STACK.
+
+	Returns:
+		BOOL - TRUE if the STACK now uses Allocator, FALSE if the STACK
+		still holds memory from its old allocator or Allocator is missing
+		a method.
+
+	Description: Changes where a STACK gets its STACK_NODE's from.  The
+	STACK must hold no STACK_NODE's, cached STACK_NODE's or arena blocks,
+	since those have to go back to the allocator they came from.
+
+	Notes: USING_STACK_ALLOCATORS in StackConfig.h must be defined as 1 to use method.
+*/
+/**
+		* @brief Changes the STACK_ALLOCATOR of an empty STACK.
+		* @param *Stack - The STACK to change.
+		* @param *Allocator - The STACK_ALLOCATOR to use from now on.
+		* @return BOOL - TRUE if successful, FALSE otherwise.
+		* @note USING_STACK_ALLOCATORS in StackConfig.h must be defined as 1 to use method.
+		* @sa CreateStackWithAllocator()
+		* @since v1.05
+*/
+#if (USING_STACK_ALLOCATORS == 1)
+	BOOL StackSetAllocator(STACK *Stack, const STACK_ALLOCATOR *Allocator);
+#endif // end of USING_STACK_ALLOCATORS
+
+/*
+	Function: STACK *CreateChunkedStack(STACK *Stack, void (*CustomFreeMethod)(void *Data), UINT32 ElementsPerNode)
+
+	Parameters: 
+		STACK *Stack - The address at which the STACK will be inititalized.
+		If NULL is passed in then this method will create a STACK out of a
+		the heap with a call to StackMemAlloc()(User Supplied Define).
+
+		void(*CustomFreeMethod)(void *Data) - A pointer to a method that the
+		user defines.  Each time a piece of data is deleted out of the STACK
+		this method will be called to delete it.
+
+		UINT32 ElementsPerNode - The number of data pointers each STACK_NODE
+		of the STACK will hold.
+
+	Returns:
+		STACK* - The address at which the newly initialized STACK resides
+		in memory.  If a new STACK could not be created or ElementsPerNode
+		is 0 then (STACK*)NULL is returned.
+
+	Description: Creates a new STACK in memory whose STACK_NODE's each hold
+	a block of ElementsPerNode data pointers.  A new STACK_NODE is only 
+	allocated once the top one is full, so a STACK of N items uses about
+	N / ElementsPerNode STACK_NODE's.  CreateStack() does the same thing with
+	STACK_DEFAULT_ELEMENTS_PER_NODE.
+
+	Notes: USING_STACK_CHUNKED_STORAGE in StackConfig.h must be defined as 1 to use method.
+*/
+/**
+		* @brief Initializes a STACK whose STACK_NODE's hold ElementsPerNode items each, and can create a STACK.
+		* @param *Stack- A pointer to an already allocate STACK or a NULL STACK 
+		pointer to create a STACK from StackMemAlloc().
+		* @param *CustomFreeMethod - A method called by the STACK Library to delete
+		a piece of data stored in the STACK.
+		* @param ElementsPerNode - The number of data pointers each STACK_NODE holds.
+		* @return *STACK - The address of the STACK in memory.  If a STACK could
+		not be allocated, returns a NULL STACK pointer.
+		* @note USING_STACK_CHUNKED_STORAGE in StackConfig.h must be defined as 1 to use method.
+		* @sa CreateStack(), StackMemAlloc()
+		* @since v1.05
+*/
+#if (USING_STACK_CHUNKED_STORAGE == 1)
+	STACK *CreateChunkedStack(STACK *Stack, void (*CustomFreeMethod)(void *Data), UINT32 ElementsPerNode);
+#endif // end of USING_STACK_CHUNKED_STORAGE
+
+/*
+	Function: STACK *CreateValueStack(STACK *Stack, UINT32 ElementSize)
+
+	Parameters: 
+		STACK *Stack - The address at which the STACK will be inititalized.
+		If NULL is passed in then this method will create a STACK out of a
+		the heap with a call to StackMemAlloc()(User Supplied Define).
+
+		UINT32 ElementSize - The size in bytes of each item the STACK will hold.
+
+	Returns:
+		STACK* - The address at which the newly initialized STACK resides
+		in memory.  If a new STACK could not be created or ElementSize is 0
+		then (STACK*)NULL is returned.
+
+	Description: Creates a new STACK in memory that holds copies of fixed
+	size items instead of pointers to them.  Each item is copied into the 
+	STACK_NODE it is pushed into, so pushing it costs no allocation of its
+	own and the caller's buffer can be reused right away.  Use 
+	StackPushValue(), StackPopValue() and StackPeekValue() with it.  
+	StackPeek() returns the address of the top item inside the STACK, which
+	is only good until the next push or pop.
+
+	Notes: StackPush(), StackPop(), StackPushMany() and StackPopMany() fail
+	on a value STACK when STACK_SAFE_MODE is 1.  USING_STACK_VALUE_METHODS 
+	in StackConfig.h must be defined as 1 to use method.
+*/
+/**
+		* @brief Initializes a STACK that stores fixed size items by value, and can create a STACK.
+		* @param *Stack- A pointer to an already allocate STACK or a NULL STACK 
+		pointer to create a STACK from StackMemAlloc().
+		* @param ElementSize - The size in bytes of each item.
+		* @return *STACK - The address of the STACK in memory.  If a STACK could
+		not be allocated, returns a NULL STACK pointer.
+		* @note USING_STACK_VALUE_METHODS in StackConfig.h must be defined as 1 to use method.
+		* @sa StackPushValue(), StackPopValue(), StackPeekValue()
+		* @since v1.05
+*/
+#if (USING_STACK_VALUE_METHODS == 1)
+	STACK *CreateValueStack(STACK *Stack, UINT32 ElementSize);
+#endif // end of USING_STACK_VALUE_METHODS
+
+/*
+	Function: STACK *CreateBoundedStack(STACK *Stack, void (*CustomFreeMethod)(void *Data), void **Buffer, UINT32 Capacity)
+
+	Parameters: 
+		STACK *Stack - The address at which the STACK will be inititalized.
+		If NULL is passed in then this method will create a STACK out of a
+		the heap with a call to StackMemAlloc()(User Supplied Define).
+
+		void(*CustomFreeMethod)(void *Data) - A pointer to a method that the
+		user defines.  Each time a piece of data is deleted out of the STACK
+		this method will be called to delete it.
+
+		void **Buffer - An array of Capacity data pointers the STACK will keep
+		its data in.  It must stay around for as long as the STACK does.
+
+		UINT32 Capacity - The number of data pointers Buffer has room for.
+
+	Returns:
+		STACK* - The address at which the newly initialized STACK resides
+		in memory.  If a new STACK could not be created, Buffer is NULL or 
+		Capacity is 0 then (STACK*)NULL is returned.
+
+	Description: Creates a new STACK that holds at most Capacity items, all
+	of them in Buffer.  StackPush() on it never calls StackMemAlloc() and 
+	returns FALSE once the STACK is full, and StackPop() never calls 
+	StackMemDealloc().  Pass in an already allocated STACK as well and the
+	STACK can be used where the heap can't, such as in a signal handler.
+
+	Notes: USING_STACK_BOUNDED_METHODS in StackConfig.h must be defined as 1 to use method.
+*/
+/**
+		* @brief Initializes a STACK that keeps its data in a caller supplied buffer, and can create a STACK.
+		* @param *Stack- A pointer to an already allocate STACK or a NULL STACK 
+		pointer to create a STACK from StackMemAlloc().
+		* @param *CustomFreeMethod - A method called by the STACK Library to delete
+		a piece of data stored in the STACK.
+		* @param **Buffer - The array the STACK keeps its data pointers in.
+		* @param Capacity - The number of data pointers Buffer holds.
+		* @return *STACK - The address of the STACK in memory.  If a STACK could
+		not be allocated, returns a NULL STACK pointer.
+		* @note USING_STACK_BOUNDED_METHODS in StackConfig.h must be defined as 1 to use method.
+		* @sa CreateStack(), StackIsFull()
+		* @since v1.05
+*/
+#if (USING_STACK_BOUNDED_METHODS == 1)
+	STACK *CreateBoundedStack(STACK *Stack, void (*CustomFreeMethod)(void *Data), void **Buffer, UINT32 Capacity);
+#endif // end of USING_STACK_BOUNDED_METHODS
+
+/*
+	Function: STACK *StackClone(STACK *Stack, STACK *Clone)
+
+	Parameters: 
+		STACK *Stack - The STACK to clone.
+
+		STACK *Clone - The address at which the clone will be inititalized.
+		If NULL is passed in then this method will create a STACK out of a
+		the heap with a call to StackMemAlloc()(User Supplied Define).
+
+	Returns:
+		STACK* - The address at which the clone resides in memory.  If it
+		could not be created, or Stack is a bounded STACK or a view, then
+		(STACK*)NULL is returned.
+
+	Description: Creates a STACK holding the same items as Stack, in the 
+	same order, in constant time.  The clone shares every STACK_NODE of 
+	Stack, and from then on pushing onto or popping off either STACK 
+	leaves the other as it was.  A STACK_NODE is only freed, and its data
+	handed to the free method, once no STACK holds it anymore.  The clone
+	has the same free method, allocator and element size as Stack.  Clones
+	can be used from different threads, since the STACK_NODE's they share
+	are counted atomically, but each STACK still needs its own locking.
+
+	Notes: Data popped off a STACK while a clone still holds it also still
+	belongs to the clone, so it must not be freed by the caller.
+	USING_STACK_PERSISTENT_METHODS in StackConfig.h must be defined as 1
+	to use method.
+*/
+/**
+		* @brief Creates a STACK that shares all the STACK_NODE's of another.
+		* @param *Stack - The STACK to clone.
+		* @param *Clone - A pointer to an already allocate STACK or a NULL STACK 
+		pointer to create the clone from StackMemAlloc().
+		* @return *STACK - The address of the clone in memory.  If it could
+		not be made, returns a NULL STACK pointer.
+		* @note USING_STACK_PERSISTENT_METHODS in StackConfig.h must be defined as 1 to use method.
+		* @sa CreateStack(), StackClear()
+		* @since v1.05
+*/
+#if (USING_STACK_PERSISTENT_METHODS == 1)
+	STACK *StackClone(STACK *Stack, STACK *Clone);
+#endif // end of USING_STACK_PERSISTENT_METHODS
+
 /*
 	Function: BOOL StackPush(STACK *Stack, const void *Data)
 
@@ -75,7 +337,7 @@ STACK *CreateStack(STACK *Stack, void (*CustomFreeMethod)(void *Data));
 
 	Description: Pushes one item onto the STACK.
 
-	Notes: None.
+	Notes: A STACK made with CreateBoundedStack() returns FALSE when it is full.
 */
 /**
 		* @brief Puts a new STACK_NODE with it's accompanying data on top of the STACK.
@@ -113,219 +375,1464 @@ BOOL StackPush(STACK *Stack, const void *Data);
 		* @return *void - The address in memory of the top STACK_NODE in the 
 		passed in STACK, or (void*)NULL if unsuccessful.  The STACK_NODE 
 		is torn down from memory with StackMemDealloc().
-		* @note This method will free the top STACK_NODE with a call to StackMemDealloc().
+		* @note This method will free the top STACK_NODE with a call to StackMemDealloc(),
+		unless USING_STACK_NODE_CACHE is defined as 1 and the STACK's node cache has room for it.
 		* @sa StackMemDealloc()
 		* @since v1.0
 */
 void *StackPop(STACK *Stack);
 
 /*
-	Function: void *StackPeek(STACK *Stack)
+	Function: BOOL StackPushMany(STACK *Stack, void **Data, UINT32 Count)
 
 	Parameters: 
 		STACK *Stack - The address at which the STACK resides in memory.
+		void **Data - An array of the Count pieces of data to push.
+		UINT32 Count - The number of pieces of data in Data.
 
 	Returns:
-		void* - The data of the next item to be removed from the STACK.  
-		If no items are available or if the Stack is NULL then this 
-		method returns NULL.  The node which holds the returned data still
-		resides in the STACK.
+		BOOL - TRUE if all Count pieces of data were pushed.  FALSE if the
+		STACK was NULL, or there wasn't enough memory for the whole batch, in
+		which case nothing was pushed.
 
-	Description: Returns but does not delete the next piece of data in the
-	STACK.
+	Description: Pushes Data[0] through Data[Count - 1] onto the STACK, 
+	leaving Data[Count - 1] on top, just like calling StackPush() on each
+	one in order.  Every STACK_NODE the batch needs is gotten first and then
+	the whole batch is put on top of the STACK at once, so the STACK is
+	checked and its size updated once per batch instead of once per item.
+	A STACK guarded by a mutex only needs the mutex taken once per batch.
 
-	Notes: USING_STACK_PEEK_METHOD in StackConfig.h must be defined as 1 to use method.
+	Notes: USING_STACK_PUSH_MANY_METHOD in StackConfig.h must be defined as 1 to use method.
 */
 /**
-		* @brief Returns the next set of data on top of the STACK.
+		* @brief Pushes an array of data onto the STACK in one operation.
 		* @param *Stack - The address at which the STACK resides in memory.
-		* @return void* - The address of the next piece of data on top of the STACK, 
-		or (void*)NULL if unsuccessful.
-		* @note This method will return but not remove from the STACK, the next 
-		set of data on top of the STACK.  USING_STACK_PEEK_METHOD in StackConfig.h must be defined as 1 to use method.
-		* @sa None
-		* @since v1.0
+		* @param **Data - The array of data to push, the last one ends up on top.
+		* @param Count - The number of pieces of data in Data.
+		* @return BOOL - TRUE if the whole batch was pushed.  FALSE if none of 
+		it was.
+		* @note USING_STACK_PUSH_MANY_METHOD in StackConfig.h must be defined as 1 to use method.
+		* @sa StackPush(), StackPopMany(), StackMemAlloc()
+		* @since v1.05
 */
-#if (USING_STACK_PEEK_METHOD == 1)
-	void *StackPeek(STACK *Stack);
-#endif // end of USING_STACK_PEEK_METHOD
+#if (USING_STACK_PUSH_MANY_METHOD == 1)
+	BOOL StackPushMany(STACK *Stack, void **Data, UINT32 Count);
+#endif // end of USING_STACK_PUSH_MANY_METHOD
 
 /*
-	Function: BOOL StackClear(STACK *Stack)
+	Function: UINT32 StackPopMany(STACK *Stack, void **Data, UINT32 Count)
 
 	Parameters: 
 		STACK *Stack - The address at which the STACK resides in memory.
+		void **Data - An array with room for Count pieces of data.
+		UINT32 Count - The most pieces of data to pop.
 
 	Returns:
-		BOOL - TRUE if the STACK was successfully torn down out of memory, or it
-			   the Stack had a size of 0.
-		FALSE - If a NULL referenced STACK was passed in.
+		UINT32 - The number of pieces of data popped into Data.  This is less
+		than Count if the STACK ran out.  0 if the STACK or Data was NULL.
 
-	Description: This method will free up all the memory used up by the
-	STACK_NODE's within the STACK.  It will free all nodes with a call
-	to StackMemDealloc(), and will only free the data of a node if a method
-	was supplied at the stack's creation.  The STACK structure will still
-	exist.
+	Description: Pops up to Count items from the STACK into Data, top of the
+	STACK first, just like calling StackPop() that many times.  The size of
+	the STACK is updated once for the whole batch.
 
-	Notes: USING_STACK_CLEAR_METHOD in StackConfig.h must be defined as 1 to use method.
+	Notes: USING_STACK_POP_MANY_METHOD in StackConfig.h must be defined as 1 to use method.
 */
 /**
-		* @brief Frees from memory all of a STACK's nodes and data(optional).
+		* @brief Pops up to Count items from the STACK into an array in one operation.
 		* @param *Stack - The address at which the STACK resides in memory.
-		* @return BOOL - TRUE if all the STACK_NODE's and data was successfully freed,
-		FALSE otherwise.
-		* @note This method will free up all the memory used up by the
-		STACK_NODE's within the STACK.  It will free all nodes with a call
-		to StackMemDealloc(), and will only free the data of a node if a method
-		was supplied at the stack's creation.  The STACK structure will still
-		exist.  USING_STACK_CLEAR_METHOD in StackConfig.h must be defined as 1 to use method, and
-		USING_STACK_DEPENDENT_FREE_METHOD must be defined as 1 to enable the custion free method.
-		* @sa StackMemDealloc()
-		* @since v1.0
+		* @param **Data - The array to fill, top of the STACK first.
+		* @param Count - The most pieces of data to pop.
+		* @return UINT32 - The number of pieces of data popped.
+		* @note USING_STACK_POP_MANY_METHOD in StackConfig.h must be defined as 1 to use method.
+		* @sa StackPop(), StackPushMany(), StackMemDealloc()
+		* @since v1.05
 */
-	// add in a method for deleting data
-#if (USING_STACK_CLEAR_METHOD == 1)
-	BOOL StackClear(STACK *Stack);
-#endif // end of USING_STACK_CLEAR_METHOD
+#if (USING_STACK_POP_MANY_METHOD == 1)
+	UINT32 StackPopMany(STACK *Stack, void **Data, UINT32 Count);
+#endif // end of USING_STACK_POP_MANY_METHOD
 
 /*
-	Function: UINT32 StackGetSize(STACK *Stack)
+	Function: BOOL StackSplice(STACK *Destination, STACK *Source)
 
 	Parameters: 
-		STACK *Stack - The address at which the STACK resides in memory.
+		STACK *Destination - The STACK the items are moved onto.
+		STACK *Source - The STACK the items are taken from.
 
 	Returns:
-		UINT32 - The number of elements currently found in the STACK 
-		passed in.  If the STACK referenced is NULL then this method will 
-		return 0.
+		BOOL - TRUE if every item of Source was moved onto Destination.
+		FALSE - If either STACK was NULL, they are the same STACK, or their
+		STACK_NODE's can't be moved between them.
 
-	Description: Returns the size of the referenced STACK.
+	Description: Moves everything in Source on top of Destination in 
+	constant time, keeping its order, so the top of Source becomes the top
+	of Destination.  No STACK_NODE is allocated or freed and no data is
+	copied, the STACK_NODE's of Source are just linked in on top.  Source
+	is left empty.  Both STACK's must have the same free method, the same
+	STACK_ALLOCATOR, element size and elements per STACK_NODE, and neither
+	may be a bounded STACK or a view.
 
-	Notes: USING_STACK_GET_SIZE_METHOD in StackConfig.h must be defined as 1 to use method.
+	Notes: With chunked storage the top STACK_NODE of Source may not be full,
+	and its free slots go unused until the items above it are popped.
+	USING_STACK_SPLICE_METHODS in StackConfig.h must be defined as 1 to use
+	method.
 */
 /**
-		* @brief Will return the number of STACK_NODES within a STACK.
-		* @param *Stack - The address at which the STACK resides in memory.
-		* @return UINT32 - The number of STACK_NODE's in the STACK.  
-		If the Stack is eqaul to (STACK*)NULL then 0 is returned.
-		* @note USING_STACK_GET_SIZE_METHOD in StackConfig.h must be defined as 1 to use method.
-		* @sa None
-		* @since v1.0
+		* @brief Moves everything in one STACK on top of another in constant time.
+		* @param *Destination - The STACK the items are moved onto.
+		* @param *Source - The STACK the items are taken from, left empty.
+		* @return BOOL - TRUE if successful, FALSE otherwise.
+		* @note USING_STACK_SPLICE_METHODS in StackConfig.h must be defined as 1 to use method.
+		* @sa StackSplitTop(), StackPushMany()
+		* @since v1.05
 */
-#if (USING_STACK_GET_SIZE_METHOD == 1)
-	UINT32 StackGetSize(STACK *Stack);
-#endif //end of USING_STACK_GET_SIZE
+#if (USING_STACK_SPLICE_METHODS == 1)
+	BOOL StackSplice(STACK *Destination, STACK *Source);
+#endif // end of USING_STACK_SPLICE_METHODS
 
 /*
-	Function: UINT32 StackGetSizeInBytes(STACK *Stack, UINT32 DataSizeInBytes)
+	Function: STACK *StackSplitTop(STACK *Stack, UINT32 Count, STACK *Top)
 
 	Parameters: 
-		STACK *Stack - The address at which the STACK resides in memory.
-		UINT32 DataSizeInBytes - The size in bytes of the data being stored
-								 at each STACK_NODE for the referenced STACK.
+		STACK *Stack - The STACK to take the items from.
+
+		UINT32 Count - The number of items to take off the top of Stack.
+
+		STACK *Top - The address at which the STACK of the taken items will
+		be inititalized.  If NULL is passed in then this method will create
+		a STACK out of the heap with a call to StackMemAlloc()(User Supplied
+		Define).
 
 	Returns:
-		UINT32 - The size in bytes that the entire STACK Data Structure takes up.  This
-		takes into account the size of each STACK_NODE within the STACK, the size of a 
-		STACK and the size of each data element a STACK_NODE is pointing to.  If the user
-		is not pointing to anything with the STACK_NODES's then DataSizeInBytes should be 
-		set to 0.  If the STACK referenced is NULL then this method will return 0.
+		STACK* - The address at which the STACK of the taken items resides in
+		memory.  (STACK*)NULL if Stack was NULL, holds fewer than Count items,
+		is a bounded STACK or a view, or memory ran out, in which case Stack
+		is left as it was.
 
-	Description: Returns the size of the referenced STACK in bytes.
+	Description: Moves the top Count items of Stack into a new STACK, in the
+	same order, by handing over the STACK_NODE's they are in.  Finding the 
+	cut walks the STACK_NODE's holding the Count items, but none of them is
+	allocated, freed or copied, except with chunked storage when the cut
+	falls inside a STACK_NODE, in which case the items above the cut in 
+	that STACK_NODE are copied into one new STACK_NODE.  The new STACK has
+	the same free method, STACK_ALLOCATOR and layout as Stack, so it can
+	later be spliced back with StackSplice().
 
-	Notes: This method does not take into account how much memory is used to allocate 
-	memory through StackMemAlloc().  USING_STACK_GET_SIZE_IN_BYTES_METHOD in StackConfig.h must be defined as 1 to use method.
+	Notes: USING_STACK_SPLICE_METHODS in StackConfig.h must be defined as 1
+	to use method.
 */
 /**
-		* @brief Returns how much memory in bytes a STACK consumes.
-		* @param *Stack - The address at which the STACK resides in memory.
-		* @param DataSizeInBytes - The size in bytes of the data being stored 
-		at each STACK_NODE for the referenced STACK.  Should be 0 if the data
-		in each STACK_NODE is not used as a pointer.
-		* @return UINT32 - Returns the size of the referenced STACK in bytes.  Will
-		return 0 if unsuccessful.
-		* @note This method will take into account the sizeof STACK, plus
-		the size of each STACK_NODE.  This method will not take into account
-		the amount of memory needed to allocate memory from StackMemAlloc().
-		USING_STACK_GET_SIZE_IN_BYTES_METHOD in StackConfig.h must be defined as 1 to use method.
-		* @sa None
-		* @since v1.0
+		* @brief Moves the top Count items of a STACK into a new STACK without reallocating them.
+		* @param *Stack - The STACK to take the items from.
+		* @param Count - The number of items to take.
+		* @param *Top - A pointer to an already allocate STACK or a NULL STACK 
+		pointer to create one from StackMemAlloc().
+		* @return *STACK - The address of the new STACK in memory.  If it could
+		not be made, returns a NULL STACK pointer.
+		* @note USING_STACK_SPLICE_METHODS in StackConfig.h must be defined as 1 to use method.
+		* @sa StackSplice(), StackPopMany()
+		* @since v1.05
 */
-#if (USING_STACK_GET_SIZE_IN_BYTES_METHOD == 1)
-	UINT32 StackGetSizeInBytes(STACK *Stack, UINT32 DataSizeInBytes);
-#endif // end of USING_STACK_GET_SIZE_IN_BYTES_METHOD
+#if (USING_STACK_SPLICE_METHODS == 1)
+	STACK *StackSplitTop(STACK *Stack, UINT32 Count, STACK *Top);
+#endif // end of USING_STACK_SPLICE_METHODS
 
 /*
-	Function: const BYTE *StackGetLibraryVersion(void)
+	Function: BOOL StackPushValue(STACK *Stack, const void *Value)
 
 	Parameters: 
-		None
+		STACK *Stack - The address at which the value STACK resides in memory.
+		const void *Value - The address of the item to copy onto the STACK.
 
 	Returns:
-		const BYTE* - The library version of the Stack Library.  This string is 
-		(BYTE)NULL terminated.
+		BOOL - TRUE if the item was pushed.  FALSE if the STACK or Value was
+		NULL, the STACK wasn't made with CreateValueStack(), or there wasn't
+		enough memory for a new STACK_NODE.
 
-	Description: Returns the version number of the Stack Library.
+	Description: Copies ElementSize bytes from Value onto the top of the STACK.
 
-	Notes: USING_STACK_GET_LIBRARY_VERSION in StackConfig.h must be defined as 1 to use method.
+	Notes: USING_STACK_VALUE_METHODS in StackConfig.h must be defined as 1 to use method.
 */
 /**
-		* @brief Returns the version number of the Stack Library.
-		* @param None
-		* @return const BYTE* - The library version of the Stack Library.
-		* @note This string is (BYTE)NULL terminated.   USING_STACK_GET_LIBRARY_VERSION in StackConfig.h must be defined as 1 to use method.
-		* @sa None
-		* @since v1.03
+		* @brief Copies an item onto the top of a value STACK.
+		* @param *Stack - The address at which the STACK resides in memory.
+		* @param *Value - The item to copy in.
+		* @return BOOL - TRUE if successful, FALSE otherwise.
+		* @note USING_STACK_VALUE_METHODS in StackConfig.h must be defined as 1 to use method.
+		* @sa CreateValueStack(), StackPopValue()
+		* @since v1.05
 */
-#if (USING_STACK_GET_LIBRARY_VERSION == 1)
-	const BYTE *StackGetLibraryVersion(void);
-#endif // end of USING_STACK_GET_LIBRARY_VERSION
+#if (USING_STACK_VALUE_METHODS == 1)
+	BOOL StackPushValue(STACK *Stack, const void *Value);
+#endif // end of USING_STACK_VALUE_METHODS
 
 /*
-	Macro: UINT32 StackGetSizeOfNodeInBytes(UINT32 DataSizeInBytes)
+	Function: BOOL StackPopValue(STACK *Stack, void *Value)
 
 	Parameters: 
-		UINT32 DataSizeInBytes - The size in bytes of the data being stored in a STACK.
+		STACK *Stack - The address at which the value STACK resides in memory.
+		void *Value - Where to copy the top item to.  Must have room for
+		ElementSize bytes.
 
 	Returns:
-		UINT32 - The size in bytes that the STACK_NODE takes up with it's accompaning
-		data.
+		BOOL - TRUE if an item was popped into Value.  FALSE if the STACK 
+		was empty, the STACK or Value was NULL, or the STACK wasn't made
+		with CreateValueStack().
 
-	Description: Returns the size of a STACK_NODE and it's data in bytes.
+	Description: Copies the top item of the STACK into Value and removes it
+	from the STACK.
 
-	Notes: This method does not take into account how much memory is used to allocate 
-	memory through StackMemAlloc().
+	Notes: USING_STACK_VALUE_METHODS in StackConfig.h must be defined as 1 to use method.
 */
-#define StackGetSizeOfNodeInBytes(Size)			(UINT32)(Size + sizeof(STACK_NODE))
+/**
+		* @brief Removes the top item of a value STACK, copying it out.
+		* @param *Stack - The address at which the STACK resides in memory.
+		* @param *Value - Where the item is copied to.
+		* @return BOOL - TRUE if successful, FALSE otherwise.
+		* @note USING_STACK_VALUE_METHODS in StackConfig.h must be defined as 1 to use method.
+		* @sa CreateValueStack(), StackPushValue()
+		* @since v1.05
+*/
+#if (USING_STACK_VALUE_METHODS == 1)
+	BOOL StackPopValue(STACK *Stack, void *Value);
+#endif // end of USING_STACK_VALUE_METHODS
 
 /*
-	Macro: BOOL StackIsNull(STACK *Stack)
+	Function: BOOL StackPeekValue(STACK *Stack, void *Value)
 
 	Parameters: 
-		STACK *Stack - The STACK to check if it's NULL or not.
+		STACK *Stack - The address at which the value STACK resides in memory.
+		void *Value - Where to copy the top item to.  Must have room for
+		ElementSize bytes.
 
 	Returns:
-		BOOL - TRUE if the STACK is NULL, FALSE otherwise.
+		BOOL - TRUE if the top item was copied into Value.  FALSE if the 
+		STACK was empty, the STACK or Value was NULL, or the STACK wasn't
+		made with CreateValueStack().
 
-	Description: Checks to see if a STACK is NULL or not.
+	Description: Copies the top item of the STACK into Value, leaving it on
+	the STACK.
 
-	Notes: None
+	Notes: USING_STACK_VALUE_METHODS in StackConfig.h must be defined as 1 to use method.
 */
-#define StackIsNull(Stack)						(Stack == (STACK*)NULL)
+/**
+		* @brief Copies out the top item of a value STACK without removing it.
+		* @param *Stack - The address at which the STACK resides in memory.
+		* @param *Value - Where the item is copied to.
+		* @return BOOL - TRUE if successful, FALSE otherwise.
+		* @note USING_STACK_VALUE_METHODS in StackConfig.h must be defined as 1 to use method.
+		* @sa CreateValueStack(), StackPeek()
+		* @since v1.05
+*/
+#if (USING_STACK_VALUE_METHODS == 1)
+	BOOL StackPeekValue(STACK *Stack, void *Value);
+#endif // end of USING_STACK_VALUE_METHODS
 
 /*
-	Macro: BOOL StackIsEmpty(STACK *Stack)
+	Function: void *StackPeek(STACK *Stack)
 
 	Parameters: 
-		STACK *Stack - The STACK to check if it's empty or not.
+		STACK *Stack - The address at which the STACK resides in memory.
 
 	Returns:
-		BOOL - TRUE if the STACK is empty, FALSE otherwise.
+		void* - The data of the next item to be removed from the STACK.  
+		If no items are available or if the Stack is NULL then this 
+		method returns NULL.  The node which holds the returned data still
+		resides in the STACK.
 
-	Description: Checks to see if the STACK is empty.
+	Description: Returns but does not delete the next piece of data in the
+	STACK.
 
-	Notes: None
+	Notes: USING_STACK_PEEK_METHOD in StackConfig.h must be defined as 1 to use method.
 */
-#define StackIsEmpty(Stack)						(Stack->Size == (UINT32)0)
+/**
+		* @brief Returns the next set of data on top of the STACK.
+		* @param *Stack - The address at which the STACK resides in memory.
+		* @return void* - The address of the next piece of data on top of the STACK, 
+		or (void*)NULL if unsuccessful.
+		* @note This method will return but not remove from the STACK, the next 
+		set of data on top of the STACK.  USING_STACK_PEEK_METHOD in StackConfig.h must be defined as 1 to use method.
+		* @sa None
+		* @since v1.0
+*/
+#if (USING_STACK_PEEK_METHOD == 1)
+	void *StackPeek(STACK *Stack);
+#endif // end of USING_STACK_PEEK_METHOD
+
+/*
+	Returned by StackIndexOf() when the data isn't in the STACK.
+*/
+#if (USING_STACK_SEARCH_METHODS == 1)
+	#define STACK_NOT_FOUND							(UINT32)0xFFFFFFFF
+#endif // end of USING_STACK_SEARCH_METHODS
+
+/*
+	Function: BOOL StackForEach(STACK *Stack, BOOL (*Method)(void *Data, void *Context), void *Context)
+
+	Parameters: 
+		STACK *Stack - The address at which the STACK resides in memory.
+
+		BOOL (*Method)(void *Data, void *Context) - Called with each item
+		of the STACK, top first, and Context.  Data is what StackPeek()
+		would return for the item.  Returning FALSE stops the walk.
+
+		void *Context - Passed to Method as is.
+
+	Returns:
+		BOOL - TRUE if the walk finished or Method stopped it, FALSE if the
+		STACK or Method was NULL or the spilled items couldn't be read.
+
+	Description: Hands every item of the STACK to Method without removing
+	any of them.  Spilled items are read from the spill file a buffer at
+	a time, and the address handed out for a spilled item of a value 
+	STACK is only good until Method returns.  Method must not change the
+	STACK.
+
+	Notes: USING_STACK_SEARCH_METHODS in StackConfig.h must be defined as 1 to use method.
+*/
+/**
+		* @brief Calls Method with every item of the STACK, top first.
+		* @param *Stack - The address at which the STACK resides in memory.
+		* @param *Method - Called with each item, returns FALSE to stop.
+		* @param *Context - Passed to Method.
+		* @return BOOL - TRUE if successful, FALSE otherwise.
+		* @note USING_STACK_SEARCH_METHODS in StackConfig.h must be defined as 1 to use method.
+		* @sa StackIndexOf(), StackPeekAt()
+		* @since v1.05
+*/
+#if (USING_STACK_SEARCH_METHODS == 1)
+	BOOL StackForEach(STACK *Stack, BOOL (*Method)(void *Data, void *Context), void *Context);
+#endif // end of USING_STACK_SEARCH_METHODS
+
+/*
+	Function: UINT32 StackIndexOf(STACK *Stack, const void *Data)
+
+	Parameters: 
+		STACK *Stack - The address at which the STACK resides in memory.
+
+		const void *Data - The data pointer to look for, or for a value 
+		STACK the address of a value to compare each item against.
+
+	Returns:
+		UINT32 - How far from the top of the STACK the item nearest the
+		top that is equal to Data is, 0 being the top.  STACK_NOT_FOUND if
+		no item is equal to Data.
+
+	Description: Finds Data in the STACK without removing anything.  Data
+	pointers are compared for equality, several per instruction over the
+	slots of a chunked or bounded STACK and its spilled items when
+	USING_STACK_SIMD_SEARCH is 1, so chunked storage is much faster to
+	search than a STACK_NODE per item.  The items of a value STACK are 
+	compared with memcmp().
+
+	Notes: USING_STACK_SEARCH_METHODS in StackConfig.h must be defined as 1 to use method.
+*/
+/**
+		* @brief Returns the depth of the topmost item equal to Data.
+		* @param *Stack - The address at which the STACK resides in memory.
+		* @param *Data - The data pointer, or address of the value, to find.
+		* @return UINT32 - The depth of the item, 0 being the top, or STACK_NOT_FOUND.
+		* @note USING_STACK_SEARCH_METHODS in StackConfig.h must be defined as 1 to use method.
+		* @sa StackContains(), StackPeekAt()
+		* @since v1.05
+*/
+#if (USING_STACK_SEARCH_METHODS == 1)
+	UINT32 StackIndexOf(STACK *Stack, const void *Data);
+#endif // end of USING_STACK_SEARCH_METHODS
+
+/*
+	Function: BOOL StackContains(STACK *Stack, const void *Data)
+
+	Parameters: 
+		STACK *Stack - The address at which the STACK resides in memory.
+
+		const void *Data - The data pointer to look for, or for a value 
+		STACK the address of a value to compare each item against.
+
+	Returns:
+		BOOL - TRUE if an item of the STACK is equal to Data, FALSE
+		otherwise.
+
+	Description: Returns whether StackIndexOf() would find Data.
+
+	Notes: USING_STACK_SEARCH_METHODS in StackConfig.h must be defined as 1 to use method.
+*/
+/**
+		* @brief Returns whether an item of the STACK is equal to Data.
+		* @param *Stack - The address at which the STACK resides in memory.
+		* @param *Data - The data pointer, or address of the value, to find.
+		* @return BOOL - TRUE if found, FALSE otherwise.
+		* @note USING_STACK_SEARCH_METHODS in StackConfig.h must be defined as 1 to use method.
+		* @sa StackIndexOf()
+		* @since v1.05
+*/
+#if (USING_STACK_SEARCH_METHODS == 1)
+	BOOL StackContains(STACK *Stack, const void *Data);
+#endif // end of USING_STACK_SEARCH_METHODS
+
+/*
+	Function: void *StackPeekAt(STACK *Stack, UINT32 Depth)
+
+	Parameters: 
+		STACK *Stack - The address at which the STACK resides in memory.
+
+		UINT32 Depth - How far from the top of the STACK the item is, 0
+		being the top.
+
+	Returns:
+		void* - What StackPeek() would return for the item.  NULL if the 
+		STACK isn't that deep, or the item is a spilled item of a value
+		STACK.
+
+	Description: Returns but does not remove the item Depth items down the
+	STACK.  StackPeekAt(Stack, 0) is the same as StackPeek(Stack).
+
+	Notes: USING_STACK_SEARCH_METHODS in StackConfig.h must be defined as 1 to use method.
+*/
+/**
+		* @brief Returns the item Depth items down from the top of the STACK.
+		* @param *Stack - The address at which the STACK resides in memory.
+		* @param Depth - How far down the item is, 0 being the top.
+		* @return void* - The item, or (void*)NULL if unsuccessful.
+		* @note USING_STACK_SEARCH_METHODS in StackConfig.h must be defined as 1 to use method.
+		* @sa StackPeek(), StackIndexOf()
+		* @since v1.05
+*/
+#if (USING_STACK_SEARCH_METHODS == 1)
+	void *StackPeekAt(STACK *Stack, UINT32 Depth);
+#endif // end of USING_STACK_SEARCH_METHODS
+
+/*
+	Function: BOOL StackClear(STACK *Stack)
+
+	Parameters: 
+		STACK *Stack - The address at which the STACK resides in memory.
+
+	Returns:
+		BOOL - TRUE if the STACK was successfully torn down out of memory, or it
+			   the Stack had a size of 0.
+		FALSE - If a NULL referenced STACK was passed in.
+
+	Description: This method will free up all the memory used up by the
+	STACK_NODE's within the STACK.  It will free all nodes with a call
+	to StackMemDealloc(), and will only free the data of a node if a method
+	was supplied at the stack's creation.  The STACK structure will still
+	exist.
+
+	Notes: USING_STACK_CLEAR_METHOD in StackConfig.h must be defined as 1 to use method.
+	If USING_STACK_NODE_CACHE is defined as 1 then the STACK_NODE's are kept in
+	the node cache up to its limit instead, see StackShrink().  If 
+	USING_STACK_NODE_ARENA is defined as 1 the STACK_NODE's are freed a whole 
+	arena block at a time, including the one block a STACK that is popped
+	empty keeps.  If USING_STACK_PARALLEL_FREE is
+	defined as 1 a STACK holding at least STACK_PARALLEL_FREE_THRESHOLD items
+	has its data freed by several threads at once, in no particular order.
+	Those threads are started once and kept for every StackClear() after.
+*/
+/**
+		* @brief Frees from memory all of a STACK's nodes and data(optional).
+		* @param *Stack - The address at which the STACK resides in memory.
+		* @return BOOL - TRUE if all the STACK_NODE's and data was successfully freed,
+		FALSE otherwise.
+		* @note This method will free up all the memory used up by the
+		STACK_NODE's within the STACK.  It will free all nodes with a call
+		to StackMemDealloc(), and will only free the data of a node if a method
+		was supplied at the stack's creation.  The STACK structure will still
+		exist.  USING_STACK_CLEAR_METHOD in StackConfig.h must be defined as 1 to use method, and
+		USING_STACK_DEPENDENT_FREE_METHOD must be defined as 1 to enable the custion free method.
+		* @sa StackMemDealloc()
+		* @since v1.0
+*/
+	// add in a method for deleting data
+#if (USING_STACK_CLEAR_METHOD == 1)
+	BOOL StackClear(STACK *Stack);
+#endif // end of USING_STACK_CLEAR_METHOD
+
+/*
+	Function: BOOL StackMark(STACK *Stack, STACK_MARK *Mark)
+
+	Parameters: 
+		STACK *Stack - The address at which the STACK resides in memory.
+		STACK_MARK *Mark - Filled in with the checkpoint.
+
+	Returns:
+		BOOL - TRUE if Mark was filled in.
+		FALSE - If the STACK or Mark was NULL, or the STACK is a view.
+
+	Description: Takes a checkpoint of the STACK and its node arena, which
+	StackRewind() can later put the STACK back to.  Marks can be nested, 
+	as long as they are rewound innermost first.  Until the mark is 
+	rewound, only the STACK_NODE's carved out of the arena after it are
+	reused.
+
+	Notes: A mark that is never rewound keeps the STACK_NODE's that were
+	free before it from being reused until the STACK is cleared.  Once the
+	STACK has been cleared, emptied, or popped below where it was when the
+	mark was made, StackRewind() turns the mark down, even if the STACK has
+	been pushed back up since.  USING_STACK_MARK_METHODS in StackConfig.h 
+	must be defined as 1 to use method.
+*/
+/**
+		* @brief Takes a checkpoint of a STACK to rewind back to.
+		* @param *Stack - The address at which the STACK resides in memory.
+		* @param *Mark - The STACK_MARK to fill in.
+		* @return BOOL - TRUE if successful, FALSE otherwise.
+		* @note USING_STACK_MARK_METHODS in StackConfig.h must be defined as 1 to use method.
+		* @sa StackRewind()
+		* @since v1.05
+*/
+#if (USING_STACK_MARK_METHODS == 1)
+	BOOL StackMark(STACK *Stack, STACK_MARK *Mark);
+#endif // end of USING_STACK_MARK_METHODS
+
+/*
+	Function: BOOL StackRewind(STACK *Stack, const STACK_MARK *Mark, BOOL FreeData)
+
+	Parameters: 
+		STACK *Stack - The address at which the STACK resides in memory.
+
+		const STACK_MARK *Mark - A checkpoint made with StackMark().
+
+		BOOL FreeData - TRUE to have the STACK's free method called on every 
+		piece of data that is dropped, FALSE to leave the data alone.
+
+	Returns:
+		BOOL - TRUE if the STACK was put back to the mark.
+		FALSE - If the STACK or Mark was NULL, the STACK holds fewer items 
+		than it did at the mark, or the STACK has been cleared, emptied or
+		popped below the mark since it was made.  The STACK is left alone.
+
+	Description: Drops everything pushed onto the STACK since the mark was
+	made, as if each item had been popped.  The STACK's node arena is wound
+	back to where it was, which frees every STACK_NODE above the mark at
+	once and hands back whole any block the arena got since.  No STACK_NODE
+	is visited unless FreeData is TRUE, in which case the dropped data is 
+	freed in one pass, top first, before the STACK_NODE's go back.
+
+	Notes: A mark can be rewound to more than once.  Marks made after the
+	one rewound to are lost.  A mark of an empty STACK can always be rewound
+	to, and hands back all but one block of the arena.  USING_STACK_MARK_METHODS in 
+	StackConfig.h must be defined as 1 to use method.
+*/
+/**
+		* @brief Drops everything pushed onto a STACK since a mark at once.
+		* @param *Stack - The address at which the STACK resides in memory.
+		* @param *Mark - The checkpoint to go back to.
+		* @param FreeData - TRUE to free the dropped data with the STACK's free method.
+		* @return BOOL - TRUE if successful, FALSE otherwise.
+		* @note USING_STACK_MARK_METHODS in StackConfig.h must be defined as 1 to use method.
+		* @sa StackMark(), StackClear()
+		* @since v1.05
+*/
+#if (USING_STACK_MARK_METHODS == 1)
+	BOOL StackRewind(STACK *Stack, const STACK_MARK *Mark, BOOL FreeData);
+#endif // end of USING_STACK_MARK_METHODS
+
+/*
+	Function: BOOL StackGetHugePageCoverage(STACK *Stack, STACK_HUGE_PAGE_COVERAGE *Coverage)
+
+	Parameters: 
+		STACK *Stack - The address at which the STACK resides in memory.
+		STACK_HUGE_PAGE_COVERAGE *Coverage - Filled in with how much of the
+		STACK's node arena is on huge pages.
+
+	Returns:
+		BOOL - TRUE if Coverage was filled in, FALSE if the STACK or Coverage
+		was NULL.
+
+	Description: Adds up the blocks of the STACK's node arena.  Blocks
+	mapped with MAP_HUGETLB are counted in HugeTlbBytes.  When the system
+	had no huge pages set aside the blocks were mapped on a huge page 
+	boundary and advised with MADV_HUGEPAGE instead, and are counted in 
+	AdvisedBytes.  Whatever is left of ArenaBytes is on small pages.  A 
+	STACK that hasn't been pushed onto yet has no blocks.
+
+	Notes: USING_STACK_HUGE_PAGE_ARENA in StackConfig.h must be defined as 1 to use method.
+*/
+/**
+		* @brief Reports how much of the node arena of a STACK is on huge pages.
+		* @param *Stack - The address at which the STACK resides in memory.
+		* @param *Coverage - Where to put the byte counts.
+		* @return BOOL - TRUE if successful, FALSE otherwise.
+		* @note USING_STACK_HUGE_PAGE_ARENA in StackConfig.h must be defined as 1 to use method.
+		* @sa StackGetSizeInBytes()
+		* @since v1.05
+*/
+#if (USING_STACK_HUGE_PAGE_ARENA == 1)
+	BOOL StackGetHugePageCoverage(STACK *Stack, STACK_HUGE_PAGE_COVERAGE *Coverage);
+#endif // end of USING_STACK_HUGE_PAGE_ARENA
+
+/*
+	Function: BOOL StackReserve(STACK *Stack, UINT32 Count)
+
+	Parameters: 
+		STACK *Stack - The address at which the STACK resides in memory.
+		UINT32 Count - The number of STACK_NODE's the node cache should hold.
+
+	Returns:
+		BOOL - TRUE if the STACK's node cache now holds at least Count
+		STACK_NODE's.  FALSE if the STACK was NULL or if StackMemAlloc()
+		ran out of memory.  Any STACK_NODE's allocated before running out
+		stay in the node cache.
+
+	Description: Pre-allocates STACK_NODE's into the STACK's node cache so
+	that the next Count calls to StackPush() do not call StackMemAlloc().
+	If the node cache limit is lower than Count it is raised to Count.
+	With USING_STACK_CHUNKED_STORAGE each STACK_NODE holds ElementsPerNode
+	items, so Count STACK_NODE's cover that many more calls to StackPush().
+
+	Notes: USING_STACK_NODE_CACHE in StackConfig.h must be defined as 1 to use method.
+*/
+/**
+		* @brief Fills the STACK's node cache with at least Count STACK_NODE's.
+		* @param *Stack - The address at which the STACK resides in memory.
+		* @param Count - The number of STACK_NODE's the node cache should hold.
+		* @return BOOL - TRUE if the node cache holds at least Count STACK_NODE's,
+		FALSE otherwise.
+		* @note The node cache limit is raised to Count if it is lower.  
+		USING_STACK_NODE_CACHE in StackConfig.h must be defined as 1 to use method.
+		* @sa StackShrink(), StackSetNodeCacheLimit(), StackMemAlloc()
+		* @since v1.05
+*/
+#if (USING_STACK_NODE_CACHE == 1)
+	BOOL StackReserve(STACK *Stack, UINT32 Count);
+#endif // end of USING_STACK_NODE_CACHE
+
+/*
+	Function: BOOL StackShrink(STACK *Stack)
+
+	Parameters: 
+		STACK *Stack - The address at which the STACK resides in memory.
+
+	Returns:
+		BOOL - TRUE if the node cache was emptied, FALSE if a NULL 
+		referenced STACK was passed in.
+
+	Description: Frees every STACK_NODE held in the STACK's node cache with
+	StackMemDealloc().  The STACK_NODE's still in the STACK are not touched.
+	With USING_STACK_NODE_ARENA an empty STACK hands back the one block of
+	its node arena it kept when it was popped empty instead.
+
+	Notes: This must be called before the memory of a STACK is released, 
+	otherwise the STACK_NODE's in the node cache, or the arena block an 
+	empty STACK keeps, are lost.  StackClear() does the same for the arena.
+	USING_STACK_NODE_CACHE or USING_STACK_NODE_ARENA in StackConfig.h must
+	be defined as 1 to use method.
+*/
+/**
+		* @brief Hands every STACK_NODE in the STACK's node cache back to StackMemDealloc().
+		* @param *Stack - The address at which the STACK resides in memory.
+		* @return BOOL - TRUE if successful, FALSE if the STACK was NULL.
+		* @note Call this before releasing the memory of a STACK.  
+		USING_STACK_NODE_CACHE or USING_STACK_NODE_ARENA in StackConfig.h must be defined as 1 to use method.
+		* @sa StackReserve(), StackClear(), StackMemDealloc()
+		* @since v1.05
+*/
+#if (USING_STACK_NODE_CACHE == 1) || (USING_STACK_NODE_ARENA == 1)
+	BOOL StackShrink(STACK *Stack);
+#endif // end of USING_STACK_NODE_CACHE or USING_STACK_NODE_ARENA
+
+/*
+	Function: BOOL StackSetNodeCacheLimit(STACK *Stack, UINT32 Limit)
+
+	Parameters: 
+		STACK *Stack - The address at which the STACK resides in memory.
+		UINT32 Limit - The most STACK_NODE's the node cache may hold.
+
+	Returns:
+		BOOL - TRUE if the limit was set, FALSE if a NULL referenced STACK
+		was passed in.
+
+	Description: Sets how many popped STACK_NODE's the STACK keeps for reuse.
+	If the node cache currently holds more than Limit STACK_NODE's the extra
+	ones are freed with StackMemDealloc().  A Limit of 0 turns the node cache
+	off for the STACK.
+
+	Notes: A newly created STACK starts with a limit of STACK_NODE_CACHE_DEFAULT_LIMIT.
+	USING_STACK_NODE_CACHE in StackConfig.h must be defined as 1 to use method.
+*/
+/**
+		* @brief Sets the most STACK_NODE's the STACK's node cache may hold.
+		* @param *Stack - The address at which the STACK resides in memory.
+		* @param Limit - The most STACK_NODE's the node cache may hold.
+		* @return BOOL - TRUE if successful, FALSE if the STACK was NULL.
+		* @note STACK_NODE's over the new limit are freed right away.  
+		USING_STACK_NODE_CACHE in StackConfig.h must be defined as 1 to use method.
+		* @sa StackReserve(), StackShrink()
+		* @since v1.05
+*/
+#if (USING_STACK_NODE_CACHE == 1)
+	BOOL StackSetNodeCacheLimit(STACK *Stack, UINT32 Limit);
+#endif // end of USING_STACK_NODE_CACHE
+
+/*
+	Function: UINT32 StackGetSize(STACK *Stack)
+
+	Parameters: 
+		STACK *Stack - The address at which the STACK resides in memory.
+
+	Returns:
+		UINT32 - The number of elements currently found in the STACK 
+		passed in.  If the STACK referenced is NULL then this method will 
+		return 0.
+
+	Description: Returns the size of the referenced STACK.  Items spilled
+	out to a file by a memory budget are counted, see StackGetSpilledSize().
+
+	Notes: USING_STACK_GET_SIZE_METHOD in StackConfig.h must be defined as 1 to use method.
+*/
+/**
+		* @brief Will return the number of STACK_NODES within a STACK.
+		* @param *Stack - The address at which the STACK resides in memory.
+		* @return UINT32 - The number of STACK_NODE's in the STACK.  
+		If the Stack is eqaul to (STACK*)NULL then 0 is returned.
+		* @note USING_STACK_GET_SIZE_METHOD in StackConfig.h must be defined as 1 to use method.
+		* @sa None
+		* @since v1.0
+*/
+#if (USING_STACK_GET_SIZE_METHOD == 1)
+	UINT32 StackGetSize(STACK *Stack);
+#endif //end of USING_STACK_GET_SIZE
+
+/*
+	Function: UINT32 StackGetSizeInBytes(STACK *Stack, UINT32 DataSizeInBytes)
+
+	Parameters: 
+		STACK *Stack - The address at which the STACK resides in memory.
+		UINT32 DataSizeInBytes - The size in bytes of the data being stored
+								 at each STACK_NODE for the referenced STACK.
+
+	Returns:
+		UINT32 - The size in bytes that the entire STACK Data Structure takes up.  This
+		takes into account the size of each STACK_NODE within the STACK, the size of a 
+		STACK and the size of each data element a STACK_NODE is pointing to.  If the user
+		is not pointing to anything with the STACK_NODES's then DataSizeInBytes should be 
+		set to 0.  If the STACK referenced is NULL then this method will return 0.
+
+	Description: Returns the size of the referenced STACK in bytes.
+
+	Notes: This method does not take into account how much memory is used to allocate 
+	memory through StackMemAlloc().  With USING_STACK_CHUNKED_STORAGE the size
+	counts every slot of each STACK_NODE, used or not.  For a STACK made with
+	CreateValueStack() the items are part of the STACK_NODE's, so 
+	DataSizeInBytes is ignored and the size is exact.  Only the STACK_NODE's
+	of items still in memory are counted, see StackGetSpilledSizeInBytes().  USING_STACK_GET_SIZE_IN_BYTES_METHOD in StackConfig.h must be defined as 1 to use method.
+*/
+/**
+		* @brief Returns how much memory in bytes a STACK consumes.
+		* @param *Stack - The address at which the STACK resides in memory.
+		* @param DataSizeInBytes - The size in bytes of the data being stored 
+		at each STACK_NODE for the referenced STACK.  Should be 0 if the data
+		in each STACK_NODE is not used as a pointer.
+		* @return UINT32 - Returns the size of the referenced STACK in bytes.  Will
+		return 0 if unsuccessful.
+		* @note This method will take into account the sizeof STACK, plus
+		the size of each STACK_NODE.  This method will not take into account
+		the amount of memory needed to allocate memory from StackMemAlloc().
+		USING_STACK_GET_SIZE_IN_BYTES_METHOD in StackConfig.h must be defined as 1 to use method.
+		* @sa None
+		* @since v1.0
+*/
+#if (USING_STACK_GET_SIZE_IN_BYTES_METHOD == 1)
+	UINT32 StackGetSizeInBytes(STACK *Stack, UINT32 DataSizeInBytes);
+#endif // end of USING_STACK_GET_SIZE_IN_BYTES_METHOD
+
+/*
+	Function: BOOL StackSetMemoryBudget(STACK *Stack, UINT32 BudgetInBytes)
+
+	Parameters: 
+		STACK *Stack - The address at which the STACK resides in memory.
+		UINT32 BudgetInBytes - The most bytes of STACK_NODE's the STACK should
+		keep in memory, or 0 to stop spilling.
+
+	Returns:
+		BOOL - TRUE if the budget was set.  FALSE if the STACK was NULL or 
+		bounded, or it was already over the budget and couldn't be spilled.
+
+	Description: Gives the STACK a memory budget.  Once its STACK_NODE's
+	take up more than BudgetInBytes, all but the top half of the budget's
+	worth of items are written, bottom first, to the end of a temporary
+	file made with tmpfile(), and their STACK_NODE's are freed.  When 
+	StackPop() gets down to the spilled items, half a budget's worth of
+	them is read back in from the end of the file.  Both are done with 
+	large sequential reads and writes of STACK_SPILL_BUFFER_SIZE bytes.  
+	Only the item itself goes to the file, the data pointer of a STACK of
+	pointers or the copy held by a value STACK.  If a spill fails the
+	budget is turned off and the STACK keeps growing in memory.
+
+	Notes: StackClear() must be called before the memory of a STACK with
+	spilled items is released, so the file is closed.  USING_STACK_SPILL_METHODS
+	in StackConfig.h must be defined as 1 to use method.
+*/
+/**
+		* @brief Sets how much memory a STACK's nodes may use before its bottom items go to a file.
+		* @param *Stack - The address at which the STACK resides in memory.
+		* @param BudgetInBytes - The memory budget, 0 for none.
+		* @return BOOL - TRUE if successful, FALSE otherwise.
+		* @note USING_STACK_SPILL_METHODS in StackConfig.h must be defined as 1 to use method.
+		* @sa StackGetSpilledSize(), StackGetSpilledSizeInBytes()
+		* @since v1.05
+*/
+#if (USING_STACK_SPILL_METHODS == 1)
+	BOOL StackSetMemoryBudget(STACK *Stack, UINT32 BudgetInBytes);
+#endif // end of USING_STACK_SPILL_METHODS
+
+/*
+	Function: UINT32 StackGetSpilledSize(STACK *Stack)
+
+	Parameters: 
+		STACK *Stack - The address at which the STACK resides in memory.
+
+	Returns:
+		UINT32 - The number of the STACK's items that are in its spill file.
+		0 if the STACK is NULL.
+
+	Description: Returns how many of the items StackGetSize() counts are
+	not in memory.  The rest, StackGetSize() minus this, are in memory.
+
+	Notes: USING_STACK_SPILL_METHODS in StackConfig.h must be defined as 1 to use method.
+*/
+/**
+		* @brief Will return the number of a STACK's items that are spilled to its file.
+		* @param *Stack - The address at which the STACK resides in memory.
+		* @return UINT32 - The number of spilled items.
+		* @note USING_STACK_SPILL_METHODS in StackConfig.h must be defined as 1 to use method.
+		* @sa StackGetSize(), StackSetMemoryBudget()
+		* @since v1.05
+*/
+#if (USING_STACK_SPILL_METHODS == 1)
+	UINT32 StackGetSpilledSize(STACK *Stack);
+#endif // end of USING_STACK_SPILL_METHODS
+
+/*
+	Function: UINT64 StackGetSpilledSizeInBytes(STACK *Stack)
+
+	Parameters: 
+		STACK *Stack - The address at which the STACK resides in memory.
+
+	Returns:
+		UINT64 - The number of bytes of the STACK's spill file in use.  0 if
+		the STACK is NULL.
+
+	Description: Returns how much of the STACK is on disk rather than in
+	memory.  StackGetSizeInBytes() returns the part in memory.
+
+	Notes: USING_STACK_SPILL_METHODS in StackConfig.h must be defined as 1 to use method.
+*/
+/**
+		* @brief Will return how many bytes of a STACK are spilled to its file.
+		* @param *Stack - The address at which the STACK resides in memory.
+		* @return UINT64 - The size of the spilled items in bytes.
+		* @note USING_STACK_SPILL_METHODS in StackConfig.h must be defined as 1 to use method.
+		* @sa StackGetSizeInBytes(), StackSetMemoryBudget()
+		* @since v1.05
+*/
+#if (USING_STACK_SPILL_METHODS == 1)
+	UINT64 StackGetSpilledSizeInBytes(STACK *Stack);
+#endif // end of USING_STACK_SPILL_METHODS
+
+/*
+	Function: UINT32 StackGetSerializedSize(STACK *Stack, UINT32 ElementSize)
+
+	Parameters: 
+		STACK *Stack - The address at which the STACK resides in memory.
+		UINT32 ElementSize - For a STACK of data pointers, the size in bytes
+		of what each data pointer points to.  Ignored for a value STACK.
+
+	Returns:
+		UINT32 - The size in bytes of the buffer StackSerialize() needs for 
+		the STACK.  0 if the STACK was NULL, ElementSize was 0 for a STACK
+		of data pointers, or the STACK is too big to serialize.
+
+	Description: Returns how big a buffer to hand StackSerialize().
+
+	Notes: USING_STACK_SERIALIZE_METHODS in StackConfig.h must be defined as 1 to use method.
+*/
+/**
+		* @brief Will return the number of bytes a STACK takes up once serialized.
+		* @param *Stack - The address at which the STACK resides in memory.
+		* @param ElementSize - The size of what each data pointer points to.
+		* @return UINT32 - The size of the serialized STACK in bytes.
+		* @note USING_STACK_SERIALIZE_METHODS in StackConfig.h must be defined as 1 to use method.
+		* @sa StackSerialize()
+		* @since v1.05
+*/
+#if (USING_STACK_SERIALIZE_METHODS == 1)
+	UINT32 StackGetSerializedSize(STACK *Stack, UINT32 ElementSize);
+#endif // end of USING_STACK_SERIALIZE_METHODS
+
+/*
+	Function: UINT32 StackSerialize(STACK *Stack, UINT32 ElementSize, void *Buffer, UINT32 BufferSize)
+
+	Parameters: 
+		STACK *Stack - The address at which the STACK resides in memory.
+		UINT32 ElementSize - For a STACK of data pointers, the size in bytes
+		of what each data pointer points to.  Ignored for a value STACK.
+		void *Buffer - Where to write the serialized STACK.
+		UINT32 BufferSize - The size of Buffer in bytes.
+
+	Returns:
+		UINT32 - The number of bytes written to Buffer.  0 if the STACK or
+		Buffer was NULL, Buffer was too small, or spilled items couldn't be
+		read back.
+
+	Description: Writes a STACK_SERIAL_HEADER to Buffer followed by a copy
+	of every item, bottom first, in one pass over the STACK.  The STACK is
+	left as it was.  A value STACK writes its items, any other STACK writes
+	the ElementSize bytes each of its data pointers points to.  The buffer 
+	can be read back with StackDeserialize() or CreateStackView(), only on
+	a machine with the same byte order and word size as the one that wrote
+	it.
+
+	Notes: USING_STACK_SERIALIZE_METHODS in StackConfig.h must be defined as 1 to use method.
+*/
+/**
+		* @brief Writes a copy of every item of a STACK to a buffer, bottom first.
+		* @param *Stack - The address at which the STACK resides in memory.
+		* @param ElementSize - The size of what each data pointer points to.
+		* @param *Buffer - Where to write the serialized STACK.
+		* @param BufferSize - The size of the buffer in bytes.
+		* @return UINT32 - The number of bytes written, 0 if unsuccessful.
+		* @note USING_STACK_SERIALIZE_METHODS in StackConfig.h must be defined as 1 to use method.
+		* @sa StackGetSerializedSize(), StackDeserialize(), CreateStackView()
+		* @since v1.05
+*/
+#if (USING_STACK_SERIALIZE_METHODS == 1)
+	UINT32 StackSerialize(STACK *Stack, UINT32 ElementSize, void *Buffer, UINT32 BufferSize);
+#endif // end of USING_STACK_SERIALIZE_METHODS
+
+/*
+	Function: BOOL StackDeserialize(STACK *Stack, const void *Buffer, UINT32 BufferSize)
+
+	Parameters: 
+		STACK *Stack - The address at which the STACK resides in memory.
+		const void *Buffer - A buffer written by StackSerialize().
+		UINT32 BufferSize - The size of Buffer in bytes.
+
+	Returns:
+		BOOL - TRUE if every item was pushed.  FALSE if the STACK or Buffer 
+		was NULL, Buffer wasn't written by StackSerialize(), was written on
+		a machine with another byte order or word size, a value STACK was
+		handed items of another size, or an item couldn't be pushed, in 
+		which case the STACK is left as it was.
+
+	Description: Pushes the items in Buffer onto the STACK in one pass, on
+	top of anything already in it, so they come off in the same order they
+	came off the STACK that was serialized.  A value STACK copies the items
+	in.  Any other STACK gets a copy of each item from its own allocator
+	pushed as its data pointer, so its free method must hand the copy 
+	back there, with StackMemDealloc() unless USING_STACK_ALLOCATORS gave
+	the STACK another allocator.
+
+	Notes: USING_STACK_SERIALIZE_METHODS in StackConfig.h must be defined as 1 to use method.
+*/
+/**
+		* @brief Pushes the items of a serialized STACK onto a STACK, keeping their order.
+		* @param *Stack - The address at which the STACK resides in memory.
+		* @param *Buffer - A buffer written by StackSerialize().
+		* @param BufferSize - The size of the buffer in bytes.
+		* @return BOOL - TRUE if successful, FALSE otherwise.
+		* @note USING_STACK_SERIALIZE_METHODS in StackConfig.h must be defined as 1 to use method.
+		* @sa StackSerialize(), CreateStackView()
+		* @since v1.05
+*/
+#if (USING_STACK_SERIALIZE_METHODS == 1)
+	BOOL StackDeserialize(STACK *Stack, const void *Buffer, UINT32 BufferSize);
+#endif // end of USING_STACK_SERIALIZE_METHODS
+
+/*
+	Function: STACK *CreateStackView(STACK *Stack, const void *Buffer, UINT32 BufferSize)
+
+	Parameters: 
+		STACK *Stack - The address at which the STACK will be inititalized.
+		If NULL is passed in then this method will create a STACK out of 
+		the heap with a call to StackMemAlloc().
+
+		const void *Buffer - A buffer written by StackSerialize().
+		UINT32 BufferSize - The size of Buffer in bytes.
+
+	Returns:
+		STACK* - The address at which the view resides in memory.  
+		(STACK*)NULL if Buffer was NULL or wasn't written by StackSerialize()
+		on a machine with the same byte order and word size, or the STACK
+		couldn't be allocated.
+
+	Description: Makes a read only value STACK whose items are the ones in 
+	Buffer, read in place.  Nothing is copied and no STACK_NODE's are made,
+	so it takes the same time for any number of items.  StackPopValue(), 
+	StackPeekValue(), StackGetSize() and StackClear() work as they do on 
+	any value STACK, only without touching Buffer.  StackPeek() returns the
+	address of the top item inside Buffer, which must not be written to.
+	StackPushValue() returns FALSE.
+
+	Notes: Buffer must stay around, unchanged, for as long as the view is 
+	used.  USING_STACK_SERIALIZE_METHODS in StackConfig.h must be defined
+	as 1 to use method.
+*/
+/**
+		* @brief Makes a read only STACK over a serialized buffer without copying it.
+		* @param *Stack - A pointer to an already allocate STACK or a NULL
+		pointer to create a STACK from StackMemAlloc().
+		* @param *Buffer - A buffer written by StackSerialize().
+		* @param BufferSize - The size of the buffer in bytes.
+		* @return *STACK - The address of the view in memory.  If it could not
+		be made, returns a NULL pointer.
+		* @note USING_STACK_SERIALIZE_METHODS in StackConfig.h must be defined as 1 to use method.
+		* @sa StackSerialize(), StackIsView()
+		* @since v1.05
+*/
+#if (USING_STACK_SERIALIZE_METHODS == 1)
+	STACK *CreateStackView(STACK *Stack, const void *Buffer, UINT32 BufferSize);
+#endif // end of USING_STACK_SERIALIZE_METHODS
+
+/*
+	Function: BOOL StackGetStats(STACK *Stack, STACK_STATS *Stats)
+
+	Parameters: 
+		STACK *Stack - The address at which the STACK resides in memory.
+		STACK_STATS *Stats - Where to copy the STACK's counters to.
+
+	Returns:
+		BOOL - TRUE if the counters were copied, FALSE if the STACK or 
+		Stats was NULL.
+
+	Description: Copies out the counters the STACK keeps: the number of
+	items pushed and popped, the most items it has held at once, the number
+	of times it could not get memory for a STACK_NODE and the number of 
+	times it was cleared.  If USING_STACK_LATENCY_HISTOGRAM is defined as 1
+	the histograms of how long the timed StackPush() and StackPop() calls 
+	took are copied as well.
+
+	Notes: USING_STACK_STATISTICS in StackConfig.h must be defined as 1 to use method.
+*/
+/**
+		* @brief Copies out the usage counters of a STACK.
+		* @param *Stack - The address at which the STACK resides in memory.
+		* @param *Stats - Where to copy the counters to.
+		* @return BOOL - TRUE if successful, FALSE otherwise.
+		* @note USING_STACK_STATISTICS in StackConfig.h must be defined as 1 to use method.
+		* @sa StackResetStats()
+		* @since v1.05
+*/
+#if (USING_STACK_STATISTICS == 1)
+	BOOL StackGetStats(STACK *Stack, STACK_STATS *Stats);
+#endif // end of USING_STACK_STATISTICS
+
+/*
+	Function: BOOL StackResetStats(STACK *Stack)
+
+	Parameters: 
+		STACK *Stack - The address at which the STACK resides in memory.
+
+	Returns:
+		BOOL - TRUE if the counters were reset, FALSE if the STACK was NULL.
+
+	Description: Sets all of the STACK's counters and latency histograms 
+	back to 0.  The peak size starts over from the STACK's current size.
+
+	Notes: USING_STACK_STATISTICS in StackConfig.h must be defined as 1 to use method.
+*/
+/**
+		* @brief Resets the usage counters of a STACK.
+		* @param *Stack - The address at which the STACK resides in memory.
+		* @return BOOL - TRUE if successful, FALSE if the STACK was NULL.
+		* @note USING_STACK_STATISTICS in StackConfig.h must be defined as 1 to use method.
+		* @sa StackGetStats()
+		* @since v1.05
+*/
+#if (USING_STACK_STATISTICS == 1)
+	BOOL StackResetStats(STACK *Stack);
+#endif // end of USING_STACK_STATISTICS
+
+/*
+	Function: CONCURRENT_STACK *CreateConcurrentStack(CONCURRENT_STACK *Stack, void (*CustomFreeMethod)(void *Data))
+
+	Parameters: 
+		CONCURRENT_STACK *Stack - The address at which the CONCURRENT_STACK will
+		be inititalized.  If NULL is passed in then this method will create a 
+		CONCURRENT_STACK out of the heap with a call to StackMemAlloc().
+
+		void(*CustomFreeMethod)(void *Data) - A pointer to a method that the
+		user defines.  ConcurrentStackClear() calls it on the data of every
+		node it removes.
+
+	Returns:
+		CONCURRENT_STACK* - The address at which the newly initialized 
+		CONCURRENT_STACK resides in memory.  If a new CONCURRENT_STACK could 
+		not be created then (CONCURRENT_STACK*)NULL is returned.
+
+	Description: Creates a new lock free CONCURRENT_STACK in memory.  Any
+	number of threads can call ConcurrentStackPush(), ConcurrentStackPop() 
+	and ConcurrentStackClear() on it at the same time without a lock.
+
+	Notes: Must not be called while other threads are using the CONCURRENT_STACK.
+	USING_STACK_CONCURRENT_METHODS in StackConfig.h must be defined as 1 to use method.
+*/
+/**
+		* @brief Initializes a CONCURRENT_STACK, and can create a CONCURRENT_STACK.
+		* @param *Stack- A pointer to an already allocate CONCURRENT_STACK or a NULL 
+		pointer to create a CONCURRENT_STACK from StackMemAlloc().
+		* @param *CustomFreeMethod - A method called by the STACK Library to delete
+		a piece of data that a CONCURRENT_STACK_NODE points to.
+		* @return *CONCURRENT_STACK - The address of the CONCURRENT_STACK in memory.
+		If it could not be allocated, returns a NULL pointer.
+		* @note USING_STACK_CONCURRENT_METHODS in StackConfig.h must be defined as 1 to use method.
+		* @sa StackMemAlloc()
+		* @since v1.05
+*/
+#if (USING_STACK_CONCURRENT_METHODS == 1)
+	CONCURRENT_STACK *CreateConcurrentStack(CONCURRENT_STACK *Stack, void (*CustomFreeMethod)(void *Data));
+#endif // end of USING_STACK_CONCURRENT_METHODS
+
+/*
+	Function: CONCURRENT_STACK *CreateEliminationStack(CONCURRENT_STACK *Stack, void (*CustomFreeMethod)(void *Data))
+
+	Parameters: 
+		CONCURRENT_STACK *Stack - The address at which the CONCURRENT_STACK will
+		be inititalized.  If NULL is passed in then this method will create a 
+		CONCURRENT_STACK out of the heap with a call to StackMemAlloc().
+
+		void(*CustomFreeMethod)(void *Data) - A pointer to a method that the
+		user defines.  ConcurrentStackClear() calls it on the data of every
+		node it removes.
+
+	Returns:
+		CONCURRENT_STACK* - The address at which the newly initialized 
+		CONCURRENT_STACK resides in memory.  If a new CONCURRENT_STACK could 
+		not be created then (CONCURRENT_STACK*)NULL is returned.
+
+	Description: Same as CreateConcurrentStack(), but the CONCURRENT_STACK
+	also gets an elimination array.  When a ConcurrentStackPush() and a 
+	ConcurrentStackPop() both fail their compare and swap on the top they 
+	try to meet in a random slot of the array, and the push hands its data
+	straight to the pop without either touching the top.  Each thread 
+	widens the part of the array it uses when it keeps colliding with other
+	threads and narrows it when it keeps finding nobody, so the array 
+	spreads out as contention goes up.
+
+	Notes: Only worth it when many threads push and pop the same 
+	CONCURRENT_STACK at once.  USING_STACK_ELIMINATION_BACKOFF in StackConfig.h
+	must be defined as 1 to use method.
+*/
+/**
+		* @brief Initializes a CONCURRENT_STACK with an elimination array, and can create one.
+		* @param *Stack- A pointer to an already allocate CONCURRENT_STACK or a NULL 
+		pointer to create a CONCURRENT_STACK from StackMemAlloc().
+		* @param *CustomFreeMethod - A method called by the STACK Library to delete
+		a piece of data that a CONCURRENT_STACK_NODE points to.
+		* @return *CONCURRENT_STACK - The address of the CONCURRENT_STACK in memory.
+		If it could not be allocated, returns a NULL pointer.
+		* @note USING_STACK_ELIMINATION_BACKOFF in StackConfig.h must be defined as 1 to use method.
+		* @sa CreateConcurrentStack(), STACK_ELIMINATION_ARRAY_SIZE, STACK_ELIMINATION_SPIN
+		* @since v1.05
+*/
+#if (USING_STACK_ELIMINATION_BACKOFF == 1)
+	CONCURRENT_STACK *CreateEliminationStack(CONCURRENT_STACK *Stack, void (*CustomFreeMethod)(void *Data));
+#endif // end of USING_STACK_ELIMINATION_BACKOFF
+
+/*
+	Function: BOOL ConcurrentStackPush(CONCURRENT_STACK *Stack, const void *Data)
+
+	Parameters: 
+		CONCURRENT_STACK *Stack - The address at which the CONCURRENT_STACK resides in memory.
+		const void *Data - The data to store on top of the CONCURRENT_STACK.
+
+	Returns:
+		BOOL - TRUE if the data was pushed.  FALSE if the CONCURRENT_STACK
+		pointer was NULL or if StackMemAlloc() ran out of memory.
+
+	Description: Pushes one item onto the CONCURRENT_STACK with a compare
+	and swap of its top.  Safe to call from any number of threads at once.
+
+	Notes: StackMemAlloc() must be thread safe.  USING_STACK_CONCURRENT_METHODS 
+	in StackConfig.h must be defined as 1 to use method.
+*/
+/**
+		* @brief Atomically puts a new CONCURRENT_STACK_NODE with it's data on top of the CONCURRENT_STACK.
+		* @param *Stack - The address at which the CONCURRENT_STACK resides in memory.
+		* @param *Data \a- A void pointer to the data to push.
+		* @return BOOL - TRUE if the operation was successful.  FALSE if there 
+		was not enough memory to add a CONCURRENT_STACK_NODE.
+		* @note USING_STACK_CONCURRENT_METHODS in StackConfig.h must be defined as 1 to use method.
+		* @sa StackMemAlloc(), StackAtomicCompareAndSwap()
+		* @since v1.05
+*/
+#if (USING_STACK_CONCURRENT_METHODS == 1)
+	BOOL ConcurrentStackPush(CONCURRENT_STACK *Stack, const void *Data);
+#endif // end of USING_STACK_CONCURRENT_METHODS
+
+/*
+	Function: void *ConcurrentStackPop(CONCURRENT_STACK *Stack)
+
+	Parameters: 
+		CONCURRENT_STACK *Stack - The address at which the CONCURRENT_STACK resides in memory.
+
+	Returns:
+		void* - The data of the item that was removed from the CONCURRENT_STACK.
+		If the CONCURRENT_STACK was empty or NULL then (void*)NULL is returned.
+
+	Description: Pops one item from the CONCURRENT_STACK with a compare and
+	swap of its top.  Safe to call from any number of threads at once.  The
+	popped CONCURRENT_STACK_NODE is not freed right away, it is freed with
+	StackMemDealloc() once no other thread can still be reading it (hazard
+	pointers).  That also keeps a node from being reused while another thread
+	is comparing against it, so the pop is not exposed to the ABA problem.
+
+	Notes: The first pop done by a thread allocates the thread's hazard record,
+	see ConcurrentStackReleaseThread().  USING_STACK_CONCURRENT_METHODS in 
+	StackConfig.h must be defined as 1 to use method.
+*/
+/**
+		* @brief Atomically removes and returns the data on top of the CONCURRENT_STACK.
+		* @param *Stack - The address at which the CONCURRENT_STACK resides in memory.
+		* @return *void - The data on top of the CONCURRENT_STACK, or (void*)NULL if
+		it was empty.
+		* @note The popped node is freed later, once no thread holds a hazard 
+		pointer to it.  USING_STACK_CONCURRENT_METHODS in StackConfig.h must be 
+		defined as 1 to use method.
+		* @sa ConcurrentStackReleaseThread(), StackMemDealloc()
+		* @since v1.05
+*/
+#if (USING_STACK_CONCURRENT_METHODS == 1)
+	void *ConcurrentStackPop(CONCURRENT_STACK *Stack);
+#endif // end of USING_STACK_CONCURRENT_METHODS
+
+/*
+	Function: BOOL ConcurrentStackClear(CONCURRENT_STACK *Stack)
+
+	Parameters: 
+		CONCURRENT_STACK *Stack - The address at which the CONCURRENT_STACK resides in memory.
+
+	Returns:
+		BOOL - TRUE once the CONCURRENT_STACK has been seen empty.
+		FALSE - If a NULL referenced CONCURRENT_STACK was passed in.
+
+	Description: Pops every item off of the CONCURRENT_STACK, calling the
+	STACK's free method on each piece of data if one was supplied at the
+	CONCURRENT_STACK's creation.
+
+	Notes: Items pushed by other threads while this runs may or may not be
+	removed.  USING_STACK_CONCURRENT_METHODS in StackConfig.h must be defined as 1
+	to use method.
+*/
+/**
+		* @brief Pops and frees all of a CONCURRENT_STACK's nodes and data(optional).
+		* @param *Stack - The address at which the CONCURRENT_STACK resides in memory.
+		* @return BOOL - TRUE if successful, FALSE if the CONCURRENT_STACK was NULL.
+		* @note USING_STACK_CONCURRENT_METHODS in StackConfig.h must be defined as 1 to use method.
+		* @sa ConcurrentStackPop()
+		* @since v1.05
+*/
+#if (USING_STACK_CONCURRENT_METHODS == 1)
+	BOOL ConcurrentStackClear(CONCURRENT_STACK *Stack);
+#endif // end of USING_STACK_CONCURRENT_METHODS
+
+/*
+	Function: UINT32 ConcurrentStackGetSize(CONCURRENT_STACK *Stack)
+
+	Parameters: 
+		CONCURRENT_STACK *Stack - The address at which the CONCURRENT_STACK resides in memory.
+
+	Returns:
+		UINT32 - The number of elements in the CONCURRENT_STACK.  If the
+		CONCURRENT_STACK referenced is NULL then this method will return 0.
+
+	Description: Returns the size of the referenced CONCURRENT_STACK.
+
+	Notes: With other threads pushing and popping the size may already be
+	out of date when it is returned.  A push is counted just before its
+	item can be popped, so the size never drops below 0 while a pop races
+	ahead of it.  USING_STACK_CONCURRENT_METHODS in StackConfig.h must be
+	defined as 1 to use method.
+*/
+/**
+		* @brief Will return the number of items in a CONCURRENT_STACK.
+		* @param *Stack - The address at which the CONCURRENT_STACK resides in memory.
+		* @return UINT32 - The number of items in the CONCURRENT_STACK.
+		* @note USING_STACK_CONCURRENT_METHODS in StackConfig.h must be defined as 1 to use method.
+		* @sa None
+		* @since v1.05
+*/
+#if (USING_STACK_CONCURRENT_METHODS == 1)
+	UINT32 ConcurrentStackGetSize(CONCURRENT_STACK *Stack);
+#endif // end of USING_STACK_CONCURRENT_METHODS
+
+/*
+	Function: void ConcurrentStackReleaseThread(void)
+
+	Parameters: 
+		None
+
+	Returns:
+		None
+
+	Description: Should be called by a thread that has used ConcurrentStackPop()
+	before it exits.  Frees every node the thread popped that no other thread
+	is still reading, and hands the thread's hazard record over for another 
+	thread to use.  With USING_STACK_NODE_MAGAZINES the nodes in the thread's
+	own magazine, if it has one, are moved to the shared depot.
+
+	Notes: USING_STACK_CONCURRENT_METHODS in StackConfig.h must be defined as 1 to use method.
+*/
+/**
+		* @brief Gives up the calling thread's hazard record.
+		* @param None
+		* @return None
+		* @note Call before a thread that popped from a CONCURRENT_STACK exits.
+		USING_STACK_CONCURRENT_METHODS in StackConfig.h must be defined as 1 to use method.
+		* @sa ConcurrentStackPop()
+		* @since v1.05
+*/
+#if (USING_STACK_CONCURRENT_METHODS == 1)
+	void ConcurrentStackReleaseThread(void);
+#endif // end of USING_STACK_CONCURRENT_METHODS
+
+/*
+	Function: const BYTE *StackGetLibraryVersion(void)
+
+	Parameters: 
+		None
+
+	Returns:
+		const BYTE* - The library version of the Stack Library.  This string is 
+		(BYTE)NULL terminated.
+
+	Description: Returns the version number of the Stack Library.
+
+	Notes: USING_STACK_GET_LIBRARY_VERSION in StackConfig.h must be defined as 1 to use method.
+*/
+/**
+		* @brief Returns the version number of the Stack Library.
+		* @param None
+		* @return const BYTE* - The library version of the Stack Library.
+		* @note This string is (BYTE)NULL terminated.   USING_STACK_GET_LIBRARY_VERSION in StackConfig.h must be defined as 1 to use method.
+		* @sa None
+		* @since v1.03
+*/
+#if (USING_STACK_GET_LIBRARY_VERSION == 1)
+	const BYTE *StackGetLibraryVersion(void);
+#endif // end of USING_STACK_GET_LIBRARY_VERSION
+
+/*
+	Macro: UINT32 StackGetSizeOfNodeInBytes(UINT32 DataSizeInBytes)
+
+	Parameters: 
+		UINT32 DataSizeInBytes - The size in bytes of the data being stored in a STACK.
+
+	Returns:
+		UINT32 - The size in bytes that the STACK_NODE takes up with it's accompaning
+		data.
+
+	Description: Returns the size of a STACK_NODE and it's data in bytes.
+
+	Notes: This method does not take into account how much memory is used to allocate 
+	memory through StackMemAlloc().
+*/
+#define StackGetSizeOfNodeInBytes(Size)			(UINT32)(Size + sizeof(STACK_NODE))
+
+/*
+	Macro: BOOL StackIsNull(STACK *Stack)
+
+	Parameters: 
+		STACK *Stack - The STACK to check if it's NULL or not.
+
+	Returns:
+		BOOL - TRUE if the STACK is NULL, FALSE otherwise.
+
+	Description: Checks to see if a STACK is NULL or not.
+
+	Notes: None
+*/
+#define StackIsNull(Stack)						(Stack == (STACK*)NULL)
+
+/*
+	Macro: BOOL StackIsEmpty(STACK *Stack)
+
+	Parameters: 
+		STACK *Stack - The STACK to check if it's empty or not.
+
+	Returns:
+		BOOL - TRUE if the STACK is empty, FALSE otherwise.
+
+	Description: Checks to see if the STACK is empty.
+
+	Notes: None
+*/
+#define StackIsEmpty(Stack)						((Stack)->Size == (UINT32)0)
+
+/*
+	Macro: BOOL StackIsValueStack(STACK *Stack)
+
+	Parameters: 
+		STACK *Stack - The STACK to check.
+
+	Returns:
+		BOOL - TRUE if the STACK was made with CreateValueStack(), FALSE otherwise.
+
+	Description: Checks to see if the STACK holds copies of its items 
+	rather than data pointers.
+
+	Notes: USING_STACK_VALUE_METHODS in StackConfig.h must be defined as 1 to use macro.
+*/
+#if (USING_STACK_VALUE_METHODS == 1)
+	#define StackIsValueStack(Stack)				((Stack)->ElementSize != (UINT32)0)
+#endif // end of USING_STACK_VALUE_METHODS
+
+/*
+	Macro: BOOL StackIsBounded(STACK *Stack)
+
+	Parameters: 
+		STACK *Stack - The STACK to check.
+
+	Returns:
+		BOOL - TRUE if the STACK was made with CreateBoundedStack(), FALSE otherwise.
+
+	Description: Checks to see if the STACK keeps its data in a caller 
+	supplied buffer.
+
+	Notes: USING_STACK_BOUNDED_METHODS in StackConfig.h must be defined as 1 to use macro.
+*/
+#if (USING_STACK_BOUNDED_METHODS == 1)
+	#define StackIsBounded(Stack)					((Stack)->Buffer != (void**)NULL)
+#endif // end of USING_STACK_BOUNDED_METHODS
+
+/*
+	Macro: BOOL StackIsFull(STACK *Stack)
+
+	Parameters: 
+		STACK *Stack - The bounded STACK to check.
+
+	Returns:
+		BOOL - TRUE if the STACK's buffer has no room left, FALSE otherwise.
+
+	Description: Checks to see if a STACK made with CreateBoundedStack() is
+	full, meaning StackPush() would return FALSE.
+
+	Notes: USING_STACK_BOUNDED_METHODS in StackConfig.h must be defined as 1 to use macro.
+*/
+#if (USING_STACK_BOUNDED_METHODS == 1)
+	#define StackIsFull(Stack)						((Stack)->Size == (Stack)->Capacity)
+#endif // end of USING_STACK_BOUNDED_METHODS
+
+/*
+	Macro: BOOL StackIsView(STACK *Stack)
+
+	Parameters: 
+		STACK *Stack - The STACK to check.
+
+	Returns:
+		BOOL - TRUE if the STACK was made with CreateStackView(), FALSE otherwise.
+
+	Description: Checks to see if the STACK is a read only view over a
+	serialized buffer.
+
+	Notes: USING_STACK_SERIALIZE_METHODS in StackConfig.h must be defined as 1 to use macro.
+*/
+#if (USING_STACK_SERIALIZE_METHODS == 1)
+	#define StackIsView(Stack)						((Stack)->View != (const BYTE*)NULL)
+#endif // end of USING_STACK_SERIALIZE_METHODS
+
+#ifdef __cplusplus
+	}
+#endif // end of __cplusplus
 
 #endif // end of STACK_H
@@ -0,0 +1,747 @@
+/*
+	Date: March 26, 2011
+	File Name: Stack.hpp
+	Version: 1.05
+	IDE: Visual Studio 2010 Professional
+	Compiler: C++11
+
+	Description:
+	This file contains a header only C++ wrapper around the Stack
+	library.  StackLibrary::Stack<T> keeps typed items in a STACK, so
+	C++ code doesn't have to cast to and from void*.  A T that is
+	trivially copyable and fits in a data pointer is kept right in the
+	STACK's slot, anything else is kept in a box of its own that Alloc
+	hands out.  Giving a Capacity makes a Stack that keeps its items
+	inside itself and never allocates.  All methods have their
+	documentation above their declaration.
+*/
+
+#ifndef STACK_HPP
+	#define STACK_HPP
+
+#include <cstddef>
+#include <cstring>
+#include <iterator>
+#include <memory>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+#include "Stack.h"
+
+#if (USE_MALLOC == 1)
+	#include "stdlib.h"
+#endif // end of USE_MALLOC
+
+namespace StackLibrary
+{
+	/*
+		StackStoresByValue<T>::value is true if a T is kept right in a
+		STACK slot instead of a box of its own.  It has to be trivially
+		copyable and fit in, and line up like, a data pointer.
+	*/
+	template <typename T>
+	struct StackStoresByValue : std::integral_constant<bool, std::is_trivially_copyable<T>::value && sizeof(T) <= sizeof(void*) && alignof(T) <= alignof(void*)>
+	{
+	};
+
+	/*
+		Description: A typed stack of T.  With a Capacity of 0 (the
+		default) the items are kept in a STACK made with CreateStack(),
+		and each T that isn't kept by value is allocated from Alloc.
+		With any other Capacity the Stack keeps up to Capacity items
+		inside itself, never allocates, and push() returns false once it
+		is full.  Stack's can be moved but not copied, and T can be a
+		move only type.  A Stack that has been moved from is empty and
+		can be used again.  With a Capacity of 0 it has no STACK until
+		the next push() makes a new one, so native() returns NULL.
+
+		Notes: begin() is the top of the Stack and end() is past the
+		bottom.  The STACK native() returns must not be given a memory
+		budget, a bound or any data of its own.
+	*/
+	/**
+		* @brief A typed stack of T, kept inline if Capacity isn't 0.
+		* @since v1.05
+	*/
+	template <typename T, typename Alloc = std::allocator<T>, std::size_t Capacity = 0>
+	class Stack
+	{
+		public:
+			typedef T value_type;
+			typedef std::size_t size_type;
+			typedef T &reference;
+			typedef const T &const_reference;
+			typedef std::reverse_iterator<T*> iterator;
+			typedef std::reverse_iterator<const T*> const_iterator;
+
+			Stack() : Count(0)
+			{
+			}
+
+			~Stack()
+			{
+				clear();
+			}
+
+			Stack(const Stack&) = delete;
+			Stack &operator=(const Stack&) = delete;
+
+			Stack(Stack &&Other) noexcept(std::is_nothrow_move_constructible<T>::value) : Count(0)
+			{
+				Take(Other);
+			}
+
+			Stack &operator=(Stack &&Other) noexcept(std::is_nothrow_move_constructible<T>::value)
+			{
+				if(this != &Other)
+				{
+					clear();
+
+					Take(Other);
+				}
+
+				return *this;
+			}
+
+			/**
+				* @brief Makes a T from Arguments on top of the Stack.
+				* @return bool - false if the Stack is full.
+			*/
+			template <typename... Args>
+			bool emplace(Args&&... Arguments)
+			{
+				if(Count == Capacity)
+					return false;
+
+				::new(static_cast<void*>(Items() + Count)) T(std::forward<Args>(Arguments)...);
+
+				Count++;
+
+				return true;
+			}
+
+			bool push(const T &Value)
+			{
+				return emplace(Value);
+			}
+
+			bool push(T &&Value)
+			{
+				return emplace(std::move(Value));
+			}
+
+			/**
+				* @brief Destroys the top of the Stack, which must not be empty.
+			*/
+			void pop()
+			{
+				Items()[--Count].~T();
+			}
+
+			/**
+				* @brief Moves the top of the Stack into Out and removes it.
+				* @return bool - false if the Stack was empty.
+			*/
+			bool pop(T &Out)
+			{
+				if(Count == 0)
+					return false;
+
+				Out = std::move(Items()[Count - 1]);
+
+				pop();
+
+				return true;
+			}
+
+			T &top()
+			{
+				return Items()[Count - 1];
+			}
+
+			const T &top() const
+			{
+				return Items()[Count - 1];
+			}
+
+			bool empty() const
+			{
+				return Count == 0;
+			}
+
+			bool full() const
+			{
+				return Count == Capacity;
+			}
+
+			size_type size() const
+			{
+				return Count;
+			}
+
+			size_type capacity() const
+			{
+				return Capacity;
+			}
+
+			void clear()
+			{
+				while(Count)
+					pop();
+			}
+
+			iterator begin()
+			{
+				return iterator(Items() + Count);
+			}
+
+			iterator end()
+			{
+				return iterator(Items());
+			}
+
+			const_iterator begin() const
+			{
+				return const_iterator(Items() + Count);
+			}
+
+			const_iterator end() const
+			{
+				return const_iterator(Items());
+			}
+
+		private:
+			T *Items()
+			{
+				return reinterpret_cast<T*>(Storage);
+			}
+
+			const T *Items() const
+			{
+				return reinterpret_cast<const T*>(Storage);
+			}
+
+			/*
+				Moves every item of Other, which is left empty, onto this
+				Stack, which must be empty.
+			*/
+			void Take(Stack &Other)
+			{
+				for(Count = 0; Count < Other.Count; Count++)
+					::new(static_cast<void*>(Items() + Count)) T(std::move(Other.Items()[Count]));
+
+				Other.clear();
+			}
+
+			typename std::aligned_storage<sizeof(T), alignof(T)>::type Storage[Capacity];
+			size_type Count;
+	};
+
+	template <typename T, typename Alloc>
+	class Stack<T, Alloc, 0>
+	{
+		private:
+			typedef typename std::allocator_traits<Alloc>::template rebind_alloc<T> ElementAllocator;
+			typedef std::allocator_traits<ElementAllocator> ElementTraits;
+
+			static const bool ByValue = StackStoresByValue<T>::value;
+
+			/*
+				A box can only be given back from the STACK's free method if
+				a new ElementAllocator can give it back, which is true of an
+				allocator with no state.
+			*/
+			static const bool FreesBoxes = !ByValue && std::is_empty<ElementAllocator>::value && std::is_default_constructible<ElementAllocator>::value;
+
+		public:
+			typedef T value_type;
+			typedef std::size_t size_type;
+			typedef T &reference;
+			typedef const T &const_reference;
+
+			/*
+				Walks the items from the top of the STACK down.
+			*/
+			template <typename Value>
+			class Iterator
+			{
+				public:
+					typedef std::forward_iterator_tag iterator_category;
+					typedef T value_type;
+					typedef std::ptrdiff_t difference_type;
+					typedef Value *pointer;
+					typedef Value &reference;
+
+					Iterator() : Node((STACK_NODE*)NULL), Index(0)
+					{
+					}
+
+					explicit Iterator(STACK_NODE *Top) : Node(Top), Index(Top ? LastIndex(Top) : 0)
+					{
+					}
+
+					template <typename Other>
+					Iterator(const Iterator<Other> &Source) : Node(Source.Node), Index(Source.Index)
+					{
+					}
+
+					reference operator*() const
+					{
+						return Element(Slot(Node, Index));
+					}
+
+					pointer operator->() const
+					{
+						return &Element(Slot(Node, Index));
+					}
+
+					Iterator &operator++()
+					{
+						if(Index)
+						{
+							Index--;
+						}
+						else
+						{
+							Node = Node->Next;
+
+							Index = Node ? LastIndex(Node) : 0;
+						}
+
+						return *this;
+					}
+
+					Iterator operator++(int)
+					{
+						Iterator Old(*this);
+
+						++*this;
+
+						return Old;
+					}
+
+					template <typename Other>
+					bool operator==(const Iterator<Other> &Right) const
+					{
+						return Node == Right.Node && Index == Right.Index;
+					}
+
+					template <typename Other>
+					bool operator!=(const Iterator<Other> &Right) const
+					{
+						return !(*this == Right);
+					}
+
+				private:
+					template <typename Other>
+					friend class Iterator;
+
+					STACK_NODE *Node;
+					UINT32 Index;
+			};
+
+			typedef Iterator<T> iterator;
+			typedef Iterator<const T> const_iterator;
+
+			/**
+				* @brief Creates an empty Stack.
+				* @param *FreeMethod - Passed to CreateStack() for a T kept by value,
+				usually a pointer the Stack owns.  Ignored for a T kept in a box.
+				* @param &Allocator - Where boxes come from.
+			*/
+			explicit Stack(void (*FreeMethod)(void *Data) = nullptr, const Alloc &Allocator = Alloc()) : Native((STACK*)NULL), Boxes(Allocator), NativeFreeMethod(ByValue ? FreeMethod : BoxFreeMethod(std::integral_constant<bool, FreesBoxes>()))
+			{
+				#if (USING_STACK_CHUNKED_STORAGE == 1)
+					ElementsPerNode = (UINT32)0;
+				#endif // end of USING_STACK_CHUNKED_STORAGE
+
+				if(!Create())
+					throw std::bad_alloc();
+			}
+
+			#if (USING_STACK_CHUNKED_STORAGE == 1)
+				/**
+					* @brief Creates an empty Stack whose STACK_NODE's hold ElementsPerNode items each.
+				*/
+				Stack(UINT32 ElementsPerNode, void (*FreeMethod)(void *Data) = nullptr, const Alloc &Allocator = Alloc()) : Native((STACK*)NULL), Boxes(Allocator), NativeFreeMethod(ByValue ? FreeMethod : BoxFreeMethod(std::integral_constant<bool, FreesBoxes>())), ElementsPerNode(ElementsPerNode)
+				{
+					if(!Create())
+						throw std::bad_alloc();
+				}
+			#endif // end of USING_STACK_CHUNKED_STORAGE
+
+			/**
+				* @brief Frees every item like clear(), then the STACK itself.
+			*/
+			~Stack()
+			{
+				Destroy();
+			}
+
+			Stack(const Stack&) = delete;
+			Stack &operator=(const Stack&) = delete;
+
+			Stack(Stack &&Other) noexcept : Native(Other.Native), Boxes(std::move(Other.Boxes)), NativeFreeMethod(Other.NativeFreeMethod)
+			{
+				#if (USING_STACK_CHUNKED_STORAGE == 1)
+					ElementsPerNode = Other.ElementsPerNode;
+				#endif // end of USING_STACK_CHUNKED_STORAGE
+
+				Other.Native = (STACK*)NULL;
+			}
+
+			Stack &operator=(Stack &&Other) noexcept
+			{
+				if(this != &Other)
+				{
+					Destroy();
+
+					Native = Other.Native;
+					Boxes = std::move(Other.Boxes);
+					NativeFreeMethod = Other.NativeFreeMethod;
+
+					#if (USING_STACK_CHUNKED_STORAGE == 1)
+						ElementsPerNode = Other.ElementsPerNode;
+					#endif // end of USING_STACK_CHUNKED_STORAGE
+
+					Other.Native = (STACK*)NULL;
+				}
+
+				return *this;
+			}
+
+			/**
+				* @brief Makes a T from Arguments on top of the Stack.  A Stack
+				that has been moved from gets a new STACK first.
+				* @return bool - false if the STACK couldn't get a STACK_NODE, or
+				a new STACK couldn't be made.
+			*/
+			template <typename... Args>
+			bool emplace(Args&&... Arguments)
+			{
+				if(Native == (STACK*)NULL && !Create())
+					return false;
+
+				return Emplace(std::integral_constant<bool, ByValue>(), std::forward<Args>(Arguments)...);
+			}
+
+			bool push(const T &Value)
+			{
+				return emplace(Value);
+			}
+
+			bool push(T &&Value)
+			{
+				return emplace(std::move(Value));
+			}
+
+			/**
+				* @brief Removes the top of the Stack, which must not be empty, and
+				frees it the way clear() would.
+			*/
+			void pop()
+			{
+				Dispose(StackPop(Native));
+			}
+
+			/**
+				* @brief Moves the top of the Stack into Out and removes it.  The
+				free method isn't called, Out owns whatever the item did.
+				* @return bool - false if the Stack was empty.
+			*/
+			bool pop(T &Out)
+			{
+				void *Data;
+
+				if(empty())
+					return false;
+
+				Data = StackPop(Native);
+
+				if(ByValue)
+				{
+					std::memcpy(static_cast<void*>(&Out), &Data, sizeof(T));
+				}
+				else
+				{
+					Out = std::move(*static_cast<T*>(Data));
+
+					Dispose(Data);
+				}
+
+				return true;
+			}
+
+			T &top()
+			{
+				return Element(Slot(TopNode(Native), LastIndex(TopNode(Native))));
+			}
+
+			const T &top() const
+			{
+				return Element(Slot(TopNode(Native), LastIndex(TopNode(Native))));
+			}
+
+			bool empty() const
+			{
+				return Native == (STACK*)NULL || StackIsEmpty(Native);
+			}
+
+			size_type size() const
+			{
+				return Native ? Native->Size : 0;
+			}
+
+			/**
+				* @brief Frees every item.  With USING_STACK_CLEAR_METHOD this is
+				StackClear(), so the STACK's free method is called for a T kept
+				by value and boxes are given back by it when Alloc has no state.
+			*/
+			void clear()
+			{
+				if(Native == (STACK*)NULL)
+					return;
+
+				#if (USING_STACK_CLEAR_METHOD == 1)
+					#if (USING_STACK_DEPENDENT_FREE_METHOD == 1)
+						if(ByValue || FreesBoxes)
+						{
+							StackClear(Native);
+
+							return;
+						}
+					#else
+						if(ByValue)
+						{
+							StackClear(Native);
+
+							return;
+						}
+					#endif // end of USING_STACK_DEPENDENT_FREE_METHOD
+				#endif // end of USING_STACK_CLEAR_METHOD
+
+				while(!empty())
+					pop();
+
+				#if (USING_STACK_CLEAR_METHOD == 1)
+					/*
+						Gives back the node arena and spill file, if there are any.
+					*/
+					StackClear(Native);
+				#endif // end of USING_STACK_CLEAR_METHOD
+			}
+
+			iterator begin()
+			{
+				return iterator(TopNode(Native));
+			}
+
+			iterator end()
+			{
+				return iterator();
+			}
+
+			const_iterator begin() const
+			{
+				return const_iterator(TopNode(Native));
+			}
+
+			const_iterator end() const
+			{
+				return const_iterator();
+			}
+
+			/**
+				* @brief The STACK the items are kept in, NULL if the Stack has
+				been moved from and not pushed onto since.
+			*/
+			STACK *native()
+			{
+				return Native;
+			}
+
+		private:
+			/*
+				Makes the STACK the items are kept in.  Returns false if it
+				couldn't be allocated.
+			*/
+			bool Create()
+			{
+				#if (USING_STACK_CHUNKED_STORAGE == 1)
+					if(ElementsPerNode)
+						Native = CreateChunkedStack((STACK*)NULL, NativeFreeMethod, ElementsPerNode);
+					else
+						Native = CreateStack((STACK*)NULL, NativeFreeMethod);
+				#else
+					Native = CreateStack((STACK*)NULL, NativeFreeMethod);
+				#endif // end of USING_STACK_CHUNKED_STORAGE
+
+				return Native != (STACK*)NULL;
+			}
+
+			/*
+				The slot of Node at Index, counting up from the bottom of
+				the STACK_NODE.
+			*/
+			static void **Slot(STACK_NODE *Node, UINT32 Index)
+			{
+				#if (USING_STACK_CHUNKED_STORAGE == 1)
+					return &Node->Data[Index];
+				#else
+					(void)Index;
+
+					return &Node->Data;
+				#endif // end of USING_STACK_CHUNKED_STORAGE
+			}
+
+			/*
+				The STACK_NODE the top item is in.  StackPop() can leave the
+				top STACK_NODE of a chunked STACK empty, but the ones below
+				it always hold at least one item.  A Stack that has been moved
+				from has no STACK, and no items.
+			*/
+			static STACK_NODE *TopNode(STACK *Stack)
+			{
+				if(Stack == (STACK*)NULL)
+					return (STACK_NODE*)NULL;
+
+				#if (USING_STACK_CHUNKED_STORAGE == 1)
+					if(Stack->TopOfStack != (STACK_NODE*)NULL && Stack->TopOfStack->Count == (UINT32)0)
+						return Stack->TopOfStack->Next;
+				#endif // end of USING_STACK_CHUNKED_STORAGE
+
+				return Stack->TopOfStack;
+			}
+
+			static UINT32 LastIndex(STACK_NODE *Node)
+			{
+				#if (USING_STACK_CHUNKED_STORAGE == 1)
+					return Node->Count - 1;
+				#else
+					(void)Node;
+
+					return 0;
+				#endif // end of USING_STACK_CHUNKED_STORAGE
+			}
+
+			static T &Element(void **Slot)
+			{
+				return ByValue ? *reinterpret_cast<T*>(Slot) : *static_cast<T*>(*Slot);
+			}
+
+			template <typename... Args>
+			bool Emplace(std::true_type, Args&&... Arguments)
+			{
+				T Value(std::forward<Args>(Arguments)...);
+				void *Data;
+
+				Data = nullptr;
+
+				std::memcpy(&Data, static_cast<const void*>(&Value), sizeof(T));
+
+				return StackPush(Native, Data) == (BOOL)TRUE;
+			}
+
+			template <typename... Args>
+			bool Emplace(std::false_type, Args&&... Arguments)
+			{
+				T *Box;
+
+				Box = ElementTraits::allocate(Boxes, 1);
+
+				try
+				{
+					ElementTraits::construct(Boxes, Box, std::forward<Args>(Arguments)...);
+				}
+				catch(...)
+				{
+					ElementTraits::deallocate(Boxes, Box, 1);
+
+					throw;
+				}
+
+				if(StackPush(Native, Box) != (BOOL)TRUE)
+				{
+					Dispose(Box);
+
+					return false;
+				}
+
+				return true;
+			}
+
+			/*
+				Frees an item that was popped off of the STACK.
+			*/
+			void Dispose(void *Data)
+			{
+				if(ByValue)
+				{
+					#if (USING_STACK_DEPENDENT_FREE_METHOD == 1)
+						if(Native->StackFreeMethod)
+							Native->StackFreeMethod(Data);
+					#endif // end of USING_STACK_DEPENDENT_FREE_METHOD
+				}
+				else
+				{
+					ElementTraits::destroy(Boxes, static_cast<T*>(Data));
+					ElementTraits::deallocate(Boxes, static_cast<T*>(Data), 1);
+				}
+			}
+
+			/*
+				The STACK's free method when boxes can be given back by it.
+			*/
+			static void FreeBox(void *Data)
+			{
+				ElementAllocator Allocator;
+
+				ElementTraits::destroy(Allocator, static_cast<T*>(Data));
+				ElementTraits::deallocate(Allocator, static_cast<T*>(Data), 1);
+			}
+
+			typedef void (*FreeMethodPointer)(void *Data);
+
+			static FreeMethodPointer BoxFreeMethod(std::true_type)
+			{
+				return FreeBox;
+			}
+
+			static FreeMethodPointer BoxFreeMethod(std::false_type)
+			{
+				return nullptr;
+			}
+
+			void Destroy()
+			{
+				if(Native == (STACK*)NULL)
+					return;
+
+				clear();
+
+				#if (USING_STACK_NODE_CACHE == 1) || (USING_STACK_NODE_ARENA == 1)
+					StackShrink(Native);
+				#endif // end of USING_STACK_NODE_CACHE or USING_STACK_NODE_ARENA
+
+				StackMemDealloc((void*)Native);
+
+				Native = (STACK*)NULL;
+			}
+
+			STACK *Native;
+			ElementAllocator Boxes;
+
+			/*
+				What each new STACK is made with, so a Stack that has been
+				moved from can make another one.
+			*/
+			FreeMethodPointer NativeFreeMethod;
+
+			#if (USING_STACK_CHUNKED_STORAGE == 1)
+				UINT32 ElementsPerNode;
+			#endif // end of USING_STACK_CHUNKED_STORAGE
+	};
+}
+
+#endif // end of STACK_HPP
@@ -0,0 +1,560 @@
+/*
+	Date: March 26, 2011
+	File Name: StackAllocators.c
+	Version: 1.05
+	IDE: Visual Studio 2010 Professional
+	Compiler: C89
+
+	Description:
+	This file contains all the code which comprises
+	the built in STACK_ALLOCATOR's.  For method
+	descriptions see StackAllocators.h.
+*/
+
+#include "StackAllocators.h"
+
+#if (USING_STACK_ALLOCATORS == 1)
+
+#if (USE_MALLOC == 1)
+	#include "stdlib.h"
+#endif // end of USE_MALLOC
+
+#include "unistd.h"
+#include "sys/mman.h"
+#include "sys/syscall.h"
+
+/*
+	The memory policy mbind() is asked for, which prefers the node but
+	falls back to any other when it is out of memory, and the most
+	nodes the node mask handed to it covers.
+*/
+#define STACK_MPOL_PREFERRED					1
+#define STACK_NUMA_MAX_NODES					1024
+
+/*
+	The number of size classes an arena has.
+*/
+#define StackAllocatorSizeClasses				(STACK_ALLOCATOR_MAX_OBJECT_SIZE / STACK_ALLOCATOR_ALIGNMENT)
+
+/*
+	Rounds Size up to a multiple of Alignment, which must be a power of 2.
+*/
+#define StackAllocatorRoundUp(Size, Alignment)	(((Size) + ((Alignment) - 1)) & ~((UINT64)(Alignment) - 1))
+
+/*
+	The number of bytes at the start of each block taken up by its
+	STACK_ALLOCATOR_BLOCK.
+*/
+#define StackAllocatorHeaderSizeInBytes			(UINT32)StackAllocatorRoundUp(sizeof(STACK_ALLOCATOR_BLOCK), STACK_ALLOCATOR_ALIGNMENT)
+
+/*
+	The block a piece of memory from an arena was carved out of.
+*/
+#define StackAllocatorBlockOf(Memory)			((STACK_ALLOCATOR_BLOCK*)((size_t)(Memory) & ~((size_t)STACK_ALLOCATOR_BLOCK_SIZE - 1)))
+
+/*
+	Put on the RemoteFreeObjects of a thread local arena whose thread has
+	exited, which no real piece of memory can be mistaken for.
+*/
+#define STACK_ALLOCATOR_ORPHANED				((void*)(size_t)1)
+
+/*
+	The calling thread's arena, made the first time it allocates.  It is
+	also kept under StackThreadArenaKey, so StackThreadLocalArenaExit()
+	is called with it when the thread exits.
+*/
+static StackThreadLocal STACK_ALLOCATOR_ARENA *StackThreadArena = (STACK_ALLOCATOR_ARENA*)NULL;
+static pthread_once_t StackThreadArenaOnce = PTHREAD_ONCE_INIT;
+static pthread_key_t StackThreadArenaKey;
+static BOOL StackThreadArenaKeyMade = (BOOL)FALSE;
+
+/*
+	Maps Size bytes starting on a multiple of STACK_ALLOCATOR_BLOCK_SIZE,
+	asking for them to be on Node unless it is -1.  Returns NULL if mmap()
+	failed.
+*/
+static void *StackAllocatorMap(UINT64 Size, int Node)
+{
+	BYTE *Map, *Block;
+	UINT64 Extra;
+
+	/*
+		Map a block's worth more than needed and trim off the ends, so
+		what is left starts on a block boundary.
+	*/
+	if((Map = (BYTE*)mmap((void*)NULL, (size_t)(Size + STACK_ALLOCATOR_BLOCK_SIZE), PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, (off_t)0)) == (BYTE*)MAP_FAILED)
+		return (void*)NULL;
+
+	Block = (BYTE*)StackAllocatorRoundUp((size_t)Map, STACK_ALLOCATOR_BLOCK_SIZE);
+
+	if((Extra = (UINT64)(Block - Map)) != (UINT64)0)
+		munmap((void*)Map, (size_t)Extra);
+
+	if((Extra = (UINT64)STACK_ALLOCATOR_BLOCK_SIZE - Extra) != (UINT64)0)
+		munmap((void*)(Block + Size), (size_t)Extra);
+
+	/*
+		Nothing has touched the pages yet, so they are placed on Node as
+		they are first used.  If mbind() fails the memory is still good,
+		just not placed.
+	*/
+	if(Node >= 0 && Node < STACK_NUMA_MAX_NODES)
+	{
+		unsigned long NodeMask[STACK_NUMA_MAX_NODES / (8 * sizeof(unsigned long))];
+		UINT32 i;
+
+		for(i = (UINT32)0; i < (UINT32)(sizeof(NodeMask) / sizeof(unsigned long)); i++)
+			NodeMask[i] = 0UL;
+
+		NodeMask[Node / (8 * sizeof(unsigned long))] = 1UL << (Node % (8 * sizeof(unsigned long)));
+
+		syscall(SYS_mbind, (void*)Block, (unsigned long)Size, STACK_MPOL_PREFERRED, NodeMask, (unsigned long)STACK_NUMA_MAX_NODES + 1, 0U);
+	}
+
+	return (void*)Block;
+}
+
+/*
+	Sets up an empty arena.
+*/
+static void StackAllocatorArenaInit(STACK_ALLOCATOR_ARENA *Arena, int Node, BOOL Shared)
+{
+	UINT32 i;
+
+	Arena->Blocks = (STACK_ALLOCATOR_BLOCK*)NULL;
+
+	for(i = (UINT32)0; i < (UINT32)StackAllocatorSizeClasses; i++)
+	{
+		Arena->FreeObjects[i] = (void*)NULL;
+		Arena->Next[i] = (BYTE*)NULL;
+		Arena->BytesLeft[i] = (UINT32)0;
+	}
+
+	Arena->RemoteFreeObjects = (void*)NULL;
+	Arena->LiveObjects = (UINT32)0;
+	Arena->OrphanedObjects = (UINT32)0;
+	Arena->Node = Node;
+	Arena->Shared = (BOOL)Shared;
+}
+
+/*
+	Maps a new block of Size bytes for the arena.  ObjectSize is the size
+	of the memory that will be carved out of it, or 0 if the block is for
+	one allocation of its own.
+*/
+static STACK_ALLOCATOR_BLOCK *StackAllocatorAddBlock(STACK_ALLOCATOR_ARENA *Arena, UINT64 Size, UINT32 ObjectSize)
+{
+	STACK_ALLOCATOR_BLOCK *Block;
+
+	if((Block = (STACK_ALLOCATOR_BLOCK*)StackAllocatorMap(Size, Arena->Node)) == (STACK_ALLOCATOR_BLOCK*)NULL)
+		return (STACK_ALLOCATOR_BLOCK*)NULL;
+
+	Block->Arena = (STACK_ALLOCATOR_ARENA*)Arena;
+	Block->ObjectSize = (UINT32)ObjectSize;
+	Block->SizeInBytes = (UINT64)Size;
+	Block->Previous = (STACK_ALLOCATOR_BLOCK*)NULL;
+	Block->Next = (STACK_ALLOCATOR_BLOCK*)(Arena->Blocks);
+
+	if(Arena->Blocks != (STACK_ALLOCATOR_BLOCK*)NULL)
+		Arena->Blocks->Previous = (STACK_ALLOCATOR_BLOCK*)Block;
+
+	Arena->Blocks = (STACK_ALLOCATOR_BLOCK*)Block;
+
+	return (STACK_ALLOCATOR_BLOCK*)Block;
+}
+
+/*
+	Gives memory back to the arena it came from.  Must be called by the
+	thread that owns the arena, or with its lock held.
+*/
+static void StackAllocatorArenaFree(STACK_ALLOCATOR_ARENA *Arena, void *Memory)
+{
+	STACK_ALLOCATOR_BLOCK *Block;
+	UINT32 SizeClass;
+
+	Block = (STACK_ALLOCATOR_BLOCK*)StackAllocatorBlockOf(Memory);
+
+	/*
+		A block of its own is unmapped right away.
+	*/
+	if(Block->ObjectSize == (UINT32)0)
+	{
+		Arena->LiveObjects--;
+
+		if(Block->Previous != (STACK_ALLOCATOR_BLOCK*)NULL)
+			Block->Previous->Next = (STACK_ALLOCATOR_BLOCK*)(Block->Next);
+		else
+			Arena->Blocks = (STACK_ALLOCATOR_BLOCK*)(Block->Next);
+
+		if(Block->Next != (STACK_ALLOCATOR_BLOCK*)NULL)
+			Block->Next->Previous = (STACK_ALLOCATOR_BLOCK*)(Block->Previous);
+
+		munmap((void*)Block, (size_t)(Block->SizeInBytes));
+
+		return;
+	}
+
+	Arena->LiveObjects--;
+
+	SizeClass = (UINT32)(Block->ObjectSize / STACK_ALLOCATOR_ALIGNMENT - 1);
+
+	*(void**)Memory = Arena->FreeObjects[SizeClass];
+	Arena->FreeObjects[SizeClass] = Memory;
+}
+
+/*
+	Takes Size bytes out of the arena.  Must be called by the thread that
+	owns the arena, or with its lock held.
+*/
+static void *StackAllocatorArenaAlloc(STACK_ALLOCATOR_ARENA *Arena, UINT32 Size)
+{
+	STACK_ALLOCATOR_BLOCK *Block;
+	UINT32 SizeClass, ObjectSize;
+	void *Memory, *Next;
+
+	if(Size == (UINT32)0)
+		Size = (UINT32)1;
+
+	/*
+		Too big to share a block, so it gets one of its own.
+	*/
+	if(Size > (UINT32)STACK_ALLOCATOR_MAX_OBJECT_SIZE)
+	{
+		if((Block = (STACK_ALLOCATOR_BLOCK*)StackAllocatorAddBlock(Arena, StackAllocatorRoundUp((UINT64)StackAllocatorHeaderSizeInBytes + Size, sysconf(_SC_PAGESIZE)), (UINT32)0)) == (STACK_ALLOCATOR_BLOCK*)NULL)
+			return (void*)NULL;
+
+		Arena->LiveObjects++;
+
+		return (void*)((BYTE*)Block + StackAllocatorHeaderSizeInBytes);
+	}
+
+	SizeClass = (UINT32)((Size + STACK_ALLOCATOR_ALIGNMENT - 1) / STACK_ALLOCATOR_ALIGNMENT - 1);
+	ObjectSize = (UINT32)((SizeClass + 1) * STACK_ALLOCATOR_ALIGNMENT);
+
+	/*
+		Before carving out anything new, take back whatever other threads
+		have freed.
+	*/
+	if(Arena->FreeObjects[SizeClass] == (void*)NULL && StackAtomicLoad(&Arena->RemoteFreeObjects) != (void*)NULL)
+	{
+		Memory = (void*)StackAtomicExchange(&Arena->RemoteFreeObjects, (void*)NULL);
+
+		while(Memory != (void*)NULL)
+		{
+			Next = *(void**)Memory;
+
+			StackAllocatorArenaFree(Arena, Memory);
+
+			Memory = Next;
+		}
+	}
+
+	if((Memory = Arena->FreeObjects[SizeClass]) != (void*)NULL)
+	{
+		Arena->FreeObjects[SizeClass] = *(void**)Memory;
+		Arena->LiveObjects++;
+
+		return (void*)Memory;
+	}
+
+	if(Arena->BytesLeft[SizeClass] < ObjectSize)
+	{
+		if((Block = (STACK_ALLOCATOR_BLOCK*)StackAllocatorAddBlock(Arena, (UINT64)STACK_ALLOCATOR_BLOCK_SIZE, ObjectSize)) == (STACK_ALLOCATOR_BLOCK*)NULL)
+			return (void*)NULL;
+
+		Arena->Next[SizeClass] = (BYTE*)Block + StackAllocatorHeaderSizeInBytes;
+		Arena->BytesLeft[SizeClass] = (UINT32)(STACK_ALLOCATOR_BLOCK_SIZE - StackAllocatorHeaderSizeInBytes);
+	}
+
+	Memory = (void*)(Arena->Next[SizeClass]);
+	Arena->Next[SizeClass] += ObjectSize;
+	Arena->BytesLeft[SizeClass] -= ObjectSize;
+	Arena->LiveObjects++;
+
+	return (void*)Memory;
+}
+
+/*
+	Unmaps every block of the arena.
+*/
+static void StackAllocatorArenaRelease(STACK_ALLOCATOR_ARENA *Arena)
+{
+	STACK_ALLOCATOR_BLOCK *Block;
+
+	while((Block = (STACK_ALLOCATOR_BLOCK*)(Arena->Blocks)) != (STACK_ALLOCATOR_BLOCK*)NULL)
+	{
+		Arena->Blocks = (STACK_ALLOCATOR_BLOCK*)(Block->Next);
+
+		munmap((void*)Block, (size_t)(Block->SizeInBytes));
+	}
+
+	StackAllocatorArenaInit(Arena, Arena->Node, Arena->Shared);
+}
+
+/*
+	The Alloc and Free of the STACK_ALLOCATOR StackGetNumaAllocator()
+	fills in.  Context is the arena.
+*/
+static void *StackNumaAlloc(void *Context, UINT32 Size)
+{
+	STACK_ALLOCATOR_ARENA *Arena;
+	void *Memory;
+
+	Arena = (STACK_ALLOCATOR_ARENA*)Context;
+
+	pthread_mutex_lock(&Arena->Lock);
+
+	Memory = (void*)StackAllocatorArenaAlloc(Arena, Size);
+
+	pthread_mutex_unlock(&Arena->Lock);
+
+	return (void*)Memory;
+}
+
+static void StackNumaFree(void *Context, void *Memory)
+{
+	STACK_ALLOCATOR_ARENA *Arena;
+
+	if(Memory == (void*)NULL)
+		return;
+
+	Arena = (STACK_ALLOCATOR_ARENA*)Context;
+
+	pthread_mutex_lock(&Arena->Lock);
+
+	StackAllocatorArenaFree(Arena, Memory);
+
+	pthread_mutex_unlock(&Arena->Lock);
+}
+
+/*
+	Counts one piece of memory of an arena whose thread has exited as 
+	back, and releases the arena once none are left out.
+*/
+static void StackThreadLocalArenaPut(STACK_ALLOCATOR_ARENA *Arena)
+{
+	if(StackAtomicAdd(&Arena->OrphanedObjects, (UINT32)0xFFFFFFFF) == (UINT32)0)
+	{
+		StackAllocatorArenaRelease(Arena);
+
+		StackMemDealloc((void*)Arena);
+	}
+}
+
+/*
+	Called with a thread's arena when the thread exits.  Memory other
+	threads still have can't be unmapped under them, so the arena counts
+	it back in as it is freed and is released after the last of it.
+*/
+static void StackThreadLocalArenaExit(void *Argument)
+{
+	STACK_ALLOCATOR_ARENA *Arena;
+	void *Memory, *Next;
+
+	Arena = (STACK_ALLOCATOR_ARENA*)Argument;
+
+	/*
+		Anything the thread still frees on its way out now goes the 
+		remote way.
+	*/
+	StackThreadArena = (STACK_ALLOCATOR_ARENA*)NULL;
+
+	/*
+		Holding one count of its own keeps a thread freeing the last 
+		piece from releasing the arena before it is all counted.  Once 
+		the marker is in, other threads count their frees right away 
+		instead of pushing them, so what was pushed before is all there
+		is left to count.
+	*/
+	StackAtomicStore(&Arena->OrphanedObjects, (UINT32)(Arena->LiveObjects + 1));
+
+	Memory = (void*)StackAtomicExchange(&Arena->RemoteFreeObjects, STACK_ALLOCATOR_ORPHANED);
+
+	while(Memory != (void*)NULL)
+	{
+		Next = *(void**)Memory;
+
+		StackThreadLocalArenaPut(Arena);
+
+		Memory = Next;
+	}
+
+	StackThreadLocalArenaPut(Arena);
+}
+
+static void StackThreadArenaMakeKey(void)
+{
+	StackThreadArenaKeyMade = (BOOL)(pthread_key_create(&StackThreadArenaKey, StackThreadLocalArenaExit) == 0);
+}
+
+/*
+	The Alloc and Free of the STACK_ALLOCATOR StackGetThreadLocalAllocator()
+	fills in.  Context isn't used, the arena is the calling thread's.
+*/
+static void *StackThreadLocalAlloc(void *Context, UINT32 Size)
+{
+	(void)Context;
+
+	if(StackThreadArena == (STACK_ALLOCATOR_ARENA*)NULL)
+	{
+		if((StackThreadArena = (STACK_ALLOCATOR_ARENA*)StackMemAlloc(sizeof(STACK_ALLOCATOR_ARENA))) == (STACK_ALLOCATOR_ARENA*)NULL)
+			return (void*)NULL;
+
+		StackAllocatorArenaInit(StackThreadArena, -1, (BOOL)FALSE);
+
+		/*
+			Without the key the arena is just never released.
+		*/
+		pthread_once(&StackThreadArenaOnce, StackThreadArenaMakeKey);
+
+		if(StackThreadArenaKeyMade)
+			pthread_setspecific(StackThreadArenaKey, (const void*)StackThreadArena);
+	}
+
+	return StackAllocatorArenaAlloc(StackThreadArena, Size);
+}
+
+static void StackThreadLocalFree(void *Context, void *Memory)
+{
+	STACK_ALLOCATOR_ARENA *Arena;
+	void *Head;
+
+	(void)Context;
+
+	if(Memory == (void*)NULL)
+		return;
+
+	Arena = (STACK_ALLOCATOR_ARENA*)(StackAllocatorBlockOf(Memory)->Arena);
+
+	if(Arena == StackThreadArena)
+	{
+		StackAllocatorArenaFree(Arena, Memory);
+
+		return;
+	}
+
+	/*
+		The memory belongs to another thread's arena, so push it on that
+		arena's list of remote frees for its thread to pick up.  If that
+		thread has exited the memory is counted back in instead.
+	*/
+	do
+	{
+		if((Head = (void*)StackAtomicLoad(&Arena->RemoteFreeObjects)) == STACK_ALLOCATOR_ORPHANED)
+		{
+			StackThreadLocalArenaPut(Arena);
+
+			return;
+		}
+
+		*(void**)Memory = Head;
+	}while(!StackAtomicCompareAndSwap(&Arena->RemoteFreeObjects, Head, Memory));
+}
+
+int StackGetCurrentNumaNode(void)
+{
+	unsigned int Cpu, Node;
+
+	if(syscall(SYS_getcpu, &Cpu, &Node, (void*)NULL) != 0)
+		return 0;
+
+	return (int)Node;
+}
+
+STACK_ALLOCATOR_ARENA *CreateNumaAllocatorArena(STACK_ALLOCATOR_ARENA *Arena, int Node)
+{
+	BOOL Allocated;
+
+	Allocated = (BOOL)FALSE;
+
+	/*
+		If Arena is equal to (STACK_ALLOCATOR_ARENA*)NULL then the user
+		wants to create a new arena in memory
+	*/
+	if(Arena == (STACK_ALLOCATOR_ARENA*)NULL)
+	{
+		if((Arena = (STACK_ALLOCATOR_ARENA*)StackMemAlloc(sizeof(STACK_ALLOCATOR_ARENA))) == (STACK_ALLOCATOR_ARENA*)NULL)
+		{
+			return (STACK_ALLOCATOR_ARENA*)NULL;
+		}
+
+		Allocated = (BOOL)TRUE;
+	}
+
+	if(Node < 0)
+		Node = StackGetCurrentNumaNode();
+
+	if(pthread_mutex_init(&Arena->Lock, NULL))
+	{
+		if(Allocated)
+			StackMemDealloc((void*)Arena);
+
+		return (STACK_ALLOCATOR_ARENA*)NULL;
+	}
+
+	StackAllocatorArenaInit(Arena, Node, (BOOL)TRUE);
+
+	return (STACK_ALLOCATOR_ARENA*)Arena;
+}
+
+BOOL StackGetNumaAllocator(STACK_ALLOCATOR_ARENA *Arena, STACK_ALLOCATOR *Allocator)
+{
+	#if (STACK_SAFE_MODE == 1)
+		if(Arena == (STACK_ALLOCATOR_ARENA*)NULL || Allocator == (STACK_ALLOCATOR*)NULL)
+			return (BOOL)FALSE;
+	#endif // end of STACK_SAFE_MODE
+
+	Allocator->Alloc = StackNumaAlloc;
+	Allocator->Free = StackNumaFree;
+	Allocator->Context = (void*)Arena;
+
+	return (BOOL)TRUE;
+}
+
+BOOL DestroyAllocatorArena(STACK_ALLOCATOR_ARENA *Arena)
+{
+	#if (STACK_SAFE_MODE == 1)
+		if(Arena == (STACK_ALLOCATOR_ARENA*)NULL)
+			return (BOOL)FALSE;
+	#endif // end of STACK_SAFE_MODE
+
+	StackAllocatorArenaRelease(Arena);
+
+	if(Arena->Shared)
+		pthread_mutex_destroy(&Arena->Lock);
+
+	return (BOOL)TRUE;
+}
+
+BOOL StackGetThreadLocalAllocator(STACK_ALLOCATOR *Allocator)
+{
+	#if (STACK_SAFE_MODE == 1)
+		if(Allocator == (STACK_ALLOCATOR*)NULL)
+			return (BOOL)FALSE;
+	#endif // end of STACK_SAFE_MODE
+
+	Allocator->Alloc = StackThreadLocalAlloc;
+	Allocator->Free = StackThreadLocalFree;
+	Allocator->Context = (void*)NULL;
+
+	return (BOOL)TRUE;
+}
+
+BOOL StackReleaseThreadLocalArena(void)
+{
+	if(StackThreadArena == (STACK_ALLOCATOR_ARENA*)NULL)
+		return (BOOL)FALSE;
+
+	StackAllocatorArenaRelease(StackThreadArena);
+
+	StackMemDealloc((void*)StackThreadArena);
+
+	StackThreadArena = (STACK_ALLOCATOR_ARENA*)NULL;
+
+	if(StackThreadArenaKeyMade)
+		pthread_setspecific(StackThreadArenaKey, (const void*)NULL);
+
+	return (BOOL)TRUE;
+}
+
+#endif // end of USING_STACK_ALLOCATORS
@@ -0,0 +1,199 @@
+/*
+	Date: March 26, 2011
+	File Name: StackAllocators.h
+	Version: 1.05
+	IDE: Visual Studio 2010 Professional
+	Compiler: C89
+
+	Description:
+	This file contains all the method headers for the built in
+	STACK_ALLOCATOR's a STACK can be given with CreateStackWithAllocator()
+	or StackSetAllocator().  One places memory on a chosen NUMA node, the
+	other gives each thread its own arena that it uses without a lock.
+	All methods have their documentation above their declaration.
+*/
+
+#ifndef STACK_ALLOCATORS_H
+	#define STACK_ALLOCATORS_H
+
+#include "GenericTypeDefs.h"
+#include "StackConfig.h"
+#include "StackObject.h"
+
+#if (USING_STACK_ALLOCATORS == 1)
+
+/*
+	Function: int StackGetCurrentNumaNode(void)
+
+	Parameters:
+		None
+
+	Returns:
+		int - The NUMA node of the CPU the calling thread is running on, or
+		0 if it couldn't be found out.
+
+	Description: Returns the NUMA node the calling thread is on right now.
+	The thread may be moved to another node afterwards unless it is pinned.
+
+	Notes: USING_STACK_ALLOCATORS in StackConfig.h must be defined as 1 to use method.
+*/
+/**
+		* @brief Will return the NUMA node the calling thread is running on.
+		* @return int - The NUMA node.
+		* @note USING_STACK_ALLOCATORS in StackConfig.h must be defined as 1 to use method.
+		* @sa CreateNumaAllocatorArena()
+		* @since v1.05
+*/
+int StackGetCurrentNumaNode(void);
+
+/*
+	Function: STACK_ALLOCATOR_ARENA *CreateNumaAllocatorArena(STACK_ALLOCATOR_ARENA *Arena, int Node)
+
+	Parameters:
+		STACK_ALLOCATOR_ARENA *Arena - The address at which the arena will
+		be inititalized.  If NULL is passed in then this method will create
+		an arena out of the heap with a call to StackMemAlloc().
+
+		int Node - The NUMA node the arena's memory is placed on.  -1 for
+		the node of the calling thread.
+
+	Returns:
+		STACK_ALLOCATOR_ARENA* - The address at which the arena resides in
+		memory.  (STACK_ALLOCATOR_ARENA*)NULL if it couldn't be made.
+
+	Description: Creates an empty arena whose blocks are mapped with mmap()
+	and asked to be placed on Node with mbind().  If Node is out of memory,
+	or the system has no NUMA, the memory comes from wherever the kernel
+	finds it.  Any number of threads and STACK's can share the arena, it
+	is locked around every use.
+
+	Notes: USING_STACK_ALLOCATORS in StackConfig.h must be defined as 1 to use method.
+*/
+/**
+		* @brief Creates an arena that places its memory on a NUMA node.
+		* @param *Arena - A pointer to an already allocate STACK_ALLOCATOR_ARENA
+		or a NULL pointer to create one from StackMemAlloc().
+		* @param Node - The NUMA node, or -1 for the calling thread's.
+		* @return *STACK_ALLOCATOR_ARENA - The address of the arena in memory.  If
+		it could not be made, returns a NULL pointer.
+		* @note USING_STACK_ALLOCATORS in StackConfig.h must be defined as 1 to use method.
+		* @sa StackGetNumaAllocator(), DestroyAllocatorArena()
+		* @since v1.05
+*/
+STACK_ALLOCATOR_ARENA *CreateNumaAllocatorArena(STACK_ALLOCATOR_ARENA *Arena, int Node);
+
+/*
+	Function: BOOL StackGetNumaAllocator(STACK_ALLOCATOR_ARENA *Arena, STACK_ALLOCATOR *Allocator)
+
+	Parameters:
+		STACK_ALLOCATOR_ARENA *Arena - An arena made with CreateNumaAllocatorArena().
+		STACK_ALLOCATOR *Allocator - Filled in with an allocator that uses Arena.
+
+	Returns:
+		BOOL - TRUE if Allocator was filled in, FALSE if either was NULL.
+
+	Description: Fills in a STACK_ALLOCATOR to hand to
+	CreateStackWithAllocator() or StackSetAllocator(), so the STACK_NODE's
+	of the STACK are placed on the arena's NUMA node.
+
+	Notes: USING_STACK_ALLOCATORS in StackConfig.h must be defined as 1 to use method.
+*/
+/**
+		* @brief Fills in a STACK_ALLOCATOR that takes memory from a NUMA arena.
+		* @param *Arena - The arena to take memory from.
+		* @param *Allocator - The STACK_ALLOCATOR to fill in.
+		* @return BOOL - TRUE if successful, FALSE otherwise.
+		* @note USING_STACK_ALLOCATORS in StackConfig.h must be defined as 1 to use method.
+		* @sa CreateStackWithAllocator()
+		* @since v1.05
+*/
+BOOL StackGetNumaAllocator(STACK_ALLOCATOR_ARENA *Arena, STACK_ALLOCATOR *Allocator);
+
+/*
+	Function: BOOL DestroyAllocatorArena(STACK_ALLOCATOR_ARENA *Arena)
+
+	Parameters:
+		STACK_ALLOCATOR_ARENA *Arena - An arena made with CreateNumaAllocatorArena().
+
+	Returns:
+		BOOL - TRUE if the arena was destroyed.
+		FALSE - If a NULL referenced arena was passed in.
+
+	Description: Unmaps every block of the arena at once.  The
+	STACK_ALLOCATOR_ARENA structure will still exist.
+
+	Notes: No STACK may still be using memory from the arena, so each one
+	should be cleared first.  USING_STACK_ALLOCATORS in StackConfig.h must
+	be defined as 1 to use method.
+*/
+/**
+		* @brief Unmaps all the memory of an arena.
+		* @param *Arena - The arena to destroy.
+		* @return BOOL - TRUE if successful, FALSE if the arena was NULL.
+		* @note USING_STACK_ALLOCATORS in StackConfig.h must be defined as 1 to use method.
+		* @sa CreateNumaAllocatorArena()
+		* @since v1.05
+*/
+BOOL DestroyAllocatorArena(STACK_ALLOCATOR_ARENA *Arena);
+
+/*
+	Function: BOOL StackGetThreadLocalAllocator(STACK_ALLOCATOR *Allocator)
+
+	Parameters:
+		STACK_ALLOCATOR *Allocator - Filled in with the thread local allocator.
+
+	Returns:
+		BOOL - TRUE if Allocator was filled in, FALSE if it was NULL.
+
+	Description: Fills in a STACK_ALLOCATOR that takes memory from an arena
+	of the thread that calls Alloc, made the first time the thread needs
+	it.  The thread uses its arena without a lock or an atomic operation.
+	Memory freed by another thread is handed back to the thread it came
+	from with a single compare and swap, and put on that thread's free
+	lists the next time it allocates.  The pages of a thread's arena are
+	first touched by that thread, so they are also on its NUMA node.
+	When a thread exits its arena is released, or if other threads still
+	have memory from it, released by whichever thread frees the last of
+	that memory.
+
+	Notes: USING_STACK_ALLOCATORS in StackConfig.h must be defined as 1 to use method.
+*/
+/**
+		* @brief Fills in a STACK_ALLOCATOR that takes memory from the calling thread's arena.
+		* @param *Allocator - The STACK_ALLOCATOR to fill in.
+		* @return BOOL - TRUE if successful, FALSE otherwise.
+		* @note USING_STACK_ALLOCATORS in StackConfig.h must be defined as 1 to use method.
+		* @sa CreateStackWithAllocator(), StackReleaseThreadLocalArena()
+		* @since v1.05
+*/
+BOOL StackGetThreadLocalAllocator(STACK_ALLOCATOR *Allocator);
+
+/*
+	Function: BOOL StackReleaseThreadLocalArena(void)
+
+	Parameters:
+		None
+
+	Returns:
+		BOOL - TRUE if the calling thread had an arena and it was released.
+
+	Description: Unmaps every block of the calling thread's arena now,
+	instead of when the thread exits.  The thread gets a new arena the
+	next time it allocates.
+
+	Notes: No thread may still be using memory from the arena.
+	USING_STACK_ALLOCATORS in StackConfig.h must be defined as 1 to use
+	method.
+*/
+/**
+		* @brief Unmaps all the memory of the calling thread's arena.
+		* @return BOOL - TRUE if there was an arena to release.
+		* @note USING_STACK_ALLOCATORS in StackConfig.h must be defined as 1 to use method.
+		* @sa StackGetThreadLocalAllocator()
+		* @since v1.05
+*/
+BOOL StackReleaseThreadLocalArena(void);
+
+#endif // end of USING_STACK_ALLOCATORS
+
+#endif // end of STACK_ALLOCATORS_H
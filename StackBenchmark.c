@@ -0,0 +1,542 @@
+/*
+	Date: March 26, 2011
+	File Name: StackBenchmark.c
+	Version: 1.05
+	IDE: Visual Studio 2010 Professional
+	Compiler: C89
+
+	Description:
+	This file is a stand alone benchmark for the Stack library.  It
+	times StackPush, StackPop, StackPeek and StackClear on STACK's of
+	10 up to MaxElements items (powers of 10), a push then a pop on an
+	empty STACK over and over, single threaded and with
+	a mutex wrapped STACK shared by 1 up to MaxThreads threads, and
+	prints the results as JSON on stdout.
+
+	Each run reports the StackConfig.h options it was built with, so
+	comparing configurations is a matter of rebuilding this file with
+	Stack.c for each configuration and keeping the JSON of each run.
+	"make bench" does that for every configuration listed in the 
+	Makefile.  By hand on Linux:
+
+		gcc -O2 -DUSING_STACK_NODE_ARENA=1 Stack.c StackBenchmark.c -o StackBenchmark -lpthread
+		./StackBenchmark 100000000 8 > results.json
+
+	MaxElements defaults to 1000000 and MaxThreads to 4.  Latency
+	percentiles come from timing every STACK_BENCHMARK_SAMPLE_PERIOD'th
+	call on its own, in the multi threaded runs too.  This file needs 
+	POSIX threads and clock_gettime().
+*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <pthread.h>
+
+#include "Stack.h"
+
+#if (USING_STACK_PEEK_METHOD != 1) || (USING_STACK_CLEAR_METHOD != 1)
+	#error "StackBenchmark.c needs USING_STACK_PEEK_METHOD and USING_STACK_CLEAR_METHOD defined as 1"
+#endif
+
+/*
+	Every this many calls, one is timed on its own for the latency
+	percentiles.
+*/
+#define STACK_BENCHMARK_SAMPLE_PERIOD					64
+
+/*
+	Small STACK sizes are repeated until at least this many calls have
+	been timed, so the totals are not just timer noise.
+*/
+#define STACK_BENCHMARK_MIN_OPERATIONS					1000000
+
+/*
+	The number of push/pop pairs each thread does in the multi threaded
+	runs.
+*/
+#define STACK_BENCHMARK_THREAD_OPERATIONS				1000000
+
+/*
+	The latency samples taken for one method.
+*/
+typedef struct _StackBenchmarkSamples
+{
+	UINT64 *Samples;
+	UINT32 Count;
+	UINT32 Size;
+}STACK_BENCHMARK_SAMPLES;
+
+/*
+	What each thread of a multi threaded run shares.
+*/
+typedef struct _StackBenchmarkShared
+{
+	STACK *Stack;
+	pthread_mutex_t Mutex;
+	UINT32 Operations;
+}STACK_BENCHMARK_SHARED;
+
+/*
+	One thread of a multi threaded run, with the latency samples it
+	takes.
+*/
+typedef struct _StackBenchmarkThread
+{
+	STACK_BENCHMARK_SHARED *Shared;
+	STACK_BENCHMARK_SAMPLES Samples;
+	pthread_t Id;
+}STACK_BENCHMARK_THREAD;
+
+static UINT64 StackBenchmarkNow(void)
+{
+	struct timespec Time;
+
+	clock_gettime(CLOCK_MONOTONIC, &Time);
+
+	return (UINT64)Time.tv_sec * (UINT64)1000000000 + (UINT64)Time.tv_nsec;
+}
+
+static void StackBenchmarkAddSample(STACK_BENCHMARK_SAMPLES *Samples, UINT64 Nanoseconds)
+{
+	if(Samples->Count < Samples->Size)
+		Samples->Samples[Samples->Count++] = Nanoseconds;
+}
+
+static int StackBenchmarkCompare(const void *A, const void *B)
+{
+	UINT64 a, b;
+
+	a = *(const UINT64*)A;
+	b = *(const UINT64*)B;
+
+	return (a > b) - (a < b);
+}
+
+/*
+	Prints the latency percentiles of Samples as a JSON object, and
+	empties Samples for the next method.
+*/
+static void StackBenchmarkPrintLatency(STACK_BENCHMARK_SAMPLES *Samples)
+{
+	UINT64 P50, P90, P99, P999, Max;
+
+	P50 = P90 = P99 = P999 = Max = (UINT64)0;
+
+	if(Samples->Count)
+	{
+		qsort(Samples->Samples, Samples->Count, sizeof(UINT64), StackBenchmarkCompare);
+
+		P50 = Samples->Samples[(Samples->Count * 50) / 100];
+		P90 = Samples->Samples[(Samples->Count * 90) / 100];
+		P99 = Samples->Samples[(Samples->Count * 99) / 100];
+		P999 = Samples->Samples[(Samples->Count * 999) / 1000];
+		Max = Samples->Samples[Samples->Count - 1];
+	}
+
+	printf("\"latency_ns\": {\"p50\": %llu, \"p90\": %llu, \"p99\": %llu, \"p999\": %llu, \"max\": %llu}",
+		(unsigned long long)P50, (unsigned long long)P90, (unsigned long long)P99, (unsigned long long)P999, (unsigned long long)Max);
+
+	Samples->Count = (UINT32)0;
+}
+
+/*
+	Prints one method's results as a JSON object.
+*/
+static void StackBenchmarkPrintResult(const char *Method, UINT32 Elements, UINT64 Operations, UINT64 Nanoseconds, STACK_BENCHMARK_SAMPLES *Samples, BOOL Last)
+{
+	printf("    {\"method\": \"%s\", \"elements\": %lu, \"operations\": %llu, \"total_ns\": %llu, \"ops_per_sec\": %.0f, ",
+		Method, (unsigned long)Elements, (unsigned long long)Operations, (unsigned long long)Nanoseconds,
+		Nanoseconds ? ((double)Operations * 1e9) / (double)Nanoseconds : 0.0);
+
+	StackBenchmarkPrintLatency(Samples);
+
+	printf("}%s\n", Last ? "" : ",");
+}
+
+static void StackBenchmarkPrintConfig(void)
+{
+	printf("  \"config\": {\n");
+	printf("    \"STACK_SAFE_MODE\": %d,\n", STACK_SAFE_MODE);
+	printf("    \"USING_STACK_DEPENDENT_FREE_METHOD\": %d,\n", USING_STACK_DEPENDENT_FREE_METHOD);
+	printf("    \"USING_STACK_NODE_CACHE\": %d,\n", USING_STACK_NODE_CACHE);
+	printf("    \"STACK_NODE_CACHE_DEFAULT_LIMIT\": %d,\n", STACK_NODE_CACHE_DEFAULT_LIMIT);
+	printf("    \"USING_STACK_CHUNKED_STORAGE\": %d,\n", USING_STACK_CHUNKED_STORAGE);
+	printf("    \"STACK_DEFAULT_ELEMENTS_PER_NODE\": %d,\n", STACK_DEFAULT_ELEMENTS_PER_NODE);
+	printf("    \"USING_STACK_STATISTICS\": %d,\n", USING_STACK_STATISTICS);
+	printf("    \"USING_STACK_LATENCY_HISTOGRAM\": %d,\n", USING_STACK_LATENCY_HISTOGRAM);
+	printf("    \"USING_STACK_CONCURRENT_METHODS\": %d,\n", USING_STACK_CONCURRENT_METHODS);
+	printf("    \"USING_STACK_ELIMINATION_BACKOFF\": %d,\n", USING_STACK_ELIMINATION_BACKOFF);
+	printf("    \"USING_STACK_NODE_ARENA\": %d,\n", USING_STACK_NODE_ARENA);
+	printf("    \"USING_STACK_HUGE_PAGE_ARENA\": %d,\n", USING_STACK_HUGE_PAGE_ARENA);
+	printf("    \"USING_STACK_INLINE_BUFFER\": %d,\n", USING_STACK_INLINE_BUFFER);
+	printf("    \"sizeof_STACK\": %lu,\n", (unsigned long)sizeof(STACK));
+	printf("    \"sizeof_STACK_NODE\": %lu\n", (unsigned long)sizeof(STACK_NODE));
+	printf("  },\n");
+}
+
+/*
+	Times each method on a STACK of Elements items.
+*/
+static void StackBenchmarkSingleThreaded(UINT32 Elements, STACK_BENCHMARK_SAMPLES *Samples, BOOL Last)
+{
+	STACK Stack;
+	UINT64 Start, PushTime, PopTime, PeekTime, ClearTime, SampleStart;
+	UINT32 Repeats, Operation, r, i;
+	volatile void *Sink;
+
+	Repeats = (UINT32)(STACK_BENCHMARK_MIN_OPERATIONS / Elements);
+
+	if(Repeats == (UINT32)0)
+		Repeats = (UINT32)1;
+
+	CreateStack(&Stack, (void (*)(void*))NULL);
+
+	PushTime = PopTime = PeekTime = ClearTime = (UINT64)0;
+	Operation = (UINT32)0;
+
+	/*
+		StackPush
+	*/
+	for(r = (UINT32)0; r < Repeats; r++)
+	{
+		Start = StackBenchmarkNow();
+
+		for(i = (UINT32)0; i < Elements; i++)
+		{
+			if((Operation++ % STACK_BENCHMARK_SAMPLE_PERIOD) == (UINT32)0)
+			{
+				SampleStart = StackBenchmarkNow();
+				StackPush(&Stack, (void*)&Stack);
+				StackBenchmarkAddSample(Samples, StackBenchmarkNow() - SampleStart);
+			}
+			else
+			{
+				StackPush(&Stack, (void*)&Stack);
+			}
+		}
+
+		PushTime += StackBenchmarkNow() - Start;
+
+		if(r + 1 < Repeats)
+			StackClear(&Stack);
+	}
+
+	StackBenchmarkPrintResult("StackPush", Elements, (UINT64)Elements * Repeats, PushTime, Samples, (BOOL)FALSE);
+
+	/*
+		StackPeek, on the full STACK.
+	*/
+	Start = StackBenchmarkNow();
+
+	for(r = (UINT32)0; r < Repeats; r++)
+	{
+		for(i = (UINT32)0; i < Elements; i++)
+		{
+			if((Operation++ % STACK_BENCHMARK_SAMPLE_PERIOD) == (UINT32)0)
+			{
+				SampleStart = StackBenchmarkNow();
+				Sink = StackPeek(&Stack);
+				StackBenchmarkAddSample(Samples, StackBenchmarkNow() - SampleStart);
+			}
+			else
+			{
+				Sink = StackPeek(&Stack);
+			}
+		}
+	}
+
+	PeekTime = StackBenchmarkNow() - Start;
+
+	StackBenchmarkPrintResult("StackPeek", Elements, (UINT64)Elements * Repeats, PeekTime, Samples, (BOOL)FALSE);
+
+	/*
+		StackPop, refilling the STACK (untimed) between repeats.
+	*/
+	for(r = (UINT32)0; r < Repeats; r++)
+	{
+		if(r)
+		{
+			for(i = (UINT32)0; i < Elements; i++)
+				StackPush(&Stack, (void*)&Stack);
+		}
+
+		Start = StackBenchmarkNow();
+
+		for(i = (UINT32)0; i < Elements; i++)
+		{
+			if((Operation++ % STACK_BENCHMARK_SAMPLE_PERIOD) == (UINT32)0)
+			{
+				SampleStart = StackBenchmarkNow();
+				Sink = StackPop(&Stack);
+				StackBenchmarkAddSample(Samples, StackBenchmarkNow() - SampleStart);
+			}
+			else
+			{
+				Sink = StackPop(&Stack);
+			}
+		}
+
+		PopTime += StackBenchmarkNow() - Start;
+	}
+
+	StackBenchmarkPrintResult("StackPop", Elements, (UINT64)Elements * Repeats, PopTime, Samples, (BOOL)FALSE);
+
+	/*
+		StackClear, each call sampled as it is one call per STACK.
+	*/
+	for(r = (UINT32)0; r < Repeats; r++)
+	{
+		for(i = (UINT32)0; i < Elements; i++)
+			StackPush(&Stack, (void*)&Stack);
+
+		Start = StackBenchmarkNow();
+		StackClear(&Stack);
+		SampleStart = StackBenchmarkNow() - Start;
+
+		ClearTime += SampleStart;
+		StackBenchmarkAddSample(Samples, SampleStart);
+	}
+
+	StackBenchmarkPrintResult("StackClear", Elements, (UINT64)Elements * Repeats, ClearTime, Samples, Last);
+
+	#if (USING_STACK_NODE_CACHE == 1)
+		StackShrink(&Stack);
+	#endif // end of USING_STACK_NODE_CACHE
+
+	(void)Sink;
+}
+
+/*
+	Times pushing onto an empty STACK and popping it empty again, which
+	is where a STACK that gets or frees memory as it goes from and back
+	to empty pays the most.  Each pair is one operation.
+*/
+static void StackBenchmarkEmptyChurn(STACK_BENCHMARK_SAMPLES *Samples)
+{
+	STACK Stack;
+	UINT64 Start, ChurnTime, SampleStart;
+	UINT32 i;
+	volatile void *Sink;
+
+	CreateStack(&Stack, (void (*)(void*))NULL);
+
+	Start = StackBenchmarkNow();
+
+	for(i = (UINT32)0; i < (UINT32)STACK_BENCHMARK_MIN_OPERATIONS; i++)
+	{
+		if((i % STACK_BENCHMARK_SAMPLE_PERIOD) == (UINT32)0)
+		{
+			SampleStart = StackBenchmarkNow();
+			StackPush(&Stack, (void*)&Stack);
+			Sink = StackPop(&Stack);
+			StackBenchmarkAddSample(Samples, StackBenchmarkNow() - SampleStart);
+		}
+		else
+		{
+			StackPush(&Stack, (void*)&Stack);
+			Sink = StackPop(&Stack);
+		}
+	}
+
+	ChurnTime = StackBenchmarkNow() - Start;
+
+	StackBenchmarkPrintResult("StackPushPopEmpty", (UINT32)0, (UINT64)STACK_BENCHMARK_MIN_OPERATIONS, ChurnTime, Samples, (BOOL)FALSE);
+
+	StackClear(&Stack);
+
+	#if (USING_STACK_NODE_CACHE == 1)
+		StackShrink(&Stack);
+	#endif // end of USING_STACK_NODE_CACHE
+
+	(void)Sink;
+}
+
+/*
+	Each thread of a multi threaded run pushes then pops, taking the
+	shared mutex around every call like a user of a shared STACK has to.
+	The timed calls include waiting on the mutex.
+*/
+static void *StackBenchmarkThread(void *Argument)
+{
+	STACK_BENCHMARK_THREAD *Thread;
+	STACK_BENCHMARK_SHARED *Shared;
+	UINT64 SampleStart;
+	UINT32 i;
+
+	Thread = (STACK_BENCHMARK_THREAD*)Argument;
+	Shared = Thread->Shared;
+
+	for(i = (UINT32)0; i < Shared->Operations; i++)
+	{
+		if((i % STACK_BENCHMARK_SAMPLE_PERIOD) == (UINT32)0)
+		{
+			SampleStart = StackBenchmarkNow();
+			pthread_mutex_lock(&Shared->Mutex);
+			StackPush(Shared->Stack, Argument);
+			pthread_mutex_unlock(&Shared->Mutex);
+			StackBenchmarkAddSample(&Thread->Samples, StackBenchmarkNow() - SampleStart);
+
+			SampleStart = StackBenchmarkNow();
+			pthread_mutex_lock(&Shared->Mutex);
+			StackPop(Shared->Stack);
+			pthread_mutex_unlock(&Shared->Mutex);
+			StackBenchmarkAddSample(&Thread->Samples, StackBenchmarkNow() - SampleStart);
+		}
+		else
+		{
+			pthread_mutex_lock(&Shared->Mutex);
+			StackPush(Shared->Stack, Argument);
+			pthread_mutex_unlock(&Shared->Mutex);
+
+			pthread_mutex_lock(&Shared->Mutex);
+			StackPop(Shared->Stack);
+			pthread_mutex_unlock(&Shared->Mutex);
+		}
+	}
+
+	return NULL;
+}
+
+static void StackBenchmarkMultiThreaded(UINT32 Threads, BOOL Last)
+{
+	STACK_BENCHMARK_SHARED Shared;
+	STACK_BENCHMARK_THREAD *ThreadInfo;
+	STACK_BENCHMARK_SAMPLES Samples;
+	STACK Stack;
+	UINT64 Start, Nanoseconds;
+	UINT32 SamplesPerThread, Started, i;
+
+	/*
+		Each thread times one push and one pop out of every period.
+	*/
+	SamplesPerThread = (UINT32)((STACK_BENCHMARK_THREAD_OPERATIONS / STACK_BENCHMARK_SAMPLE_PERIOD + 1) * 2);
+
+	if((ThreadInfo = (STACK_BENCHMARK_THREAD*)malloc(Threads * sizeof(STACK_BENCHMARK_THREAD))) == (STACK_BENCHMARK_THREAD*)NULL)
+		return;
+
+	Samples.Size = (UINT32)(Threads * SamplesPerThread);
+	Samples.Count = (UINT32)0;
+
+	if((Samples.Samples = (UINT64*)malloc(Samples.Size * sizeof(UINT64))) == (UINT64*)NULL)
+	{
+		free(ThreadInfo);
+
+		return;
+	}
+
+	Shared.Stack = CreateStack(&Stack, (void (*)(void*))NULL);
+	Shared.Operations = (UINT32)STACK_BENCHMARK_THREAD_OPERATIONS;
+	pthread_mutex_init(&Shared.Mutex, NULL);
+
+	/*
+		Every thread writes its samples straight into its own part of
+		Samples.
+	*/
+	for(i = (UINT32)0; i < Threads; i++)
+	{
+		ThreadInfo[i].Shared = &Shared;
+		ThreadInfo[i].Samples.Samples = Samples.Samples + i * SamplesPerThread;
+		ThreadInfo[i].Samples.Count = (UINT32)0;
+		ThreadInfo[i].Samples.Size = SamplesPerThread;
+	}
+
+	Start = StackBenchmarkNow();
+
+	for(Started = (UINT32)0; Started < Threads; Started++)
+	{
+		if(pthread_create(&ThreadInfo[Started].Id, NULL, StackBenchmarkThread, (void*)&ThreadInfo[Started]) != 0)
+			break;
+	}
+
+	for(i = (UINT32)0; i < Started; i++)
+		pthread_join(ThreadInfo[i].Id, NULL);
+
+	Nanoseconds = StackBenchmarkNow() - Start;
+
+	if(Started == Threads)
+	{
+		/*
+			Pack the samples of each thread together before sorting them.
+		*/
+		for(i = (UINT32)0; i < Threads; i++)
+		{
+			memmove(Samples.Samples + Samples.Count, ThreadInfo[i].Samples.Samples, ThreadInfo[i].Samples.Count * sizeof(UINT64));
+			Samples.Count += ThreadInfo[i].Samples.Count;
+		}
+
+		printf("    {\"method\": \"MutexStackPushPop\", \"threads\": %lu, \"operations\": %llu, \"total_ns\": %llu, \"ops_per_sec\": %.0f, ",
+			(unsigned long)Threads, (unsigned long long)Threads * STACK_BENCHMARK_THREAD_OPERATIONS * 2, (unsigned long long)Nanoseconds,
+			Nanoseconds ? ((double)Threads * STACK_BENCHMARK_THREAD_OPERATIONS * 2 * 1e9) / (double)Nanoseconds : 0.0);
+
+		StackBenchmarkPrintLatency(&Samples);
+
+		printf("}%s\n", Last ? "" : ",");
+	}
+	else
+	{
+		printf("    {\"method\": \"MutexStackPushPop\", \"threads\": %lu, \"error\": \"only %lu threads could be started\"}%s\n",
+			(unsigned long)Threads, (unsigned long)Started, Last ? "" : ",");
+	}
+
+	pthread_mutex_destroy(&Shared.Mutex);
+
+	StackClear(&Stack);
+
+	#if (USING_STACK_NODE_CACHE == 1)
+		StackShrink(&Stack);
+	#endif // end of USING_STACK_NODE_CACHE
+
+	free(Samples.Samples);
+	free(ThreadInfo);
+}
+
+int main(int argc, char *argv[])
+{
+	STACK_BENCHMARK_SAMPLES Samples;
+	UINT32 MaxElements, MaxThreads, Elements, Threads;
+
+	MaxElements = (argc > 1) ? (UINT32)strtoul(argv[1], NULL, 10) : (UINT32)1000000;
+	MaxThreads = (argc > 2) ? (UINT32)strtoul(argv[2], NULL, 10) : (UINT32)4;
+
+	if(MaxElements < (UINT32)10)
+		MaxElements = (UINT32)10;
+
+	/*
+		Room for a sample out of every period of the biggest run.
+	*/
+	Samples.Size = (UINT32)((MaxElements > STACK_BENCHMARK_MIN_OPERATIONS ? MaxElements : STACK_BENCHMARK_MIN_OPERATIONS) / STACK_BENCHMARK_SAMPLE_PERIOD + 2);
+	Samples.Count = (UINT32)0;
+
+	if((Samples.Samples = (UINT64*)malloc(Samples.Size * sizeof(UINT64))) == (UINT64*)NULL)
+		return 1;
+
+	printf("{\n");
+	StackBenchmarkPrintConfig();
+
+	printf("  \"single_threaded\": [\n");
+
+	StackBenchmarkEmptyChurn(&Samples);
+
+	for(Elements = (UINT32)10; Elements <= MaxElements; Elements *= 10)
+	{
+		StackBenchmarkSingleThreaded(Elements, &Samples, (BOOL)(Elements > MaxElements / 10));
+
+		if(Elements > (UINT32)0xFFFFFFFF / 10)
+			break;
+	}
+
+	printf("  ],\n");
+	printf("  \"multi_threaded\": [\n");
+
+	for(Threads = (UINT32)1; Threads <= MaxThreads; Threads *= 2)
+		StackBenchmarkMultiThreaded(Threads, (BOOL)(Threads * 2 > MaxThreads));
+
+	printf("  ]\n");
+	printf("}\n");
+
+	free(Samples.Samples);
+
+	return 0;
+}
@@ -0,0 +1,329 @@
+/*
+	Date: March 26, 2011
+	File Name: StackCompact.c
+	Version: 1.05
+	IDE: Visual Studio 2010 Professional
+	Compiler: C89
+
+	Description:
+	This file contains all the code which comprises
+	the COMPACT_STACK and its STACK_SLAB.  For method
+	descriptions see StackCompact.h.
+*/
+
+#include "StackCompact.h"
+
+#if (USING_STACK_COMPACT_METHODS == 1)
+
+#if (USE_MALLOC == 1)
+	#include "stdlib.h"
+#endif // end of USE_MALLOC
+
+#include "string.h"
+#include "stdint.h"
+
+/*
+	The most nodes a STACK_SLAB can have.  Index 0 stands for no node.
+*/
+#define STACK_SLAB_MAX_NODES					(UINT32)0xFFFFFFFF
+
+/*
+	Moves the nodes of the STACK_SLAB into arrays with room for Capacity
+	nodes.  Returns FALSE, leaving the STACK_SLAB as it was, if they 
+	couldn't be had.
+*/
+static BOOL StackSlabResize(STACK_SLAB *Slab, UINT32 Capacity)
+{
+	void **Data;
+	UINT32 *Next;
+
+	/*
+		Only a size_t of 32 bits can be too small for Capacity data
+		pointers, anywhere else the check would always be false.
+	*/
+	#if !defined(SIZE_MAX) || (SIZE_MAX <= 0xFFFFFFFF)
+		if((size_t)Capacity > (size_t)-1 / sizeof(void*))
+			return (BOOL)FALSE;
+	#endif // end of SIZE_MAX
+
+	if((Data = (void**)StackMemAlloc((size_t)Capacity * sizeof(void*))) == (void**)NULL)
+		return (BOOL)FALSE;
+
+	if((Next = (UINT32*)StackMemAlloc((size_t)Capacity * sizeof(UINT32))) == (UINT32*)NULL)
+	{
+		StackMemDealloc((void*)Data);
+
+		return (BOOL)FALSE;
+	}
+
+	if(Slab->Capacity)
+	{
+		memcpy((void*)Data, (const void*)(Slab->Data), (size_t)Slab->Used * sizeof(void*));
+		memcpy((void*)Next, (const void*)(Slab->Next), (size_t)Slab->Used * sizeof(UINT32));
+
+		StackMemDealloc((void*)(Slab->Data));
+		StackMemDealloc((void*)(Slab->Next));
+	}
+
+	Slab->Data = (void**)Data;
+	Slab->Next = (UINT32*)Next;
+	Slab->Capacity = (UINT32)Capacity;
+
+	return (BOOL)TRUE;
+}
+
+/*
+	Hands out a node of the STACK_SLAB, one that was given back if there
+	is one, or 0 if the STACK_SLAB is out of nodes and can't grow.
+*/
+static UINT32 StackSlabAllocateNode(STACK_SLAB *Slab)
+{
+	UINT32 Node, Capacity;
+
+	if((Node = (UINT32)(Slab->FreeNodes)) != (UINT32)0)
+	{
+		Slab->FreeNodes = (UINT32)(Slab->Next[Node]);
+
+		return (UINT32)Node;
+	}
+
+	/*
+		A STACK_SLAB that was destroyed has no room at all, not even for
+		node 0.
+	*/
+	if(Slab->Used >= Slab->Capacity)
+	{
+		if(Slab->Capacity == STACK_SLAB_MAX_NODES)
+			return (UINT32)0;
+
+		if(Slab->Capacity == (UINT32)0)
+			Capacity = (UINT32)(STACK_SLAB_DEFAULT_NODES + 1);
+		else if(Slab->Capacity > STACK_SLAB_MAX_NODES / 2)
+			Capacity = STACK_SLAB_MAX_NODES;
+		else
+			Capacity = (UINT32)(Slab->Capacity * 2);
+
+		if(!StackSlabResize(Slab, Capacity))
+			return (UINT32)0;
+	}
+
+	return (UINT32)(Slab->Used++);
+}
+
+STACK_SLAB *CreateStackSlab(STACK_SLAB *Slab, void (*CustomFreeMethod)(void *Data), UINT32 Nodes)
+{
+	BOOL Allocated;
+
+	Allocated = (BOOL)FALSE;
+
+	/*
+		If Slab is equal to (STACK_SLAB*)NULL then the user wants to
+		create a new STACK_SLAB in memory
+	*/
+	if(Slab == (STACK_SLAB*)NULL)
+	{
+		if((Slab = (STACK_SLAB*)StackMemAlloc(sizeof(STACK_SLAB))) == (STACK_SLAB*)NULL)
+		{
+			return (STACK_SLAB*)NULL;
+		}
+
+		Allocated = (BOOL)TRUE;
+	}
+
+	if(Nodes == (UINT32)0)
+		Nodes = (UINT32)STACK_SLAB_DEFAULT_NODES;
+
+	/*
+		Make room for node 0, which is never handed out.
+	*/
+	if(Nodes < STACK_SLAB_MAX_NODES)
+		Nodes++;
+
+	Slab->Data = (void**)NULL;
+	Slab->Next = (UINT32*)NULL;
+	Slab->Capacity = (UINT32)0;
+	Slab->Used = (UINT32)1;
+	Slab->FreeNodes = (UINT32)0;
+	Slab->NodesInUse = (UINT32)0;
+
+	#if(USING_STACK_DEPENDENT_FREE_METHOD == 1)
+		Slab->StackFreeMethod = (void (*)(void *))CustomFreeMethod;
+	#endif // end of USING_STACK_DEPENDENT_FREE_METHOD
+
+	if(!StackSlabResize(Slab, Nodes))
+	{
+		if(Allocated)
+			StackMemDealloc((void*)Slab);
+
+		return (STACK_SLAB*)NULL;
+	}
+
+	return (STACK_SLAB*)Slab;
+}
+
+UINT64 StackSlabGetSizeInBytes(STACK_SLAB *Slab)
+{
+	#if (STACK_SAFE_MODE == 1)
+		if(Slab == (STACK_SLAB*)NULL)
+			return (UINT64)0;
+	#endif // end of STACK_SAFE_MODE
+
+	return (UINT64)sizeof(STACK_SLAB) + ((UINT64)Slab->Capacity * (sizeof(void*) + sizeof(UINT32)));
+}
+
+BOOL DestroyStackSlab(STACK_SLAB *Slab)
+{
+	#if (STACK_SAFE_MODE == 1)
+		if(Slab == (STACK_SLAB*)NULL)
+			return (BOOL)FALSE;
+	#endif // end of STACK_SAFE_MODE
+
+	if(Slab->Capacity)
+	{
+		StackMemDealloc((void*)(Slab->Data));
+		StackMemDealloc((void*)(Slab->Next));
+	}
+
+	Slab->Data = (void**)NULL;
+	Slab->Next = (UINT32*)NULL;
+	Slab->Capacity = (UINT32)0;
+	Slab->Used = (UINT32)1;
+	Slab->FreeNodes = (UINT32)0;
+	Slab->NodesInUse = (UINT32)0;
+
+	return (BOOL)TRUE;
+}
+
+COMPACT_STACK *CreateCompactStack(COMPACT_STACK *Stack)
+{
+	/*
+		If Stack is equal to (COMPACT_STACK*)NULL then the user wants to
+		create a new COMPACT_STACK in memory
+	*/
+	if(Stack == (COMPACT_STACK*)NULL)
+	{
+		if((Stack = (COMPACT_STACK*)StackMemAlloc(sizeof(COMPACT_STACK))) == (COMPACT_STACK*)NULL)
+		{
+			return (COMPACT_STACK*)NULL;
+		}
+	}
+
+	Stack->Top = (UINT32)0;
+	Stack->Size = (UINT32)0;
+
+	return (COMPACT_STACK*)Stack;
+}
+
+BOOL CompactStackPush(STACK_SLAB *Slab, COMPACT_STACK *Stack, const void *Data)
+{
+	UINT32 Node;
+
+	#if (STACK_SAFE_MODE == 1)
+		if(Slab == (STACK_SLAB*)NULL || Stack == (COMPACT_STACK*)NULL)
+			return (BOOL)FALSE;
+	#endif // end of STACK_SAFE_MODE
+
+	if((Node = (UINT32)StackSlabAllocateNode(Slab)) == (UINT32)0)
+		return (BOOL)FALSE;
+
+	Slab->Data[Node] = (void*)Data;
+	Slab->Next[Node] = (UINT32)(Stack->Top);
+	Slab->NodesInUse++;
+
+	Stack->Top = (UINT32)Node;
+	Stack->Size++;
+
+	return (BOOL)TRUE;
+}
+
+void *CompactStackPop(STACK_SLAB *Slab, COMPACT_STACK *Stack)
+{
+	UINT32 Node;
+	void *Data;
+
+	#if (STACK_SAFE_MODE == 1)
+		if(Slab == (STACK_SLAB*)NULL || Stack == (COMPACT_STACK*)NULL)
+			return (void*)NULL;
+	#endif // end of STACK_SAFE_MODE
+
+	if((Node = (UINT32)(Stack->Top)) == (UINT32)0)
+		return (void*)NULL;
+
+	Data = (void*)(Slab->Data[Node]);
+
+	Stack->Top = (UINT32)(Slab->Next[Node]);
+	Stack->Size--;
+
+	/*
+		The node goes on the front of the free list, so the next push on 
+		any COMPACT_STACK of the STACK_SLAB reuses it while it's still in
+		the cache.
+	*/
+	Slab->Next[Node] = (UINT32)(Slab->FreeNodes);
+	Slab->FreeNodes = (UINT32)Node;
+	Slab->NodesInUse--;
+
+	return (void*)Data;
+}
+
+void *CompactStackPeek(STACK_SLAB *Slab, COMPACT_STACK *Stack)
+{
+	#if (STACK_SAFE_MODE == 1)
+		if(Slab == (STACK_SLAB*)NULL || Stack == (COMPACT_STACK*)NULL)
+			return (void*)NULL;
+	#endif // end of STACK_SAFE_MODE
+
+	if(Stack->Top == (UINT32)0)
+		return (void*)NULL;
+
+	return (void*)(Slab->Data[Stack->Top]);
+}
+
+BOOL CompactStackClear(STACK_SLAB *Slab, COMPACT_STACK *Stack)
+{
+	UINT32 Node;
+
+	#if (STACK_SAFE_MODE == 1)
+		if(Slab == (STACK_SLAB*)NULL || Stack == (COMPACT_STACK*)NULL)
+			return (BOOL)FALSE;
+	#endif // end of STACK_SAFE_MODE
+
+	if(Stack->Top == (UINT32)0)
+		return (BOOL)TRUE;
+
+	/*
+		Walk down to the bottom node, freeing the data on the way, then 
+		hand the whole run of nodes back to the free list at once.
+	*/
+	for(Node = (UINT32)(Stack->Top); ; Node = (UINT32)(Slab->Next[Node]))
+	{
+		#if(USING_STACK_DEPENDENT_FREE_METHOD == 1)
+			if(Slab->StackFreeMethod)
+				Slab->StackFreeMethod(Slab->Data[Node]);
+		#endif // end of USING_STACK_DEPENDENT_FREE_METHOD
+
+		if(Slab->Next[Node] == (UINT32)0)
+			break;
+	}
+
+	Slab->Next[Node] = (UINT32)(Slab->FreeNodes);
+	Slab->FreeNodes = (UINT32)(Stack->Top);
+	Slab->NodesInUse -= Stack->Size;
+
+	Stack->Top = (UINT32)0;
+	Stack->Size = (UINT32)0;
+
+	return (BOOL)TRUE;
+}
+
+UINT32 CompactStackGetSize(COMPACT_STACK *Stack)
+{
+	#if (STACK_SAFE_MODE == 1)
+		if(Stack == (COMPACT_STACK*)NULL)
+			return (UINT32)0;
+	#endif // end of STACK_SAFE_MODE
+
+	return (UINT32)(Stack->Size);
+}
+
+#endif // end of USING_STACK_COMPACT_METHODS
@@ -0,0 +1,283 @@
+/*
+	Date: March 26, 2011
+	File Name: StackCompact.h
+	Version: 1.05
+	IDE: Visual Studio 2010 Professional
+	Compiler: C89
+
+	Description:
+	This file contains all the method headers for interfacing to the
+	COMPACT_STACK, a stack built alongside the Stack library for when
+	there are a great many small stacks.  Each COMPACT_STACK is only a
+	top index and a size, and its nodes are 32 bit indices into a
+	STACK_SLAB that many COMPACT_STACK's share.  A node is a data 
+	pointer and a UINT32, with no malloc() header of its own.  All
+	methods have their documentation above their declaration.
+*/
+
+#ifndef STACK_COMPACT_H
+	#define STACK_COMPACT_H
+
+#include "GenericTypeDefs.h"
+#include "StackConfig.h"
+#include "StackObject.h"
+
+#if (USING_STACK_COMPACT_METHODS == 1)
+
+/*
+	Function: STACK_SLAB *CreateStackSlab(STACK_SLAB *Slab, void (*CustomFreeMethod)(void *Data), UINT32 Nodes)
+
+	Parameters:
+		STACK_SLAB *Slab - The address at which the STACK_SLAB will be
+		inititalized.  If NULL is passed in then this method will create a
+		STACK_SLAB out of the heap with a call to StackMemAlloc().
+
+		void(*CustomFreeMethod)(void *Data) - A pointer to a method that the
+		user defines.  CompactStackClear() calls it on every piece of data
+		left in a COMPACT_STACK of the STACK_SLAB.
+
+		UINT32 Nodes - The number of nodes to make room for up front, or 0
+		for STACK_SLAB_DEFAULT_NODES.
+
+	Returns:
+		STACK_SLAB* - The address at which the newly initialized STACK_SLAB
+		resides in memory.  If a new STACK_SLAB could not be created then
+		(STACK_SLAB*)NULL is returned.
+
+	Description: Creates a new STACK_SLAB in memory with room for Nodes
+	nodes.  When they run out the STACK_SLAB doubles in size.
+
+	Notes: USING_STACK_COMPACT_METHODS in StackConfig.h must be defined as 1 to use method.
+*/
+/**
+		* @brief Initializes a STACK_SLAB, and can create a STACK_SLAB.
+		* @param *Slab - A pointer to an already allocate STACK_SLAB or a NULL
+		pointer to create a STACK_SLAB from StackMemAlloc().
+		* @param *CustomFreeMethod - A method called by the STACK Library to delete
+		a piece of data left in a COMPACT_STACK.
+		* @param Nodes - The number of nodes to start with, or 0 for the default.
+		* @return *STACK_SLAB - The address of the STACK_SLAB in memory.  If it could
+		not be allocated, returns a NULL pointer.
+		* @note USING_STACK_COMPACT_METHODS in StackConfig.h must be defined as 1 to use method.
+		* @sa CreateCompactStack(), DestroyStackSlab()
+		* @since v1.05
+*/
+STACK_SLAB *CreateStackSlab(STACK_SLAB *Slab, void (*CustomFreeMethod)(void *Data), UINT32 Nodes);
+
+/*
+	Function: UINT64 StackSlabGetSizeInBytes(STACK_SLAB *Slab)
+
+	Parameters:
+		STACK_SLAB *Slab - The address at which the STACK_SLAB resides in memory.
+
+	Returns:
+		UINT64 - The number of bytes the STACK_SLAB and all its nodes, used
+		or not, take up.  0 if the STACK_SLAB was NULL.
+
+	Description: Returns how much memory the STACK_SLAB takes up.  This is
+	all the memory every COMPACT_STACK of the STACK_SLAB uses, besides the
+	COMPACT_STACK's themselves.
+
+	Notes: USING_STACK_COMPACT_METHODS in StackConfig.h must be defined as 1 to use method.
+*/
+/**
+		* @brief Returns the number of bytes the STACK_SLAB takes up.
+		* @param *Slab - The address at which the STACK_SLAB resides in memory.
+		* @return UINT64 - The size of the STACK_SLAB in bytes.
+		* @note USING_STACK_COMPACT_METHODS in StackConfig.h must be defined as 1 to use method.
+		* @sa CreateStackSlab()
+		* @since v1.05
+*/
+UINT64 StackSlabGetSizeInBytes(STACK_SLAB *Slab);
+
+/*
+	Function: BOOL DestroyStackSlab(STACK_SLAB *Slab)
+
+	Parameters:
+		STACK_SLAB *Slab - The address at which the STACK_SLAB resides in memory.
+
+	Returns:
+		BOOL - TRUE if the STACK_SLAB was destroyed.
+		FALSE - If a NULL referenced STACK_SLAB was passed in.
+
+	Description: Frees every node of the STACK_SLAB.  The STACK_SLAB
+	structure will still exist.  Every COMPACT_STACK of the STACK_SLAB
+	should be cleared first, the data still in them isn't freed.
+
+	Notes: USING_STACK_COMPACT_METHODS in StackConfig.h must be defined as 1 to use method.
+*/
+/**
+		* @brief Frees all the nodes of a STACK_SLAB.
+		* @param *Slab - The address at which the STACK_SLAB resides in memory.
+		* @return BOOL - TRUE if successful, FALSE if the STACK_SLAB was NULL.
+		* @note USING_STACK_COMPACT_METHODS in StackConfig.h must be defined as 1 to use method.
+		* @sa CreateStackSlab(), CompactStackClear()
+		* @since v1.05
+*/
+BOOL DestroyStackSlab(STACK_SLAB *Slab);
+
+/*
+	Function: COMPACT_STACK *CreateCompactStack(COMPACT_STACK *Stack)
+
+	Parameters:
+		COMPACT_STACK *Stack - The address at which the COMPACT_STACK will
+		be inititalized.  If NULL is passed in then this method will create
+		a COMPACT_STACK out of the heap with a call to StackMemAlloc().
+
+	Returns:
+		COMPACT_STACK* - The address at which the newly initialized
+		COMPACT_STACK resides in memory.  If a new COMPACT_STACK could not
+		be created then (COMPACT_STACK*)NULL is returned.
+
+	Description: Creates a new, empty COMPACT_STACK.  It isn't tied to a 
+	STACK_SLAB until the first push, but from then on it must always be 
+	used with that STACK_SLAB.
+
+	Notes: USING_STACK_COMPACT_METHODS in StackConfig.h must be defined as 1 to use method.
+*/
+/**
+		* @brief Initializes a COMPACT_STACK, and can create a COMPACT_STACK.
+		* @param *Stack - A pointer to an already allocate COMPACT_STACK or a NULL
+		pointer to create a COMPACT_STACK from StackMemAlloc().
+		* @return *COMPACT_STACK - The address of the COMPACT_STACK in memory.  If it could
+		not be allocated, returns a NULL pointer.
+		* @note USING_STACK_COMPACT_METHODS in StackConfig.h must be defined as 1 to use method.
+		* @sa CreateStackSlab()
+		* @since v1.05
+*/
+COMPACT_STACK *CreateCompactStack(COMPACT_STACK *Stack);
+
+/*
+	Function: BOOL CompactStackPush(STACK_SLAB *Slab, COMPACT_STACK *Stack, const void *Data)
+
+	Parameters:
+		STACK_SLAB *Slab - The STACK_SLAB the COMPACT_STACK takes its nodes from.
+		COMPACT_STACK *Stack - The address at which the COMPACT_STACK resides in memory.
+		const void *Data - The data to push onto the COMPACT_STACK.
+
+	Returns:
+		BOOL - TRUE if the data was pushed.  FALSE if either was NULL or the
+		STACK_SLAB couldn't grow.
+
+	Description: Pushes one item onto the COMPACT_STACK, in a node given
+	back by any COMPACT_STACK of the STACK_SLAB if there is one.
+
+	Notes: USING_STACK_COMPACT_METHODS in StackConfig.h must be defined as 1 to use method.
+*/
+/**
+		* @brief Pushes one item onto a COMPACT_STACK.
+		* @param *Slab - The STACK_SLAB the COMPACT_STACK takes its nodes from.
+		* @param *Stack - The address at which the COMPACT_STACK resides in memory.
+		* @param *Data - The data to push.
+		* @return BOOL - TRUE if successful, FALSE otherwise.
+		* @note USING_STACK_COMPACT_METHODS in StackConfig.h must be defined as 1 to use method.
+		* @sa CompactStackPop()
+		* @since v1.05
+*/
+BOOL CompactStackPush(STACK_SLAB *Slab, COMPACT_STACK *Stack, const void *Data);
+
+/*
+	Function: void *CompactStackPop(STACK_SLAB *Slab, COMPACT_STACK *Stack)
+
+	Parameters:
+		STACK_SLAB *Slab - The STACK_SLAB the COMPACT_STACK takes its nodes from.
+		COMPACT_STACK *Stack - The address at which the COMPACT_STACK resides in memory.
+
+	Returns:
+		void* - The data on top of the COMPACT_STACK, or NULL if it was empty.
+
+	Description: Removes the top item of the COMPACT_STACK and gives its 
+	node back to the STACK_SLAB.
+
+	Notes: USING_STACK_COMPACT_METHODS in StackConfig.h must be defined as 1 to use method.
+*/
+/**
+		* @brief Removes and returns the top item of a COMPACT_STACK.
+		* @param *Slab - The STACK_SLAB the COMPACT_STACK takes its nodes from.
+		* @param *Stack - The address at which the COMPACT_STACK resides in memory.
+		* @return void* - The data, or (void*)NULL if the COMPACT_STACK was empty.
+		* @note USING_STACK_COMPACT_METHODS in StackConfig.h must be defined as 1 to use method.
+		* @sa CompactStackPush()
+		* @since v1.05
+*/
+void *CompactStackPop(STACK_SLAB *Slab, COMPACT_STACK *Stack);
+
+/*
+	Function: void *CompactStackPeek(STACK_SLAB *Slab, COMPACT_STACK *Stack)
+
+	Parameters:
+		STACK_SLAB *Slab - The STACK_SLAB the COMPACT_STACK takes its nodes from.
+		COMPACT_STACK *Stack - The address at which the COMPACT_STACK resides in memory.
+
+	Returns:
+		void* - The data on top of the COMPACT_STACK, or NULL if it was empty.
+
+	Description: Returns but does not remove the top item of the 
+	COMPACT_STACK.
+
+	Notes: USING_STACK_COMPACT_METHODS in StackConfig.h must be defined as 1 to use method.
+*/
+/**
+		* @brief Returns the top item of a COMPACT_STACK.
+		* @param *Slab - The STACK_SLAB the COMPACT_STACK takes its nodes from.
+		* @param *Stack - The address at which the COMPACT_STACK resides in memory.
+		* @return void* - The data, or (void*)NULL if the COMPACT_STACK was empty.
+		* @note USING_STACK_COMPACT_METHODS in StackConfig.h must be defined as 1 to use method.
+		* @sa CompactStackPop()
+		* @since v1.05
+*/
+void *CompactStackPeek(STACK_SLAB *Slab, COMPACT_STACK *Stack);
+
+/*
+	Function: BOOL CompactStackClear(STACK_SLAB *Slab, COMPACT_STACK *Stack)
+
+	Parameters:
+		STACK_SLAB *Slab - The STACK_SLAB the COMPACT_STACK takes its nodes from.
+		COMPACT_STACK *Stack - The address at which the COMPACT_STACK resides in memory.
+
+	Returns:
+		BOOL - TRUE if the COMPACT_STACK was cleared, FALSE if either was NULL.
+
+	Description: Calls the STACK_SLAB's free method on every item of the
+	COMPACT_STACK, top first, and gives all its nodes back to the
+	STACK_SLAB at once.
+
+	Notes: USING_STACK_COMPACT_METHODS in StackConfig.h must be defined as 1 to use method.
+*/
+/**
+		* @brief Frees every item of a COMPACT_STACK.
+		* @param *Slab - The STACK_SLAB the COMPACT_STACK takes its nodes from.
+		* @param *Stack - The address at which the COMPACT_STACK resides in memory.
+		* @return BOOL - TRUE if successful, FALSE otherwise.
+		* @note USING_STACK_COMPACT_METHODS in StackConfig.h must be defined as 1 to use method.
+		* @sa DestroyStackSlab()
+		* @since v1.05
+*/
+BOOL CompactStackClear(STACK_SLAB *Slab, COMPACT_STACK *Stack);
+
+/*
+	Function: UINT32 CompactStackGetSize(COMPACT_STACK *Stack)
+
+	Parameters:
+		COMPACT_STACK *Stack - The address at which the COMPACT_STACK resides in memory.
+
+	Returns:
+		UINT32 - The number of items in the COMPACT_STACK, 0 if it was NULL.
+
+	Description: Returns the number of items in the COMPACT_STACK.
+
+	Notes: USING_STACK_COMPACT_METHODS in StackConfig.h must be defined as 1 to use method.
+*/
+/**
+		* @brief Returns the number of items in a COMPACT_STACK.
+		* @param *Stack - The address at which the COMPACT_STACK resides in memory.
+		* @return UINT32 - The number of items.
+		* @note USING_STACK_COMPACT_METHODS in StackConfig.h must be defined as 1 to use method.
+		* @sa None
+		* @since v1.05
+*/
+UINT32 CompactStackGetSize(COMPACT_STACK *Stack);
+
+#endif // end of USING_STACK_COMPACT_METHODS
+
+#endif // end of STACK_COMPACT_H
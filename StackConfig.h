@@ -13,10 +13,17 @@
 	It also allows the user to define how the Stack library will
 	allocate and deallocate memory for new nodes.
 
-	All methods are thread safe(re-entrant), with the potential exception 
-	of StackCreate, StackAdd, StackRemove, and StackClear.  The reason
+	All methods are re-entrant, with the potential exception of
+	CreateStack, StackPush, StackPop, and StackClear.  The reason
 	for this is that it all depends on how the user defines the way the 
-	Stack library will allocate, deallocate memory.
+	Stack library will allocate, deallocate memory.  A STACK itself is
+	not thread safe, a STACK shared between threads must have every call
+	guarded by the user (a mutex for example).  The CONCURRENT_STACK
+	methods enabled by USING_STACK_CONCURRENT_METHODS are thread safe.
+
+	Every USING_STACK_ and STACK_ option below can also be set on the
+	compiler's command line, for example -DUSING_STACK_NODE_ARENA=1, 
+	which is how the Makefile builds the benchmark for each configuration.
 */
 
 #ifndef STACK_CONFIG_H
@@ -26,38 +33,549 @@
 	*Set USING_STACK_PEEK_METHOD to 1 to enable the
 	StackPeek method.
 */
-#define USING_STACK_PEEK_METHOD							1
+#ifndef USING_STACK_PEEK_METHOD
+	#define USING_STACK_PEEK_METHOD							1
+#endif // end of USING_STACK_PEEK_METHOD
 
 /**
 	*Set USING_STACK_CLEAR_METHOD to 1 to enable the
 	StackClear method.
 */ 
-#define USING_STACK_CLEAR_METHOD						1
+#ifndef USING_STACK_CLEAR_METHOD
+	#define USING_STACK_CLEAR_METHOD						1
+#endif // end of USING_STACK_CLEAR_METHOD
 
 /**
 	*Set USING_STACK_GET_SIZE_METHOD to 1 to enable the
 	StackGetSize method.
 */
-#define USING_STACK_GET_SIZE_METHOD						1
+#ifndef USING_STACK_GET_SIZE_METHOD
+	#define USING_STACK_GET_SIZE_METHOD						1
+#endif // end of USING_STACK_GET_SIZE_METHOD
 
 /**
 	*Set USING_STACK_GET_SIZE_IN_BYTES_METHOD to 1 to enable the
 	StackGetSizeInBytes method.
 */
-#define USING_STACK_GET_SIZE_IN_BYTES_METHOD			1
+#ifndef USING_STACK_GET_SIZE_IN_BYTES_METHOD
+	#define USING_STACK_GET_SIZE_IN_BYTES_METHOD			1
+#endif // end of USING_STACK_GET_SIZE_IN_BYTES_METHOD
 
 /**
 	*Set USING_STACK_GET_LIBRARY_VERSION to 1 to enable the
 	StackGetLibraryVersion method.
 */
-#define USING_STACK_GET_LIBRARY_VERSION					1
+#ifndef USING_STACK_GET_LIBRARY_VERSION
+	#define USING_STACK_GET_LIBRARY_VERSION					1
+#endif // end of USING_STACK_GET_LIBRARY_VERSION
+
+/**
+	*Set USING_STACK_PUSH_MANY_METHOD to 1 to enable the
+	StackPushMany method.
+*/
+#ifndef USING_STACK_PUSH_MANY_METHOD
+	#define USING_STACK_PUSH_MANY_METHOD					1
+#endif // end of USING_STACK_PUSH_MANY_METHOD
+
+/**
+	*Set USING_STACK_POP_MANY_METHOD to 1 to enable the
+	StackPopMany method.
+*/
+#ifndef USING_STACK_POP_MANY_METHOD
+	#define USING_STACK_POP_MANY_METHOD						1
+#endif // end of USING_STACK_POP_MANY_METHOD
+
+/**
+	*Set USING_STACK_NODE_CACHE to 1 to have each STACK hold on to
+	the STACK_NODE's it pops so StackPush can reuse them instead of
+	calling StackMemAlloc.  This also enables the StackReserve, 
+	StackShrink and StackSetNodeCacheLimit methods.
+*/
+#ifndef USING_STACK_NODE_CACHE
+	#define USING_STACK_NODE_CACHE							0
+#endif // end of USING_STACK_NODE_CACHE
+
+/**
+	*The most STACK_NODE's a newly created STACK will hold in its
+	node cache.  StackSetNodeCacheLimit can change this per STACK.
+*/
+#ifndef STACK_NODE_CACHE_DEFAULT_LIMIT
+	#define STACK_NODE_CACHE_DEFAULT_LIMIT					64
+#endif // end of STACK_NODE_CACHE_DEFAULT_LIMIT
+
+/**
+	*Set USING_STACK_CHUNKED_STORAGE to 1 to have each STACK_NODE
+	hold a block of data pointers instead of just one.  This cuts
+	the memory used per item and the number of StackMemAlloc calls,
+	and enables the CreateChunkedStack method.
+*/
+#ifndef USING_STACK_CHUNKED_STORAGE
+	#define USING_STACK_CHUNKED_STORAGE						0
+#endif // end of USING_STACK_CHUNKED_STORAGE
+
+/**
+	*The number of data pointers per STACK_NODE for a STACK created
+	with CreateStack when USING_STACK_CHUNKED_STORAGE is 1.
+*/
+#ifndef STACK_DEFAULT_ELEMENTS_PER_NODE
+	#define STACK_DEFAULT_ELEMENTS_PER_NODE					64
+#endif // end of STACK_DEFAULT_ELEMENTS_PER_NODE
+
+/**
+	*Set USING_STACK_VALUE_METHODS to 1 to enable the CreateValueStack, 
+	StackPushValue, StackPopValue and StackPeekValue methods.  A STACK
+	made with CreateValueStack keeps copies of fixed size items inside 
+	its STACK_NODE's instead of pointers to them.  Adds a member to 
+	each STACK.
+*/
+#ifndef USING_STACK_VALUE_METHODS
+	#define USING_STACK_VALUE_METHODS						0
+#endif // end of USING_STACK_VALUE_METHODS
+
+/**
+	*Set USING_STACK_BOUNDED_METHODS to 1 to enable the 
+	CreateBoundedStack method.  A STACK made with it keeps its data
+	pointers in a buffer the caller hands in and never calls 
+	StackMemAlloc, so it can be used where the heap can't, like in a
+	signal handler.  Adds members to each STACK.
+*/
+#ifndef USING_STACK_BOUNDED_METHODS
+	#define USING_STACK_BOUNDED_METHODS						0
+#endif // end of USING_STACK_BOUNDED_METHODS
+
+/**
+	*Set USING_STACK_NODE_ARENA to 1 to have each STACK carve its
+	STACK_NODE's out of blocks of STACK_ARENA_BLOCK_SIZE bytes instead
+	of calling StackMemAlloc for each one.  StackClear then hands back
+	a whole block at a time.  A STACK popped empty keeps one block until
+	StackClear or StackShrink is called, so a STACK that is let go of 
+	without either leaks it.  Can't be used with USING_STACK_NODE_CACHE.
+	Adds members to each STACK.
+*/
+#ifndef USING_STACK_NODE_ARENA
+	#define USING_STACK_NODE_ARENA							0
+#endif // end of USING_STACK_NODE_ARENA
+
+/**
+	*The size in bytes of each block a STACK's node arena gets from
+	StackMemAlloc.  A block is made bigger if one STACK_NODE wouldn't
+	fit in it.
+*/
+#ifndef STACK_ARENA_BLOCK_SIZE
+	#define STACK_ARENA_BLOCK_SIZE							65536
+#endif // end of STACK_ARENA_BLOCK_SIZE
+
+/**
+	*The STACK_NODE's in a node arena are placed on a multiple of this
+	many bytes.  Must be a power of 2.
+*/
+#ifndef STACK_ARENA_ALIGNMENT
+	#define STACK_ARENA_ALIGNMENT							8
+#endif // end of STACK_ARENA_ALIGNMENT
+
+/**
+	*Set USING_STACK_HUGE_PAGE_ARENA to 1 to have each node arena map its
+	blocks with mmap instead of getting them from StackMemAlloc, on huge
+	pages when the system will give them.  For very deep STACK's, whose
+	STACK_NODE's then take up far fewer TLB entries.  Needs 
+	USING_STACK_NODE_ARENA.
+*/
+#ifndef USING_STACK_HUGE_PAGE_ARENA
+	#define USING_STACK_HUGE_PAGE_ARENA						0
+#endif // end of USING_STACK_HUGE_PAGE_ARENA
+
+/**
+	*The size in bytes of a huge page.  The blocks of a huge page arena
+	are made a multiple of it, and start on a multiple of it.
+*/
+#ifndef STACK_HUGE_PAGE_SIZE
+	#define STACK_HUGE_PAGE_SIZE							2097152
+#endif // end of STACK_HUGE_PAGE_SIZE
+
+/**
+	*Set USING_STACK_PARALLEL_FREE to 1 to have StackClear split the
+	calls to a STACK's free method across STACK_PARALLEL_FREE_THREADS
+	threads when the STACK holds at least STACK_PARALLEL_FREE_THRESHOLD
+	items.  The threads are started by the first such StackClear and
+	kept for the ones after it.  The free method must then be safe to
+	call from several threads at once.  Uses the StackThread defines 
+	below.
+*/
+#ifndef USING_STACK_PARALLEL_FREE
+	#define USING_STACK_PARALLEL_FREE						0
+#endif // end of USING_STACK_PARALLEL_FREE
+
+/**
+	*The number of threads StackClear frees data with, counting the
+	thread that called it.
+*/
+#ifndef STACK_PARALLEL_FREE_THREADS
+	#define STACK_PARALLEL_FREE_THREADS						4
+#endif // end of STACK_PARALLEL_FREE_THREADS
+
+/**
+	*The fewest items a STACK must hold before StackClear frees its
+	data with more than one thread.
+*/
+#ifndef STACK_PARALLEL_FREE_THRESHOLD
+	#define STACK_PARALLEL_FREE_THRESHOLD					65536
+#endif // end of STACK_PARALLEL_FREE_THRESHOLD
+
+/**
+	*Set USING_STACK_SPILL_METHODS to 1 to enable the 
+	StackSetMemoryBudget method.  A STACK given a memory budget moves
+	its bottom items out to a temporary file once it grows past the
+	budget, and reads them back in when StackPop gets down to them.
+	Can't be used with USING_STACK_NODE_ARENA.  Adds members to each
+	STACK.
+*/
+#ifndef USING_STACK_SPILL_METHODS
+	#define USING_STACK_SPILL_METHODS						0
+#endif // end of USING_STACK_SPILL_METHODS
+
+/**
+	*The size in bytes of the buffer items are moved to and from a
+	STACK's spill file with.
+*/
+#ifndef STACK_SPILL_BUFFER_SIZE
+	#define STACK_SPILL_BUFFER_SIZE							1048576
+#endif // end of STACK_SPILL_BUFFER_SIZE
+
+/**
+	*Set USING_STACK_SERIALIZE_METHODS to 1 to enable the 
+	StackGetSerializedSize, StackSerialize, StackDeserialize and
+	CreateStackView methods.  A STACK is written out to a buffer in
+	one pass, bottom first, and read back in keeping its order, or 
+	read in place as a read only value STACK.  Needs
+	USING_STACK_VALUE_METHODS.  Adds a member to each STACK.
+*/
+#ifndef USING_STACK_SERIALIZE_METHODS
+	#define USING_STACK_SERIALIZE_METHODS					0
+#endif // end of USING_STACK_SERIALIZE_METHODS
+
+/**
+	*Set USING_STACK_SEARCH_METHODS to 1 to enable the StackForEach,
+	StackContains, StackIndexOf and StackPeekAt methods, which look at
+	items below the top of a STACK without popping them.
+*/
+#ifndef USING_STACK_SEARCH_METHODS
+	#define USING_STACK_SEARCH_METHODS						0
+#endif // end of USING_STACK_SEARCH_METHODS
+
+/**
+	*Set USING_STACK_SIMD_SEARCH to 1 to have StackIndexOf and 
+	StackContains compare several data pointers per instruction over
+	a chunked, bounded or spilled STACK, when the compiler targets
+	AVX2 or SSE2.  Otherwise the pointers are compared one at a time.
+*/
+#ifndef USING_STACK_SIMD_SEARCH
+	#define USING_STACK_SIMD_SEARCH							1
+#endif // end of USING_STACK_SIMD_SEARCH
+
+/**
+	*Set USING_STACK_ALLOCATORS to 1 to give each STACK its own 
+	STACK_ALLOCATOR, which it gets all the memory for its STACK_NODE's
+	from instead of StackMemAlloc and StackMemDealloc.  This enables the
+	CreateStackWithAllocator and StackSetAllocator methods, and the NUMA 
+	node local and thread local arena allocators found in 
+	StackAllocators.c, which need Linux.  Adds a member to each STACK.
+*/
+#ifndef USING_STACK_ALLOCATORS
+	#define USING_STACK_ALLOCATORS							0
+#endif // end of USING_STACK_ALLOCATORS
+
+/**
+	*The size in bytes of each block the arena allocators in 
+	StackAllocators.c map.  Must be a power of 2 and a multiple of the
+	page size.
+*/
+#ifndef STACK_ALLOCATOR_BLOCK_SIZE
+	#define STACK_ALLOCATOR_BLOCK_SIZE						65536
+#endif // end of STACK_ALLOCATOR_BLOCK_SIZE
+
+/**
+	*The arena allocators hand out memory in sizes that are multiples of
+	this many bytes, and on addresses that are too.  Must be a power of 2.
+*/
+#ifndef STACK_ALLOCATOR_ALIGNMENT
+	#define STACK_ALLOCATOR_ALIGNMENT						16
+#endif // end of STACK_ALLOCATOR_ALIGNMENT
+
+/**
+	*The biggest piece of memory the arena allocators carve out of a
+	shared block.  Anything bigger gets blocks of its own.
+*/
+#ifndef STACK_ALLOCATOR_MAX_OBJECT_SIZE
+	#define STACK_ALLOCATOR_MAX_OBJECT_SIZE					1024
+#endif // end of STACK_ALLOCATOR_MAX_OBJECT_SIZE
+
+/**
+	*Set USING_STACK_STATISTICS to 1 to have each STACK count its
+	pushes, pops, clears and failed allocations and remember the
+	deepest it has been.  This also enables the StackGetStats and 
+	StackResetStats methods.
+*/
+#ifndef USING_STACK_STATISTICS
+	#define USING_STACK_STATISTICS							0
+#endif // end of USING_STACK_STATISTICS
+
+/**
+	*Set USING_STACK_LATENCY_HISTOGRAM to 1 to also have each STACK
+	time every STACK_LATENCY_SAMPLE_PERIOD'th StackPush and StackPop
+	with StackGetTimestamp and keep a histogram of them.  Needs 
+	USING_STACK_STATISTICS defined as 1.
+*/
+#ifndef USING_STACK_LATENCY_HISTOGRAM
+	#define USING_STACK_LATENCY_HISTOGRAM					0
+#endif // end of USING_STACK_LATENCY_HISTOGRAM
+
+/**
+	*One out of this many calls to StackPush or StackPop is timed.
+*/
+#ifndef STACK_LATENCY_SAMPLE_PERIOD
+	#define STACK_LATENCY_SAMPLE_PERIOD						64
+#endif // end of STACK_LATENCY_SAMPLE_PERIOD
+
+/**
+	*The number of buckets in each latency histogram.  Bucket i counts
+	the calls that took from 2^i up to 2^(i+1) timestamp ticks, and the
+	last bucket also counts everything slower than that.
+*/
+#ifndef STACK_LATENCY_HISTOGRAM_BUCKETS
+	#define STACK_LATENCY_HISTOGRAM_BUCKETS					32
+#endif // end of STACK_LATENCY_HISTOGRAM_BUCKETS
+
+/**
+	*Set USING_STACK_CONCURRENT_METHODS to 1 to enable the lock free
+	CONCURRENT_STACK and its methods.  These need the StackAtomic
+	defines and StackThreadLocal below.
+*/
+#ifndef USING_STACK_CONCURRENT_METHODS
+	#define USING_STACK_CONCURRENT_METHODS					0
+#endif // end of USING_STACK_CONCURRENT_METHODS
+
+/**
+	*The size in bytes of a cache line.  The hot members of a 
+	CONCURRENT_STACK are padded out to this so threads working on
+	different members don't fight over the same cache line.
+*/
+#ifndef STACK_CACHE_LINE_SIZE
+	#define STACK_CACHE_LINE_SIZE							64
+#endif // end of STACK_CACHE_LINE_SIZE
+
+/**
+	*The number of popped CONCURRENT_STACK_NODE's a thread collects
+	before checking which of them can be freed with StackMemDealloc.
+	Twice the number of threads using CONCURRENT_STACK's is added on.
+*/
+#ifndef STACK_HAZARD_SCAN_THRESHOLD
+	#define STACK_HAZARD_SCAN_THRESHOLD						64
+#endif // end of STACK_HAZARD_SCAN_THRESHOLD
+
+/**
+	*Set USING_STACK_ELIMINATION_BACKOFF to 1 to enable the
+	CreateEliminationStack method.  A CONCURRENT_STACK made with it
+	lets a push and a pop that both lost the race for the top hand 
+	the data straight to each other.  Needs 
+	USING_STACK_CONCURRENT_METHODS defined as 1.
+*/
+#ifndef USING_STACK_ELIMINATION_BACKOFF
+	#define USING_STACK_ELIMINATION_BACKOFF					0
+#endif // end of USING_STACK_ELIMINATION_BACKOFF
+
+/**
+	*The number of slots in each CONCURRENT_STACK's elimination array.
+	Each thread only uses as many of them as the contention it sees 
+	calls for.
+*/
+#ifndef STACK_ELIMINATION_ARRAY_SIZE
+	#define STACK_ELIMINATION_ARRAY_SIZE					16
+#endif // end of STACK_ELIMINATION_ARRAY_SIZE
+
+/**
+	*How many times a push waits on its elimination slot for a pop
+	to take its data before going back to the top of the stack.
+*/
+#ifndef STACK_ELIMINATION_SPIN
+	#define STACK_ELIMINATION_SPIN							256
+#endif // end of STACK_ELIMINATION_SPIN
+
+/**
+	*Set USING_STACK_NODE_MAGAZINES to 1 to keep freed 
+	CONCURRENT_STACK_NODE's in a magazine per CPU instead of handing 
+	them back to StackMemDealloc.  A push takes its node from the 
+	magazine of the CPU it runs on, without a lock or an atomic, using
+	Linux restartable sequences on x86-64 with glibc 2.35 or later.
+	Elsewhere each thread gets its own magazine instead.  Needs
+	USING_STACK_CONCURRENT_METHODS defined as 1.
+*/
+#ifndef USING_STACK_NODE_MAGAZINES
+	#define USING_STACK_NODE_MAGAZINES						0
+#endif // end of USING_STACK_NODE_MAGAZINES
+
+/**
+	*The number of CONCURRENT_STACK_NODE's each magazine holds.  Half
+	of that is moved to or from the shared depot at a time.
+*/
+#ifndef STACK_MAGAZINE_SIZE
+	#define STACK_MAGAZINE_SIZE								32
+#endif // end of STACK_MAGAZINE_SIZE
+
+/**
+	*The number of CPU's that get a magazine of their own.  Threads on
+	any CPU past that use a magazine of their own instead.
+*/
+#ifndef STACK_MAGAZINE_MAX_CPUS
+	#define STACK_MAGAZINE_MAX_CPUS							256
+#endif // end of STACK_MAGAZINE_MAX_CPUS
+
+/**
+	*The most batches of CONCURRENT_STACK_NODE's the shared depot keeps.
+	Batches past that are freed with StackMemDealloc.
+*/
+#ifndef STACK_DEPOT_MAX_BATCHES
+	#define STACK_DEPOT_MAX_BATCHES							64
+#endif // end of STACK_DEPOT_MAX_BATCHES
+
+/**
+	*Set USING_STACK_DEQUE to 1 to enable the STACK_DEQUE work
+	stealing deque found in StackDeque.c.  It uses the StackAtomic
+	defines below.
+*/
+#ifndef USING_STACK_DEQUE
+	#define USING_STACK_DEQUE								0
+#endif // end of USING_STACK_DEQUE
+
+/**
+	*The number of slots a STACK_DEQUE starts out with.  It doubles
+	each time it fills up.  Must be a power of 2.
+*/
+#ifndef STACK_DEQUE_INITIAL_SIZE
+	#define STACK_DEQUE_INITIAL_SIZE						64
+#endif // end of STACK_DEQUE_INITIAL_SIZE
+
+/**
+	*Set USING_STACK_MAPPED_METHODS to 1 to enable the MAPPED_STACK 
+	found in StackMapped.c, a stack of fixed size items kept in a file
+	with mmap so it survives a restart.  Needs a POSIX system.
+*/
+#ifndef USING_STACK_MAPPED_METHODS
+	#define USING_STACK_MAPPED_METHODS						0
+#endif // end of USING_STACK_MAPPED_METHODS
+
+/**
+	*The number of items a new MAPPED_STACK's file has room for.  The
+	file doubles in size each time it fills up.
+*/
+#ifndef STACK_MAPPED_INITIAL_CAPACITY
+	#define STACK_MAPPED_INITIAL_CAPACITY					1024
+#endif // end of STACK_MAPPED_INITIAL_CAPACITY
+
+/**
+	*Where the items start in a MAPPED_STACK's file.  The header sits in
+	front of them, so the items start on a page of their own.  Where the
+	pages are bigger than this, StackSync() flushes the first items along
+	with the header's page.
+*/
+#ifndef STACK_MAPPED_DATA_OFFSET
+	#define STACK_MAPPED_DATA_OFFSET						4096
+#endif // end of STACK_MAPPED_DATA_OFFSET
+
+/**
+	*Set USING_STACK_SYNCHRONIZED_METHODS to 1 to enable the 
+	SYNCHRONIZED_STACK found in StackSynchronized.c, a STACK behind a
+	lock whose consumers can sleep in StackPopWait until something is
+	pushed, instead of polling.  Uses pthreads.
+*/
+#ifndef USING_STACK_SYNCHRONIZED_METHODS
+	#define USING_STACK_SYNCHRONIZED_METHODS				0
+#endif // end of USING_STACK_SYNCHRONIZED_METHODS
+
+/**
+	*Set USING_STACK_EVENT_FD to 1 to enable the 
+	SynchronizedStackGetEventFd method, which hands out an eventfd that
+	is readable while the SYNCHRONIZED_STACK holds anything, so it can
+	be waited on with poll, select or epoll.  Needs Linux.
+*/
+#ifndef USING_STACK_EVENT_FD
+	#define USING_STACK_EVENT_FD							1
+#endif // end of USING_STACK_EVENT_FD
+
+/**
+	*Set USING_STACK_COMPACT_METHODS to 1 to enable the COMPACT_STACK 
+	found in StackCompact.c, an 8 byte stack whose nodes are 32 bit 
+	indices into a STACK_SLAB shared with other COMPACT_STACK's.  For
+	keeping a great many small stacks.
+*/
+#ifndef USING_STACK_COMPACT_METHODS
+	#define USING_STACK_COMPACT_METHODS						0
+#endif // end of USING_STACK_COMPACT_METHODS
+
+/**
+	*The number of nodes a STACK_SLAB is created with if none are asked
+	for.  It doubles each time it runs out.
+*/
+#ifndef STACK_SLAB_DEFAULT_NODES
+	#define STACK_SLAB_DEFAULT_NODES						1024
+#endif // end of STACK_SLAB_DEFAULT_NODES
+
+/**
+	*Set USING_STACK_PERSISTENT_METHODS to 1 to enable the StackClone
+	method.  A clone shares the STACK_NODE's of the STACK it was made
+	from, so it is made in constant time no matter how big the STACK is.
+	Each STACK_NODE then carries an atomic count of what points at it.
+*/
+#ifndef USING_STACK_PERSISTENT_METHODS
+	#define USING_STACK_PERSISTENT_METHODS					0
+#endif // end of USING_STACK_PERSISTENT_METHODS
+
+/**
+	*Set USING_STACK_SPLICE_METHODS to 1 to enable the StackSplice and 
+	StackSplitTop methods, which move items from one STACK to another by
+	relinking their STACK_NODE's instead of popping and pushing each one.
+	Each STACK then also keeps a pointer to its bottom STACK_NODE.
+*/
+#ifndef USING_STACK_SPLICE_METHODS
+	#define USING_STACK_SPLICE_METHODS						0
+#endif // end of USING_STACK_SPLICE_METHODS
+
+/**
+	*Set USING_STACK_MARK_METHODS to 1 to enable the StackMark and 
+	StackRewind methods, which drop everything pushed since a mark at
+	once by winding the STACK's node arena back to where it was.  Needs
+	USING_STACK_NODE_ARENA.
+*/
+#ifndef USING_STACK_MARK_METHODS
+	#define USING_STACK_MARK_METHODS						0
+#endif // end of USING_STACK_MARK_METHODS
+
+/**
+	*Set USING_STACK_INLINE_BUFFER to 1 to give every STACK a buffer 
+	inside of itself that its first STACK_NODE's are carved out of.  A
+	STACK made in memory the caller already has then never calls
+	StackMemAlloc() until it outgrows the buffer.
+*/
+#ifndef USING_STACK_INLINE_BUFFER
+	#define USING_STACK_INLINE_BUFFER						0
+#endif // end of USING_STACK_INLINE_BUFFER
+
+/**
+	*The number of bytes of the inline buffer.  128 bytes hold 8 
+	STACK_NODE's of an ordinary STACK on a 64 bit machine.  A STACK 
+	whose STACK_NODE's don't fit doesn't use it.
+*/
+#ifndef STACK_INLINE_BUFFER_SIZE
+	#define STACK_INLINE_BUFFER_SIZE						128
+#endif // end of STACK_INLINE_BUFFER_SIZE
 
 /**
 	*Set STACK_SAFE_MODE to 1 to enable the portions of code
 	inside the STACK Library that check to make sure all passed
 	in parameters are of a valid nature.
 */
-#define STACK_SAFE_MODE									1
+#ifndef STACK_SAFE_MODE
+	#define STACK_SAFE_MODE									1
+#endif // end of STACK_SAFE_MODE
 
 /**
 	*This defines what method the Stack library will use to 
@@ -71,6 +589,43 @@
 */
 #define StackMemDealloc(Mem)							free(Mem)
 
+/**
+	*These define the atomic operations the CONCURRENT_STACK methods
+	are built on.  Each one must be a full memory barrier.  
+	StackAtomicCompareAndSwap returns non zero if *Ptr was equal to
+	Expected and was replaced with Desired.  StackAtomicAdd returns the 
+	new value, and StackAtomicExchange the old one.
+*/
+#define StackAtomicLoad(Ptr)							__atomic_load_n(Ptr, __ATOMIC_SEQ_CST)
+#define StackAtomicStore(Ptr, Value)					__atomic_store_n(Ptr, Value, __ATOMIC_SEQ_CST)
+#define StackAtomicCompareAndSwap(Ptr, Expected, Desired)	__sync_bool_compare_and_swap(Ptr, Expected, Desired)
+#define StackAtomicAdd(Ptr, Value)						__atomic_add_fetch(Ptr, Value, __ATOMIC_SEQ_CST)
+#define StackAtomicExchange(Ptr, Value)					__atomic_exchange_n(Ptr, Value, __ATOMIC_SEQ_CST)
+
+/**
+	*The method used to read the time for the latency histograms.  It
+	must return a UINT64 that counts up, and the histogram buckets are
+	in whatever unit it counts in.  The default reads CLOCK_MONOTONIC
+	in nanoseconds with clock_gettime().
+*/
+#define StackGetTimestamp()								StackGetTimeInNanoseconds()
+
+/**
+	*The storage class used to give each thread its own copy of a 
+	variable.
+*/
+#define StackThreadLocal								__thread
+
+/**
+	*These define how StackClear starts the threads it frees data with
+	when USING_STACK_PARALLEL_FREE is 1.  StackThreadCreate returns non
+	zero if Method(Argument) was started on a new thread.  The threads
+	run until the program ends, so they are detached right away.
+*/
+#define StackThread										pthread_t
+#define StackThreadCreate(Thread, Method, Argument)		(pthread_create(Thread, NULL, Method, Argument) == 0)
+#define StackThreadDetach(Thread)						pthread_detach(Thread)
+
 /**
 	*Define USE_MALLOC as 1 to enable the stdlib.h file included
 	with Stack.c.
@@ -81,7 +636,9 @@
 	*Define the below as 1 if each STACK is to store a custom
 	method for freeing a STACK_NODE.
 */
-#define USING_STACK_DEPENDENT_FREE_METHOD				1
+#ifndef USING_STACK_DEPENDENT_FREE_METHOD
+	#define USING_STACK_DEPENDENT_FREE_METHOD				1
+#endif // end of USING_STACK_DEPENDENT_FREE_METHOD
 
 /**
 	*If the user isn't using malloc then include the file that will
@@ -90,4 +647,59 @@
 */
 //#include "Your memory file here.h"
 
+/*
+	Make sure the options chosen above work together.
+*/
+#if (USING_STACK_LATENCY_HISTOGRAM == 1) && (USING_STACK_STATISTICS != 1)
+	#error "USING_STACK_LATENCY_HISTOGRAM needs USING_STACK_STATISTICS defined as 1"
+#endif
+
+#if (USING_STACK_NODE_ARENA == 1) && (USING_STACK_NODE_CACHE == 1)
+	#error "USING_STACK_NODE_ARENA can't be used with USING_STACK_NODE_CACHE"
+#endif
+
+#if (USING_STACK_SPILL_METHODS == 1) && (USING_STACK_NODE_ARENA == 1)
+	#error "USING_STACK_SPILL_METHODS can't be used with USING_STACK_NODE_ARENA"
+#endif
+
+#if (USING_STACK_SERIALIZE_METHODS == 1) && (USING_STACK_VALUE_METHODS != 1)
+	#error "USING_STACK_SERIALIZE_METHODS needs USING_STACK_VALUE_METHODS defined as 1"
+#endif
+
+#if (USING_STACK_SYNCHRONIZED_METHODS == 1) && (USING_STACK_CLEAR_METHOD != 1)
+	#error "USING_STACK_SYNCHRONIZED_METHODS needs USING_STACK_CLEAR_METHOD defined as 1"
+#endif
+
+#if (USING_STACK_PARALLEL_FREE == 1) && ((USING_STACK_CLEAR_METHOD != 1) || (USING_STACK_DEPENDENT_FREE_METHOD != 1))
+	#error "USING_STACK_PARALLEL_FREE needs USING_STACK_CLEAR_METHOD and USING_STACK_DEPENDENT_FREE_METHOD defined as 1"
+#endif
+
+#if (USING_STACK_ELIMINATION_BACKOFF == 1) && (USING_STACK_CONCURRENT_METHODS != 1)
+	#error "USING_STACK_ELIMINATION_BACKOFF needs USING_STACK_CONCURRENT_METHODS defined as 1"
+#endif
+
+#if (USING_STACK_PERSISTENT_METHODS == 1) && ((USING_STACK_CHUNKED_STORAGE == 1) || (USING_STACK_NODE_ARENA == 1) || (USING_STACK_SPILL_METHODS == 1) || (USING_STACK_PARALLEL_FREE == 1))
+	#error "USING_STACK_PERSISTENT_METHODS can't be used with USING_STACK_CHUNKED_STORAGE, USING_STACK_NODE_ARENA, USING_STACK_SPILL_METHODS or USING_STACK_PARALLEL_FREE"
+#endif
+
+#if (USING_STACK_SPLICE_METHODS == 1) && ((USING_STACK_NODE_ARENA == 1) || (USING_STACK_SPILL_METHODS == 1) || (USING_STACK_PERSISTENT_METHODS == 1))
+	#error "USING_STACK_SPLICE_METHODS can't be used with USING_STACK_NODE_ARENA, USING_STACK_SPILL_METHODS or USING_STACK_PERSISTENT_METHODS"
+#endif
+
+#if (USING_STACK_MARK_METHODS == 1) && (USING_STACK_NODE_ARENA != 1)
+	#error "USING_STACK_MARK_METHODS needs USING_STACK_NODE_ARENA defined as 1"
+#endif
+
+#if (USING_STACK_NODE_MAGAZINES == 1) && (USING_STACK_CONCURRENT_METHODS != 1)
+	#error "USING_STACK_NODE_MAGAZINES needs USING_STACK_CONCURRENT_METHODS defined as 1"
+#endif
+
+#if (USING_STACK_INLINE_BUFFER == 1) && ((USING_STACK_NODE_ARENA == 1) || (USING_STACK_PERSISTENT_METHODS == 1) || (USING_STACK_SPLICE_METHODS == 1))
+	#error "USING_STACK_INLINE_BUFFER can't be used with USING_STACK_NODE_ARENA, USING_STACK_PERSISTENT_METHODS or USING_STACK_SPLICE_METHODS"
+#endif
+
+#if (USING_STACK_HUGE_PAGE_ARENA == 1) && (USING_STACK_NODE_ARENA != 1)
+	#error "USING_STACK_HUGE_PAGE_ARENA needs USING_STACK_NODE_ARENA defined as 1"
+#endif
+
 #endif // end of STACK_CONFIG_H
@@ -0,0 +1,254 @@
+/*
+	Date: March 26, 2011
+	File Name: StackDeque.c
+	Version: 1.05
+	IDE: Visual Studio 2010 Professional
+	Compiler: C89
+
+	Description:
+	This file contains all the code which comprises
+	the STACK_DEQUE work stealing deque.  For method
+	descriptions see StackDeque.h.
+*/
+
+#include "StackDeque.h"
+
+#if (USING_STACK_DEQUE == 1)
+
+#if (USE_MALLOC == 1)
+	#include "stdlib.h"
+#endif // end of USE_MALLOC
+
+/*
+	Allocates a STACK_DEQUE_ARRAY with room for Size pointers.
+*/
+static STACK_DEQUE_ARRAY *StackDequeAllocateArray(UINT32 Size)
+{
+	STACK_DEQUE_ARRAY *Array;
+
+	if((Array = (STACK_DEQUE_ARRAY*)StackMemAlloc(sizeof(STACK_DEQUE_ARRAY) + ((Size - 1) * sizeof(void*)))) == (STACK_DEQUE_ARRAY*)NULL)
+		return (STACK_DEQUE_ARRAY*)NULL;
+
+	Array->Size = (UINT32)Size;
+	Array->Previous = (STACK_DEQUE_ARRAY*)NULL;
+
+	return (STACK_DEQUE_ARRAY*)Array;
+}
+
+STACK_DEQUE *CreateStackDeque(STACK_DEQUE *Deque, void (*CustomFreeMethod)(void *Data))
+{
+	/*
+		If Deque is equal to (STACK_DEQUE*)NULL then the user wants to
+		create a new STACK_DEQUE in memory
+	*/
+	if(Deque == (STACK_DEQUE*)NULL)
+	{
+		if((Deque = (STACK_DEQUE*)StackMemAlloc(sizeof(STACK_DEQUE))) == (STACK_DEQUE*)NULL)
+		{
+			return (STACK_DEQUE*)NULL;
+		}
+	}
+
+	/*
+		Initialize the STACK_DEQUE to it's defualt values.
+	*/
+	Deque->Top = (INT64)0;
+	Deque->Bottom = (INT64)0;
+	Deque->Array = (STACK_DEQUE_ARRAY*)NULL;
+
+	#if(USING_STACK_DEPENDENT_FREE_METHOD == 1)
+		Deque->StackFreeMethod = (void (*)(void *))CustomFreeMethod;
+	#endif // end of USING_STACK_DEPENDENT_FREE_METHOD
+
+	return (STACK_DEQUE*)Deque;
+}
+
+BOOL StackDequePush(STACK_DEQUE *Deque, const void *Data)
+{
+	STACK_DEQUE_ARRAY *Array, *NewArray;
+	INT64 Top, Bottom, i;
+
+	#if (STACK_SAFE_MODE == 1)
+		if(Deque == (STACK_DEQUE*)NULL)
+			return (BOOL)FALSE;
+	#endif // end of STACK_SAFE_MODE
+
+	Bottom = (INT64)StackAtomicLoad(&Deque->Bottom);
+	Top = (INT64)StackAtomicLoad(&Deque->Top);
+	Array = (STACK_DEQUE_ARRAY*)StackAtomicLoad(&Deque->Array);
+
+	/*
+		If there is no buffer yet, or it is full, move over to a new one
+		twice the size.  Thieves may still be reading out of the old one,
+		so it is kept until StackDequeClear().
+	*/
+	if(Array == (STACK_DEQUE_ARRAY*)NULL || Bottom - Top >= (INT64)(Array->Size))
+	{
+		if((NewArray = (STACK_DEQUE_ARRAY*)StackDequeAllocateArray(Array ? (UINT32)(Array->Size * 2) : (UINT32)STACK_DEQUE_INITIAL_SIZE)) == (STACK_DEQUE_ARRAY*)NULL)
+			return (BOOL)FALSE;
+
+		if(Array != (STACK_DEQUE_ARRAY*)NULL)
+		{
+			for(i = Top; i < Bottom; i++)
+				NewArray->Data[i & (NewArray->Size - 1)] = (void*)StackAtomicLoad(&Array->Data[i & (Array->Size - 1)]);
+		}
+
+		NewArray->Previous = (STACK_DEQUE_ARRAY*)Array;
+		StackAtomicStore(&Deque->Array, NewArray);
+		Array = (STACK_DEQUE_ARRAY*)NewArray;
+	}
+
+	/*
+		Store the data and only then make it visible to thieves by moving
+		Bottom past it.
+	*/
+	StackAtomicStore(&Array->Data[Bottom & (Array->Size - 1)], (void*)Data);
+	StackAtomicStore(&Deque->Bottom, Bottom + 1);
+
+	return (BOOL)TRUE;
+}
+
+void *StackDequePop(STACK_DEQUE *Deque)
+{
+	STACK_DEQUE_ARRAY *Array;
+	INT64 Top, Bottom;
+	void *Data;
+
+	#if (STACK_SAFE_MODE == 1)
+		if(Deque == (STACK_DEQUE*)NULL)
+			return (void*)NULL;
+	#endif // end of STACK_SAFE_MODE
+
+	/*
+		Claim the bottom item by moving Bottom down first, then look at
+		Top to see if a thief could be after the same item.
+	*/
+	Bottom = (INT64)StackAtomicLoad(&Deque->Bottom) - 1;
+	Array = (STACK_DEQUE_ARRAY*)StackAtomicLoad(&Deque->Array);
+	StackAtomicStore(&Deque->Bottom, Bottom);
+	Top = (INT64)StackAtomicLoad(&Deque->Top);
+
+	if(Top > Bottom)
+	{
+		/*
+			It was empty, put Bottom back.
+		*/
+		StackAtomicStore(&Deque->Bottom, Bottom + 1);
+
+		return (void*)NULL;
+	}
+
+	Data = (void*)StackAtomicLoad(&Array->Data[Bottom & (Array->Size - 1)]);
+
+	if(Top == Bottom)
+	{
+		/*
+			This is the last item, so race the thieves for it the same way
+			they race each other, by moving Top past it.
+		*/
+		if(!StackAtomicCompareAndSwap(&Deque->Top, Top, Top + 1))
+			Data = (void*)NULL;
+
+		StackAtomicStore(&Deque->Bottom, Bottom + 1);
+	}
+
+	return (void*)Data;
+}
+
+void *StackDequeSteal(STACK_DEQUE *Deque)
+{
+	STACK_DEQUE_ARRAY *Array;
+	INT64 Top, Bottom;
+	void *Data;
+
+	#if (STACK_SAFE_MODE == 1)
+		if(Deque == (STACK_DEQUE*)NULL)
+			return (void*)NULL;
+	#endif // end of STACK_SAFE_MODE
+
+	Top = (INT64)StackAtomicLoad(&Deque->Top);
+	Bottom = (INT64)StackAtomicLoad(&Deque->Bottom);
+
+	if(Top >= Bottom)
+		return (void*)NULL;
+
+	/*
+		Read the item before claiming it, as once Top moves past it the
+		owner is free to write over its slot.
+	*/
+	Array = (STACK_DEQUE_ARRAY*)StackAtomicLoad(&Deque->Array);
+	Data = (void*)StackAtomicLoad(&Array->Data[Top & (Array->Size - 1)]);
+
+	if(!StackAtomicCompareAndSwap(&Deque->Top, Top, Top + 1))
+		return (void*)NULL;
+
+	return (void*)Data;
+}
+
+BOOL StackDequeClear(STACK_DEQUE *Deque)
+{
+	STACK_DEQUE_ARRAY *Array;
+
+	#if (STACK_SAFE_MODE == 1)
+		if(Deque == (STACK_DEQUE*)NULL)
+			return (BOOL)FALSE;
+	#endif // end of STACK_SAFE_MODE
+
+	if((Array = (STACK_DEQUE_ARRAY*)(Deque->Array)) == (STACK_DEQUE_ARRAY*)NULL)
+		return (BOOL)TRUE;
+
+	/*
+		Free the data left in the STACK_DEQUE newest first, the same order
+		StackDequePop() would have returned it in.
+	*/
+	#if(USING_STACK_DEPENDENT_FREE_METHOD == 1)
+		if(Deque->StackFreeMethod)
+		{
+			while(Deque->Bottom > Deque->Top)
+			{
+				Deque->Bottom--;
+				Deque->StackFreeMethod((void*)(Array->Data[Deque->Bottom & (Array->Size - 1)]));
+			}
+		}
+	#endif // end of USING_STACK_DEPENDENT_FREE_METHOD
+
+	/*
+		Free the current buffer and every one it replaced.
+	*/
+	while(Array != (STACK_DEQUE_ARRAY*)NULL)
+	{
+		Deque->Array = (STACK_DEQUE_ARRAY*)(Array->Previous);
+
+		StackMemDealloc((void*)Array);
+
+		Array = (STACK_DEQUE_ARRAY*)(Deque->Array);
+	}
+
+	Deque->Top = (INT64)0;
+	Deque->Bottom = (INT64)0;
+
+	return (BOOL)TRUE;
+}
+
+UINT32 StackDequeGetSize(STACK_DEQUE *Deque)
+{
+	INT64 Top, Bottom;
+
+	#if (STACK_SAFE_MODE == 1)
+		if(Deque == (STACK_DEQUE*)NULL)
+			return (UINT32)0;
+	#endif // end of STACK_SAFE_MODE
+
+	Bottom = (INT64)StackAtomicLoad(&Deque->Bottom);
+	Top = (INT64)StackAtomicLoad(&Deque->Top);
+
+	/*
+		A StackDequePop() in progress can have Bottom one below Top.
+	*/
+	if(Bottom <= Top)
+		return (UINT32)0;
+
+	return (UINT32)(Bottom - Top);
+}
+
+#endif // end of USING_STACK_DEQUE
@@ -0,0 +1,199 @@
+/*
+	Date: March 26, 2011
+	File Name: StackDeque.h
+	Version: 1.05
+	IDE: Visual Studio 2010 Professional
+	Compiler: C89
+
+	Description:
+	This file contains all the method headers for interfacing to the
+	STACK_DEQUE, a work stealing deque built alongside the Stack library.
+	The thread that owns a STACK_DEQUE uses it like a STACK, while idle
+	threads steal the oldest items out of it without a lock.  All methods
+	have their documentation above their declaration.
+*/
+
+#ifndef STACK_DEQUE_H
+	#define STACK_DEQUE_H
+
+#include "GenericTypeDefs.h"
+#include "StackConfig.h"
+#include "StackObject.h"
+
+#if (USING_STACK_DEQUE == 1)
+
+/*
+	Function: STACK_DEQUE *CreateStackDeque(STACK_DEQUE *Deque, void (*CustomFreeMethod)(void *Data))
+
+	Parameters:
+		STACK_DEQUE *Deque - The address at which the STACK_DEQUE will be
+		inititalized.  If NULL is passed in then this method will create a
+		STACK_DEQUE out of the heap with a call to StackMemAlloc().
+
+		void(*CustomFreeMethod)(void *Data) - A pointer to a method that the
+		user defines.  StackDequeClear() calls it on every piece of data
+		left in the STACK_DEQUE.
+
+	Returns:
+		STACK_DEQUE* - The address at which the newly initialized STACK_DEQUE
+		resides in memory.  If a new STACK_DEQUE could not be created then
+		(STACK_DEQUE*)NULL is returned.
+
+	Description: Creates a new, empty STACK_DEQUE in memory.  No buffer is
+	allocated until the first StackDequePush().
+
+	Notes: USING_STACK_DEQUE in StackConfig.h must be defined as 1 to use method.
+*/
+/**
+		* @brief Initializes a STACK_DEQUE, and can create a STACK_DEQUE.
+		* @param *Deque - A pointer to an already allocate STACK_DEQUE or a NULL
+		pointer to create a STACK_DEQUE from StackMemAlloc().
+		* @param *CustomFreeMethod - A method called by the STACK Library to delete
+		a piece of data left in the STACK_DEQUE.
+		* @return *STACK_DEQUE - The address of the STACK_DEQUE in memory.  If it could
+		not be allocated, returns a NULL pointer.
+		* @note USING_STACK_DEQUE in StackConfig.h must be defined as 1 to use method.
+		* @sa StackMemAlloc()
+		* @since v1.05
+*/
+STACK_DEQUE *CreateStackDeque(STACK_DEQUE *Deque, void (*CustomFreeMethod)(void *Data));
+
+/*
+	Function: BOOL StackDequePush(STACK_DEQUE *Deque, const void *Data)
+
+	Parameters:
+		STACK_DEQUE *Deque - The address at which the STACK_DEQUE resides in memory.
+		const void *Data - The data to push onto the owner's end of the STACK_DEQUE.
+
+	Returns:
+		BOOL - TRUE if the data was pushed.  FALSE if the STACK_DEQUE was NULL
+		or there wasn't enough memory to grow it.
+
+	Description: Pushes one item onto the owner's end of the STACK_DEQUE.  If
+	the buffer is full a new one twice the size is allocated with
+	StackMemAlloc() and the items are copied over.
+
+	Notes: Only the thread that owns the STACK_DEQUE may call this.
+	USING_STACK_DEQUE in StackConfig.h must be defined as 1 to use method.
+*/
+/**
+		* @brief Pushes one item onto the owner's end of the STACK_DEQUE.
+		* @param *Deque - The address at which the STACK_DEQUE resides in memory.
+		* @param *Data - The data to push.
+		* @return BOOL - TRUE if successful, FALSE otherwise.
+		* @note Owner thread only.  USING_STACK_DEQUE in StackConfig.h must be defined as 1 to use method.
+		* @sa StackDequePop(), StackDequeSteal()
+		* @since v1.05
+*/
+BOOL StackDequePush(STACK_DEQUE *Deque, const void *Data);
+
+/*
+	Function: void *StackDequePop(STACK_DEQUE *Deque)
+
+	Parameters:
+		STACK_DEQUE *Deque - The address at which the STACK_DEQUE resides in memory.
+
+	Returns:
+		void* - The newest piece of data in the STACK_DEQUE.  If it is empty,
+		a thief got the last item first, or the STACK_DEQUE is NULL then
+		(void*)NULL is returned.
+
+	Description: Pops the item last pushed, the same as StackPop() does for
+	a STACK.  Only races with thieves when one item is left.
+
+	Notes: Only the thread that owns the STACK_DEQUE may call this.
+	USING_STACK_DEQUE in StackConfig.h must be defined as 1 to use method.
+*/
+/**
+		* @brief Removes and returns the newest item in the STACK_DEQUE.
+		* @param *Deque - The address at which the STACK_DEQUE resides in memory.
+		* @return void* - The newest item, or (void*)NULL if there is none.
+		* @note Owner thread only.  USING_STACK_DEQUE in StackConfig.h must be defined as 1 to use method.
+		* @sa StackDequePush(), StackDequeSteal()
+		* @since v1.05
+*/
+void *StackDequePop(STACK_DEQUE *Deque);
+
+/*
+	Function: void *StackDequeSteal(STACK_DEQUE *Deque)
+
+	Parameters:
+		STACK_DEQUE *Deque - The address at which the STACK_DEQUE resides in memory.
+
+	Returns:
+		void* - The oldest piece of data in the STACK_DEQUE.  (void*)NULL if
+		it is empty, if another thread won the race for the item, or if the
+		STACK_DEQUE is NULL.
+
+	Description: Takes the oldest item out of the STACK_DEQUE without a lock.
+	Any number of threads can steal at once, and while the owner pushes and
+	pops.  A thief that gets (void*)NULL back should move on to another
+	STACK_DEQUE rather than spin on this one.
+
+	Notes: USING_STACK_DEQUE in StackConfig.h must be defined as 1 to use method.
+*/
+/**
+		* @brief Removes and returns the oldest item in the STACK_DEQUE from any thread.
+		* @param *Deque - The address at which the STACK_DEQUE resides in memory.
+		* @return void* - The oldest item, or (void*)NULL if none could be taken.
+		* @note USING_STACK_DEQUE in StackConfig.h must be defined as 1 to use method.
+		* @sa StackDequePop()
+		* @since v1.05
+*/
+void *StackDequeSteal(STACK_DEQUE *Deque);
+
+/*
+	Function: BOOL StackDequeClear(STACK_DEQUE *Deque)
+
+	Parameters:
+		STACK_DEQUE *Deque - The address at which the STACK_DEQUE resides in memory.
+
+	Returns:
+		BOOL - TRUE if the STACK_DEQUE was emptied.
+		FALSE - If a NULL referenced STACK_DEQUE was passed in.
+
+	Description: Frees the data left in the STACK_DEQUE if a method was
+	supplied at its creation, then frees every buffer it has used with
+	StackMemDealloc().  The STACK_DEQUE structure will still exist.
+
+	Notes: No other thread may be using the STACK_DEQUE while this runs.
+	USING_STACK_DEQUE in StackConfig.h must be defined as 1 to use method.
+*/
+/**
+		* @brief Frees all of a STACK_DEQUE's buffers and data(optional).
+		* @param *Deque - The address at which the STACK_DEQUE resides in memory.
+		* @return BOOL - TRUE if successful, FALSE if the STACK_DEQUE was NULL.
+		* @note No thief may be in the STACK_DEQUE.  USING_STACK_DEQUE in
+		StackConfig.h must be defined as 1 to use method.
+		* @sa StackMemDealloc()
+		* @since v1.05
+*/
+BOOL StackDequeClear(STACK_DEQUE *Deque);
+
+/*
+	Function: UINT32 StackDequeGetSize(STACK_DEQUE *Deque)
+
+	Parameters:
+		STACK_DEQUE *Deque - The address at which the STACK_DEQUE resides in memory.
+
+	Returns:
+		UINT32 - The number of items in the STACK_DEQUE, or 0 if it is NULL.
+
+	Description: Returns the size of the referenced STACK_DEQUE.
+
+	Notes: With thieves about the size may already be out of date when it is
+	returned.  USING_STACK_DEQUE in StackConfig.h must be defined as 1 to use method.
+*/
+/**
+		* @brief Will return the number of items in a STACK_DEQUE.
+		* @param *Deque - The address at which the STACK_DEQUE resides in memory.
+		* @return UINT32 - The number of items in the STACK_DEQUE.
+		* @note USING_STACK_DEQUE in StackConfig.h must be defined as 1 to use method.
+		* @sa None
+		* @since v1.05
+*/
+UINT32 StackDequeGetSize(STACK_DEQUE *Deque);
+
+#endif // end of USING_STACK_DEQUE
+
+#endif // end of STACK_DEQUE_H
@@ -0,0 +1,448 @@
+/*
+	Date: March 26, 2011
+	File Name: StackMapped.c
+	Version: 1.05
+	IDE: Visual Studio 2010 Professional
+	Compiler: C89
+
+	Description:
+	This file contains all the code which comprises
+	the MAPPED_STACK.  For method descriptions see
+	StackMapped.h.
+*/
+
+#include "StackMapped.h"
+
+#if (USING_STACK_MAPPED_METHODS == 1)
+
+#if (USE_MALLOC == 1)
+	#include "stdlib.h"
+#endif // end of USE_MALLOC
+
+#include "string.h"
+#include "stdio.h"
+#include "fcntl.h"
+#include "unistd.h"
+#include "sys/mman.h"
+#include "sys/stat.h"
+
+/*
+	Marks a file as a MAPPED_STACK, and the layout of the file.
+*/
+#define STACK_MAPPED_MAGIC						(UINT32)0x4B435453
+#define STACK_MAPPED_FILE_VERSION				(UINT32)1
+
+/*
+	The size in bytes of a file with room for Capacity items of ElementSize bytes.
+*/
+#define StackMappedFileSize(ElementSize, Capacity)	((UINT64)STACK_MAPPED_DATA_OFFSET + ((UINT64)(ElementSize) * (UINT64)(Capacity)))
+
+/*
+	The address of item Index of the MAPPED_STACK.
+*/
+#define StackMappedItem(Stack, Index)			((BYTE*)((Stack)->Header) + (Stack)->Header->DataOffset + ((UINT64)(Index) * (Stack)->Header->ElementSize))
+
+/*
+	Maps the first MapSize bytes of the MAPPED_STACK's file.  Returns
+	FALSE if mmap() failed.
+*/
+static BOOL StackMappedMap(MAPPED_STACK *Stack, UINT64 MapSize)
+{
+	void *Map;
+
+	if((Map = mmap((void*)NULL, (size_t)MapSize, PROT_READ | PROT_WRITE, MAP_SHARED, Stack->File, (off_t)0)) == MAP_FAILED)
+		return (BOOL)FALSE;
+
+	Stack->Header = (STACK_MAPPED_HEADER*)Map;
+	Stack->MapSize = (UINT64)MapSize;
+
+	return (BOOL)TRUE;
+}
+
+/*
+	Doubles the number of items the MAPPED_STACK's file has room for.
+	The file is grown before the header says so, so a program that stops
+	part way leaves a file that is bigger than it needs to be, never one
+	that is too small.
+*/
+static BOOL StackMappedGrow(MAPPED_STACK *Stack)
+{
+	STACK_MAPPED_HEADER *OldHeader;
+	UINT64 OldMapSize;
+	UINT32 ElementSize, Capacity;
+
+	ElementSize = (UINT32)(Stack->Header->ElementSize);
+	Capacity = Stack->Header->Capacity ? (UINT32)(Stack->Header->Capacity * 2) : (UINT32)STACK_MAPPED_INITIAL_CAPACITY;
+
+	if(Capacity <= Stack->Header->Capacity)
+		return (BOOL)FALSE;
+
+	if(ftruncate(Stack->File, (off_t)StackMappedFileSize(ElementSize, Capacity)) != 0)
+		return (BOOL)FALSE;
+
+	OldHeader = (STACK_MAPPED_HEADER*)(Stack->Header);
+	OldMapSize = (UINT64)(Stack->MapSize);
+
+	if(!StackMappedMap(Stack, StackMappedFileSize(ElementSize, Capacity)))
+		return (BOOL)FALSE;
+
+	munmap((void*)OldHeader, (size_t)OldMapSize);
+
+	Stack->Header->Capacity = (UINT32)Capacity;
+
+	return (BOOL)TRUE;
+}
+
+/*
+	Checks that the mapped file is a MAPPED_STACK of ElementSize byte
+	items that fits in FileSize bytes.
+*/
+static BOOL StackMappedIsValid(STACK_MAPPED_HEADER *Header, UINT32 ElementSize, UINT64 FileSize)
+{
+	if(Header->Magic != STACK_MAPPED_MAGIC || Header->Version != STACK_MAPPED_FILE_VERSION)
+		return (BOOL)FALSE;
+
+	if(Header->ElementSize != ElementSize || Header->DataOffset != (UINT32)STACK_MAPPED_DATA_OFFSET)
+		return (BOOL)FALSE;
+
+	if(Header->Size > Header->Capacity || StackMappedFileSize(ElementSize, Header->Capacity) > FileSize)
+		return (BOOL)FALSE;
+
+	return (BOOL)TRUE;
+}
+
+MAPPED_STACK *OpenMappedStack(MAPPED_STACK *Stack, const char *FileName, UINT32 ElementSize)
+{
+	struct stat FileStatus;
+	BOOL Allocated;
+
+	#if (STACK_SAFE_MODE == 1)
+		if(FileName == (const char*)NULL || ElementSize == (UINT32)0)
+			return (MAPPED_STACK*)NULL;
+	#endif // end of STACK_SAFE_MODE
+
+	/*
+		If Stack is equal to (MAPPED_STACK*)NULL then the user wants to
+		create a new MAPPED_STACK in memory
+	*/
+	Allocated = (BOOL)FALSE;
+
+	if(Stack == (MAPPED_STACK*)NULL)
+	{
+		if((Stack = (MAPPED_STACK*)StackMemAlloc(sizeof(MAPPED_STACK))) == (MAPPED_STACK*)NULL)
+		{
+			return (MAPPED_STACK*)NULL;
+		}
+
+		Allocated = (BOOL)TRUE;
+	}
+
+	Stack->Header = (STACK_MAPPED_HEADER*)NULL;
+	Stack->MapSize = (UINT64)0;
+
+	if((Stack->File = open(FileName, O_RDWR | O_CREAT, 0644)) < 0)
+		goto Failed;
+
+	if(fstat(Stack->File, &FileStatus) != 0)
+		goto Failed;
+
+	if(FileStatus.st_size == 0)
+	{
+		/*
+			A new file.  The magic number goes in last, so a file that was
+			never finished is turned away the next time.
+		*/
+		if(ftruncate(Stack->File, (off_t)StackMappedFileSize(ElementSize, STACK_MAPPED_INITIAL_CAPACITY)) != 0)
+			goto Failed;
+
+		if(!StackMappedMap(Stack, StackMappedFileSize(ElementSize, STACK_MAPPED_INITIAL_CAPACITY)))
+			goto Failed;
+
+		Stack->Header->Version = STACK_MAPPED_FILE_VERSION;
+		Stack->Header->ElementSize = (UINT32)ElementSize;
+		Stack->Header->Size = (UINT32)0;
+		Stack->Header->Capacity = (UINT32)STACK_MAPPED_INITIAL_CAPACITY;
+		Stack->Header->DataOffset = (UINT32)STACK_MAPPED_DATA_OFFSET;
+		StackAtomicStore(&Stack->Header->Magic, STACK_MAPPED_MAGIC);
+	}
+	else
+	{
+		/*
+			An existing file is mapped as it is.  Nothing past the header is
+			read, the items are only paged in as they are used.
+		*/
+		if((UINT64)FileStatus.st_size < (UINT64)STACK_MAPPED_DATA_OFFSET)
+			goto Failed;
+
+		if(!StackMappedMap(Stack, (UINT64)FileStatus.st_size))
+			goto Failed;
+
+		if(!StackMappedIsValid(Stack->Header, ElementSize, (UINT64)FileStatus.st_size))
+			goto Failed;
+	}
+
+	return (MAPPED_STACK*)Stack;
+
+Failed:
+	if(Stack->Header != (STACK_MAPPED_HEADER*)NULL)
+		munmap((void*)(Stack->Header), (size_t)(Stack->MapSize));
+
+	if(Stack->File >= 0)
+		close(Stack->File);
+
+	if(Allocated)
+		StackMemDealloc((void*)Stack);
+
+	return (MAPPED_STACK*)NULL;
+}
+
+BOOL MappedStackPush(MAPPED_STACK *Stack, const void *Value)
+{
+	UINT32 Size;
+
+	#if (STACK_SAFE_MODE == 1)
+		if(Stack == (MAPPED_STACK*)NULL || Value == (const void*)NULL)
+			return (BOOL)FALSE;
+	#endif // end of STACK_SAFE_MODE
+
+	Size = (UINT32)(Stack->Header->Size);
+
+	if(Size == Stack->Header->Capacity && !StackMappedGrow(Stack))
+		return (BOOL)FALSE;
+
+	/*
+		Write the item, and only then count it.
+	*/
+	memcpy((void*)StackMappedItem(Stack, Size), Value, Stack->Header->ElementSize);
+	StackAtomicStore(&Stack->Header->Size, Size + 1);
+
+	return (BOOL)TRUE;
+}
+
+BOOL MappedStackPop(MAPPED_STACK *Stack, void *Value)
+{
+	UINT32 Size;
+
+	#if (STACK_SAFE_MODE == 1)
+		if(Stack == (MAPPED_STACK*)NULL || Value == (void*)NULL)
+			return (BOOL)FALSE;
+	#endif // end of STACK_SAFE_MODE
+
+	if((Size = (UINT32)(Stack->Header->Size)) == (UINT32)0)
+		return (BOOL)FALSE;
+
+	memcpy(Value, (const void*)StackMappedItem(Stack, Size - 1), Stack->Header->ElementSize);
+	StackAtomicStore(&Stack->Header->Size, Size - 1);
+
+	return (BOOL)TRUE;
+}
+
+BOOL MappedStackPeek(MAPPED_STACK *Stack, void *Value)
+{
+	#if (STACK_SAFE_MODE == 1)
+		if(Stack == (MAPPED_STACK*)NULL || Value == (void*)NULL)
+			return (BOOL)FALSE;
+	#endif // end of STACK_SAFE_MODE
+
+	if(Stack->Header->Size == (UINT32)0)
+		return (BOOL)FALSE;
+
+	memcpy(Value, (const void*)StackMappedItem(Stack, Stack->Header->Size - 1), Stack->Header->ElementSize);
+
+	return (BOOL)TRUE;
+}
+
+BOOL MappedStackClear(MAPPED_STACK *Stack)
+{
+	#if (STACK_SAFE_MODE == 1)
+		if(Stack == (MAPPED_STACK*)NULL)
+			return (BOOL)FALSE;
+	#endif // end of STACK_SAFE_MODE
+
+	StackAtomicStore(&Stack->Header->Size, (UINT32)0);
+
+	return (BOOL)TRUE;
+}
+
+UINT32 MappedStackGetSize(MAPPED_STACK *Stack)
+{
+	#if (STACK_SAFE_MODE == 1)
+		if(Stack == (MAPPED_STACK*)NULL)
+			return (UINT32)0;
+	#endif // end of STACK_SAFE_MODE
+
+	return (UINT32)(Stack->Header->Size);
+}
+
+/*
+	fsync()s the directory FileName is in, so a file just renamed to
+	FileName stays there.  Buffer has to be at least as long as FileName,
+	and is used for the directory's name.  Returns FALSE if it failed.
+*/
+static BOOL StackMappedSyncDirectory(const char *FileName, char *Buffer)
+{
+	char *Slash;
+	int Directory;
+	BOOL Success;
+
+	strcpy(Buffer, FileName);
+
+	if((Slash = strrchr(Buffer, '/')) == (char*)NULL)
+		strcpy(Buffer, ".");
+	else if(Slash == Buffer)
+		Slash[1] = '\0';
+	else
+		*Slash = '\0';
+
+	if((Directory = open(Buffer, O_RDONLY)) < 0)
+		return (BOOL)FALSE;
+
+	Success = (BOOL)(fsync(Directory) == 0);
+
+	if(close(Directory) != 0)
+		Success = (BOOL)FALSE;
+
+	return (BOOL)Success;
+}
+
+BOOL StackSync(MAPPED_STACK *Stack)
+{
+	UINT64 PageSize, Start;
+	UINT32 Size;
+
+	#if (STACK_SAFE_MODE == 1)
+		if(Stack == (MAPPED_STACK*)NULL)
+			return (BOOL)FALSE;
+	#endif // end of STACK_SAFE_MODE
+
+	/*
+		The items have to be on disk before a size that counts them is.
+	*/
+	Size = (UINT32)(Stack->Header->Size);
+
+	if(Size)
+	{
+		/*
+			msync() only takes a page aligned address, and the items don't
+			start on a page of their own where pages are bigger than
+			STACK_MAPPED_DATA_OFFSET.  The mapping itself starts on a page.
+		*/
+		PageSize = (UINT64)sysconf(_SC_PAGESIZE);
+		Start = (UINT64)(Stack->Header->DataOffset) - ((UINT64)(Stack->Header->DataOffset) % PageSize);
+
+		if(msync((void*)((BYTE*)(Stack->Header) + Start), (size_t)((UINT64)(Stack->Header->DataOffset) - Start + (UINT64)Size * Stack->Header->ElementSize), MS_SYNC) != 0)
+			return (BOOL)FALSE;
+	}
+
+	if(msync((void*)(Stack->Header), sizeof(STACK_MAPPED_HEADER), MS_SYNC) != 0)
+		return (BOOL)FALSE;
+
+	return (BOOL)TRUE;
+}
+
+BOOL MappedStackSnapshot(MAPPED_STACK *Stack, const char *FileName)
+{
+	STACK_MAPPED_HEADER Header;
+	char *TempFileName;
+	BYTE *Buffer;
+	UINT64 Left;
+	ssize_t Written;
+	int File;
+	BOOL Success;
+
+	#if (STACK_SAFE_MODE == 1)
+		if(Stack == (MAPPED_STACK*)NULL || FileName == (const char*)NULL)
+			return (BOOL)FALSE;
+	#endif // end of STACK_SAFE_MODE
+
+	if((TempFileName = (char*)StackMemAlloc(strlen(FileName) + 5)) == (char*)NULL)
+		return (BOOL)FALSE;
+
+	strcpy(TempFileName, FileName);
+	strcat(TempFileName, ".tmp");
+
+	if((File = open(TempFileName, O_WRONLY | O_CREAT | O_TRUNC, 0644)) < 0)
+	{
+		StackMemDealloc((void*)TempFileName);
+
+		return (BOOL)FALSE;
+	}
+
+	/*
+		The snapshot only has room for the items in it, the first push
+		after it is opened grows it.
+	*/
+	Header = *Stack->Header;
+	Header.Capacity = (UINT32)(Header.Size);
+
+	Success = (BOOL)(ftruncate(File, (off_t)StackMappedFileSize(Header.ElementSize, Header.Capacity)) == 0);
+
+	/*
+		Write the items after the header's page, then the header itself.
+	*/
+	Buffer = (BYTE*)StackMappedItem(Stack, 0);
+	Left = (UINT64)Header.Size * Header.ElementSize;
+
+	if(Success && lseek(File, (off_t)STACK_MAPPED_DATA_OFFSET, SEEK_SET) < 0)
+		Success = (BOOL)FALSE;
+
+	while(Success && Left)
+	{
+		if((Written = write(File, (const void*)Buffer, (size_t)Left)) <= 0)
+		{
+			Success = (BOOL)FALSE;
+
+			break;
+		}
+
+		Buffer += Written;
+		Left -= (UINT64)Written;
+	}
+
+	if(Success && pwrite(File, (const void*)&Header, sizeof(STACK_MAPPED_HEADER), (off_t)0) != (ssize_t)sizeof(STACK_MAPPED_HEADER))
+		Success = (BOOL)FALSE;
+
+	/*
+		Only a snapshot that is all on disk takes the place of the old one.
+	*/
+	if(Success && fsync(File) != 0)
+		Success = (BOOL)FALSE;
+
+	if(close(File) != 0)
+		Success = (BOOL)FALSE;
+
+	if(Success && rename(TempFileName, FileName) != 0)
+		Success = (BOOL)FALSE;
+
+	if(!Success)
+		unlink(TempFileName);
+
+	/*
+		The rename is only on disk once the directory holding FileName is.
+	*/
+	if(Success && !StackMappedSyncDirectory(FileName, TempFileName))
+		Success = (BOOL)FALSE;
+
+	StackMemDealloc((void*)TempFileName);
+
+	return (BOOL)Success;
+}
+
+BOOL CloseMappedStack(MAPPED_STACK *Stack)
+{
+	#if (STACK_SAFE_MODE == 1)
+		if(Stack == (MAPPED_STACK*)NULL)
+			return (BOOL)FALSE;
+	#endif // end of STACK_SAFE_MODE
+
+	munmap((void*)(Stack->Header), (size_t)(Stack->MapSize));
+	close(Stack->File);
+
+	Stack->Header = (STACK_MAPPED_HEADER*)NULL;
+	Stack->MapSize = (UINT64)0;
+	Stack->File = -1;
+
+	return (BOOL)TRUE;
+}
+
+#endif // end of USING_STACK_MAPPED_METHODS
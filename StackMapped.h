@@ -0,0 +1,294 @@
+/*
+	Date: March 26, 2011
+	File Name: StackMapped.h
+	Version: 1.05
+	IDE: Visual Studio 2010 Professional
+	Compiler: C89
+
+	Description:
+	This file contains all the method headers for interfacing to the
+	MAPPED_STACK, a stack of fixed size items that lives in a file mapped
+	into memory with mmap().  Closing the MAPPED_STACK, or the program
+	stopping, leaves its items in the file, and opening the file again
+	picks up where it left off without pushing anything again.  All
+	methods have their documentation above their declaration.
+*/
+
+#ifndef STACK_MAPPED_H
+	#define STACK_MAPPED_H
+
+#include "GenericTypeDefs.h"
+#include "StackConfig.h"
+#include "StackObject.h"
+
+#if (USING_STACK_MAPPED_METHODS == 1)
+
+/*
+	Function: MAPPED_STACK *OpenMappedStack(MAPPED_STACK *Stack, const char *FileName, UINT32 ElementSize)
+
+	Parameters:
+		MAPPED_STACK *Stack - The address at which the MAPPED_STACK will be
+		inititalized.  If NULL is passed in then this method will create a
+		MAPPED_STACK out of the heap with a call to StackMemAlloc().
+
+		const char *FileName - The file the MAPPED_STACK keeps its items in.
+		It is created if it doesn't exist.
+
+		UINT32 ElementSize - The size in bytes of each item.  An existing file
+		must have been made with the same ElementSize.
+
+	Returns:
+		MAPPED_STACK* - The address at which the opened MAPPED_STACK resides
+		in memory.  (MAPPED_STACK*)NULL if the file couldn't be opened or
+		mapped, isn't a MAPPED_STACK file, was made with another ElementSize,
+		or ElementSize is 0.
+
+	Description: Opens the MAPPED_STACK kept in FileName, making the file
+	if it doesn't exist.  An existing file is mapped as it is, only its
+	header is read, so opening a deep MAPPED_STACK takes no longer than
+	opening an empty one.  The items are paged in as they are used.
+
+	Notes: USING_STACK_MAPPED_METHODS in StackConfig.h must be defined as 1 to use method.
+*/
+/**
+		* @brief Opens or creates the MAPPED_STACK kept in a file.
+		* @param *Stack - A pointer to an already allocate MAPPED_STACK or a NULL
+		pointer to create a MAPPED_STACK from StackMemAlloc().
+		* @param *FileName - The file the MAPPED_STACK lives in.
+		* @param ElementSize - The size in bytes of each item.
+		* @return *MAPPED_STACK - The address of the MAPPED_STACK in memory.  If it
+		could not be opened, returns a NULL pointer.
+		* @note USING_STACK_MAPPED_METHODS in StackConfig.h must be defined as 1 to use method.
+		* @sa CloseMappedStack(), StackSync()
+		* @since v1.05
+*/
+MAPPED_STACK *OpenMappedStack(MAPPED_STACK *Stack, const char *FileName, UINT32 ElementSize);
+
+/*
+	Function: BOOL MappedStackPush(MAPPED_STACK *Stack, const void *Value)
+
+	Parameters:
+		MAPPED_STACK *Stack - The address at which the MAPPED_STACK resides in memory.
+		const void *Value - The address of the item to copy onto the MAPPED_STACK.
+
+	Returns:
+		BOOL - TRUE if the item was pushed.  FALSE if the MAPPED_STACK or
+		Value was NULL, or the file couldn't be grown.
+
+	Description: Copies ElementSize bytes from Value onto the top of the
+	MAPPED_STACK.  When the file is full it is doubled in size and mapped
+	again.  The item is written before the size in the file is updated, so
+	a program that stops part way through a push leaves the file as it was
+	before the push.
+
+	Notes: USING_STACK_MAPPED_METHODS in StackConfig.h must be defined as 1 to use method.
+*/
+/**
+		* @brief Copies an item onto the top of a MAPPED_STACK.
+		* @param *Stack - The address at which the MAPPED_STACK resides in memory.
+		* @param *Value - The item to copy in.
+		* @return BOOL - TRUE if successful, FALSE otherwise.
+		* @note USING_STACK_MAPPED_METHODS in StackConfig.h must be defined as 1 to use method.
+		* @sa MappedStackPop()
+		* @since v1.05
+*/
+BOOL MappedStackPush(MAPPED_STACK *Stack, const void *Value);
+
+/*
+	Function: BOOL MappedStackPop(MAPPED_STACK *Stack, void *Value)
+
+	Parameters:
+		MAPPED_STACK *Stack - The address at which the MAPPED_STACK resides in memory.
+		void *Value - Where to copy the top item to.  Must have room for
+		ElementSize bytes.
+
+	Returns:
+		BOOL - TRUE if an item was popped into Value.  FALSE if the
+		MAPPED_STACK was empty, or it or Value was NULL.
+
+	Description: Copies the top item of the MAPPED_STACK into Value and
+	removes it.  The file is never made smaller by a pop.
+
+	Notes: USING_STACK_MAPPED_METHODS in StackConfig.h must be defined as 1 to use method.
+*/
+/**
+		* @brief Removes the top item of a MAPPED_STACK, copying it out.
+		* @param *Stack - The address at which the MAPPED_STACK resides in memory.
+		* @param *Value - Where the item is copied to.
+		* @return BOOL - TRUE if successful, FALSE otherwise.
+		* @note USING_STACK_MAPPED_METHODS in StackConfig.h must be defined as 1 to use method.
+		* @sa MappedStackPush()
+		* @since v1.05
+*/
+BOOL MappedStackPop(MAPPED_STACK *Stack, void *Value);
+
+/*
+	Function: BOOL MappedStackPeek(MAPPED_STACK *Stack, void *Value)
+
+	Parameters:
+		MAPPED_STACK *Stack - The address at which the MAPPED_STACK resides in memory.
+		void *Value - Where to copy the top item to.  Must have room for
+		ElementSize bytes.
+
+	Returns:
+		BOOL - TRUE if the top item was copied into Value.  FALSE if the
+		MAPPED_STACK was empty, or it or Value was NULL.
+
+	Description: Copies the top item of the MAPPED_STACK into Value, leaving
+	it on the MAPPED_STACK.
+
+	Notes: USING_STACK_MAPPED_METHODS in StackConfig.h must be defined as 1 to use method.
+*/
+/**
+		* @brief Copies out the top item of a MAPPED_STACK without removing it.
+		* @param *Stack - The address at which the MAPPED_STACK resides in memory.
+		* @param *Value - Where the item is copied to.
+		* @return BOOL - TRUE if successful, FALSE otherwise.
+		* @note USING_STACK_MAPPED_METHODS in StackConfig.h must be defined as 1 to use method.
+		* @sa MappedStackPop()
+		* @since v1.05
+*/
+BOOL MappedStackPeek(MAPPED_STACK *Stack, void *Value);
+
+/*
+	Function: BOOL MappedStackClear(MAPPED_STACK *Stack)
+
+	Parameters:
+		MAPPED_STACK *Stack - The address at which the MAPPED_STACK resides in memory.
+
+	Returns:
+		BOOL - TRUE if the MAPPED_STACK was emptied.
+		FALSE - If a NULL referenced MAPPED_STACK was passed in.
+
+	Description: Removes every item from the MAPPED_STACK.  The file keeps
+	its size.
+
+	Notes: USING_STACK_MAPPED_METHODS in StackConfig.h must be defined as 1 to use method.
+*/
+/**
+		* @brief Removes every item from a MAPPED_STACK.
+		* @param *Stack - The address at which the MAPPED_STACK resides in memory.
+		* @return BOOL - TRUE if successful, FALSE if the MAPPED_STACK was NULL.
+		* @note USING_STACK_MAPPED_METHODS in StackConfig.h must be defined as 1 to use method.
+		* @sa None
+		* @since v1.05
+*/
+BOOL MappedStackClear(MAPPED_STACK *Stack);
+
+/*
+	Function: UINT32 MappedStackGetSize(MAPPED_STACK *Stack)
+
+	Parameters:
+		MAPPED_STACK *Stack - The address at which the MAPPED_STACK resides in memory.
+
+	Returns:
+		UINT32 - The number of items in the MAPPED_STACK, or 0 if it is NULL.
+
+	Description: Returns the size of the referenced MAPPED_STACK.
+
+	Notes: USING_STACK_MAPPED_METHODS in StackConfig.h must be defined as 1 to use method.
+*/
+/**
+		* @brief Will return the number of items in a MAPPED_STACK.
+		* @param *Stack - The address at which the MAPPED_STACK resides in memory.
+		* @return UINT32 - The number of items in the MAPPED_STACK.
+		* @note USING_STACK_MAPPED_METHODS in StackConfig.h must be defined as 1 to use method.
+		* @sa None
+		* @since v1.05
+*/
+UINT32 MappedStackGetSize(MAPPED_STACK *Stack);
+
+/*
+	Function: BOOL StackSync(MAPPED_STACK *Stack)
+
+	Parameters:
+		MAPPED_STACK *Stack - The address at which the MAPPED_STACK resides in memory.
+
+	Returns:
+		BOOL - TRUE once the MAPPED_STACK is on disk.  FALSE if it was NULL
+		or msync() failed.
+
+	Description: Writes the MAPPED_STACK's items out to disk and waits for
+	them, and only then writes out the header holding its size.  If the
+	system goes down after StackSync() returns, the file holds the
+	MAPPED_STACK as it was at the call.  If it goes down in between calls,
+	the size on disk may be ahead of the items that made it there, use
+	MappedStackSnapshot() for a copy that is always whole.
+
+	Notes: USING_STACK_MAPPED_METHODS in StackConfig.h must be defined as 1 to use method.
+*/
+/**
+		* @brief Flushes a MAPPED_STACK to disk, items first then its size.
+		* @param *Stack - The address at which the MAPPED_STACK resides in memory.
+		* @return BOOL - TRUE if successful, FALSE otherwise.
+		* @note USING_STACK_MAPPED_METHODS in StackConfig.h must be defined as 1 to use method.
+		* @sa MappedStackSnapshot()
+		* @since v1.05
+*/
+BOOL StackSync(MAPPED_STACK *Stack);
+
+/*
+	Function: BOOL MappedStackSnapshot(MAPPED_STACK *Stack, const char *FileName)
+
+	Parameters:
+		MAPPED_STACK *Stack - The address at which the MAPPED_STACK resides in memory.
+		const char *FileName - The file to write the snapshot to.  An existing
+		file is replaced.
+
+	Returns:
+		BOOL - TRUE if the snapshot was written.  FALSE if the MAPPED_STACK
+		or FileName was NULL, or the snapshot couldn't be written, in which
+		case an existing FileName is left alone.
+
+	Description: Writes a copy of the MAPPED_STACK as it is right now to
+	FileName, which can later be opened with OpenMappedStack().  The copy
+	is written to a file next to FileName, flushed to disk, and then
+	renamed over FileName, so FileName always holds either the old
+	snapshot or the whole new one, even if the system goes down part way.
+	The directory is flushed after the rename, so once this returns TRUE
+	FileName is the new snapshot on disk too.
+
+	Notes: USING_STACK_MAPPED_METHODS in StackConfig.h must be defined as 1 to use method.
+*/
+/**
+		* @brief Writes a crash consistent copy of a MAPPED_STACK to a file.
+		* @param *Stack - The address at which the MAPPED_STACK resides in memory.
+		* @param *FileName - The file to write the snapshot to.
+		* @return BOOL - TRUE if successful, FALSE otherwise.
+		* @note USING_STACK_MAPPED_METHODS in StackConfig.h must be defined as 1 to use method.
+		* @sa OpenMappedStack(), StackSync()
+		* @since v1.05
+*/
+BOOL MappedStackSnapshot(MAPPED_STACK *Stack, const char *FileName);
+
+/*
+	Function: BOOL CloseMappedStack(MAPPED_STACK *Stack)
+
+	Parameters:
+		MAPPED_STACK *Stack - The address at which the MAPPED_STACK resides in memory.
+
+	Returns:
+		BOOL - TRUE if the MAPPED_STACK was closed.
+		FALSE - If a NULL referenced MAPPED_STACK was passed in.
+
+	Description: Unmaps and closes the MAPPED_STACK's file.  The items stay
+	in the file for the next OpenMappedStack().  The MAPPED_STACK structure
+	will still exist.
+
+	Notes: Call StackSync() first if the items must be on disk rather than
+	just in the file.  USING_STACK_MAPPED_METHODS in StackConfig.h must be
+	defined as 1 to use method.
+*/
+/**
+		* @brief Closes a MAPPED_STACK, leaving its items in its file.
+		* @param *Stack - The address at which the MAPPED_STACK resides in memory.
+		* @return BOOL - TRUE if successful, FALSE if the MAPPED_STACK was NULL.
+		* @note USING_STACK_MAPPED_METHODS in StackConfig.h must be defined as 1 to use method.
+		* @sa OpenMappedStack(), StackSync()
+		* @since v1.05
+*/
+BOOL CloseMappedStack(MAPPED_STACK *Stack);
+
+#endif // end of USING_STACK_MAPPED_METHODS
+
+#endif // end of STACK_MAPPED_H
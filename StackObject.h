@@ -16,26 +16,302 @@
 
 #include "GenericTypeDefs.h"
 
+#if (USING_STACK_SPILL_METHODS == 1)
+	#include "stdio.h"
+#endif // end of USING_STACK_SPILL_METHODS
+
+#if (USING_STACK_SYNCHRONIZED_METHODS == 1) || (USING_STACK_ALLOCATORS == 1)
+	#include "pthread.h"
+#endif // end of USING_STACK_SYNCHRONIZED_METHODS or USING_STACK_ALLOCATORS
+
 /*
 	The following struct is a node within the Stack.
 	Each node points to a piece of data that the user
-	passed in when calling StackPush().
+	passed in when calling StackPush().  With chunked
+	storage each node instead holds a block of them.
+	A node of a value STACK holds copies of the items
+	themselves, in Data's slots with chunked storage 
+	and right after the node otherwise.
 */
 struct _StackNode
 {
-	/**
-	* A pointer to the data that the STACK_NODE will point to.
-	*/
-	void *Data;
+	#if (USING_STACK_CHUNKED_STORAGE == 1)
+		/**
+		* A pointer to the next STACK_NODE in the STACK.  Every STACK_NODE
+		* below the top one holds at least one item, and is full unless it
+		* was the top of a STACK that was spliced on top of another.
+		*/
+		struct _StackNode *Next;
 
-	/**
-	* A pointer to the next STACK_NODE in the STACK.
-	*/
-	struct _StackNode *Next;
+		/**
+		* The number of slots in Data that are in use.
+		*/
+		UINT32 Count;
+
+		/**
+		* The data pointers stored in the STACK_NODE, bottom first.  The
+		* STACK_NODE is allocated with room for the STACK's ElementsPerNode
+		* pointers.
+		*/
+		void *Data[1];
+	#else
+		/**
+		* A pointer to the data that the STACK_NODE will point to.
+		*/
+		void *Data;
+
+		/**
+		* A pointer to the next STACK_NODE in the STACK.
+		*/
+		struct _StackNode *Next;
+
+		#if (USING_STACK_PERSISTENT_METHODS == 1)
+			/**
+			* How many STACK's and STACK_NODE's point at this STACK_NODE.
+			* Clones made with StackClone() share their STACK_NODE's, and a
+			* STACK_NODE is only freed once nothing points at it anymore.
+			*/
+			UINT32 References;
+		#endif // end of USING_STACK_PERSISTENT_METHODS
+	#endif // end of USING_STACK_CHUNKED_STORAGE
 };
 
 typedef struct _StackNode STACK_NODE;
 
+#if (USING_STACK_NODE_ARENA == 1)
+	/*
+		The following struct starts each block of memory a STACK's
+		node arena carves STACK_NODE's out of.  The STACK_NODE's
+		follow it in the block.
+	*/
+	struct _StackArenaBlock
+	{
+		/**
+		* The block the arena got before this one, or NULL.
+		*/
+		struct _StackArenaBlock *Next;
+
+		#if (USING_STACK_HUGE_PAGE_ARENA == 1)
+			/**
+			* The number of bytes mapped for the block.
+			*/
+			UINT32 SizeInBytes;
+
+			/**
+			* How the block was mapped, whether on huge pages or not.
+			*/
+			UINT32 Backing;
+		#endif // end of USING_STACK_HUGE_PAGE_ARENA
+	};
+
+	typedef struct _StackArenaBlock STACK_ARENA_BLOCK;
+
+	#if (USING_STACK_HUGE_PAGE_ARENA == 1)
+		/*
+			The following struct is filled in by StackGetHugePageCoverage()
+			with how much of a STACK's node arena is on huge pages.
+		*/
+		struct _StackHugePageCoverage
+		{
+			/**
+			* The number of bytes of all the blocks of the node arena.
+			*/
+			UINT64 ArenaBytes;
+
+			/**
+			* The bytes of the blocks that were mapped with MAP_HUGETLB, which
+			* are always on huge pages.
+			*/
+			UINT64 HugeTlbBytes;
+
+			/**
+			* The bytes of the blocks the kernel was asked to put on 
+			* transparent huge pages with madvise(MADV_HUGEPAGE).  It does so
+			* as it finds room, so some of them may still be on small pages.
+			*/
+			UINT64 AdvisedBytes;
+		};
+
+		typedef struct _StackHugePageCoverage STACK_HUGE_PAGE_COVERAGE;
+	#endif // end of USING_STACK_HUGE_PAGE_ARENA
+#endif // end of USING_STACK_NODE_ARENA
+
+#if (USING_STACK_STATISTICS == 1)
+	/*
+		The following struct holds the counters each STACK keeps
+		about how it has been used.  StackGetStats() hands out a
+		copy of it.
+	*/
+	struct _StackStats
+	{
+		/**
+		* The number of items pushed onto the STACK.
+		*/
+		UINT64 Pushes;
+
+		/**
+		* The number of items popped off of the STACK.
+		*/
+		UINT64 Pops;
+
+		/**
+		* The most items the STACK has held at once.
+		*/
+		UINT32 PeakSize;
+
+		/**
+		* The number of times the STACK could not get memory for a STACK_NODE.
+		*/
+		UINT32 AllocationFailures;
+
+		/**
+		* The number of times StackClear() was called on the STACK.
+		*/
+		UINT32 Clears;
+
+		#if (USING_STACK_LATENCY_HISTOGRAM == 1)
+			/**
+			* The number of calls left until the next one is timed.
+			*/
+			UINT32 SampleCountdown;
+
+			/**
+			* How long the timed StackPush() calls took, see STACK_LATENCY_HISTOGRAM_BUCKETS.
+			*/
+			UINT32 PushLatency[STACK_LATENCY_HISTOGRAM_BUCKETS];
+
+			/**
+			* How long the timed StackPop() calls took, see STACK_LATENCY_HISTOGRAM_BUCKETS.
+			*/
+			UINT32 PopLatency[STACK_LATENCY_HISTOGRAM_BUCKETS];
+		#endif // end of USING_STACK_LATENCY_HISTOGRAM
+	};
+
+	typedef struct _StackStats STACK_STATS;
+#endif // end of USING_STACK_STATISTICS
+
+#if (USING_STACK_ALLOCATORS == 1)
+	/*
+		The following struct describes where a STACK gets its memory
+		from.  Alloc and Free are handed Context on every call, so one
+		pair of methods can serve many arenas.
+	*/
+	struct _StackAllocator
+	{
+		/**
+		* Returns Size bytes of memory, or NULL if there isn't enough.
+		*/
+		void *(*Alloc)(void *Context, UINT32 Size);
+
+		/**
+		* Gives back memory Alloc returned.
+		*/
+		void (*Free)(void *Context, void *Memory);
+
+		/**
+		* Passed to Alloc and Free as is.
+		*/
+		void *Context;
+	};
+
+	typedef struct _StackAllocator STACK_ALLOCATOR;
+
+	/*
+		The following struct starts every block a STACK_ALLOCATOR_ARENA
+		gets from the system.  Blocks are STACK_ALLOCATOR_BLOCK_SIZE bytes
+		and start on a multiple of it, so the block any piece of memory
+		came out of is found by rounding its address down.
+	*/
+	struct _StackAllocatorBlock
+	{
+		/**
+		* The blocks of the arena before and after this one.
+		*/
+		struct _StackAllocatorBlock *Next, *Previous;
+
+		/**
+		* The arena the block belongs to.
+		*/
+		struct _StackAllocatorArena *Arena;
+
+		/**
+		* The size of every piece of memory in the block.  0 if the block
+		* holds a single allocation too big for any size class.
+		*/
+		UINT32 ObjectSize;
+
+		/**
+		* The number of bytes the block takes up.
+		*/
+		UINT64 SizeInBytes;
+	};
+
+	typedef struct _StackAllocatorBlock STACK_ALLOCATOR_BLOCK;
+
+	/*
+		The following struct is an arena the built in allocators in 
+		StackAllocators.c carve memory out of.  Memory is handed out in 
+		size classes STACK_ALLOCATOR_ALIGNMENT bytes apart, so every 
+		STACK_NODE of a STACK comes from the same class, and freed memory
+		goes on its class's free list to be handed out again.
+	*/
+	struct _StackAllocatorArena
+	{
+		/**
+		* Every block the arena has, newest first.
+		*/
+		STACK_ALLOCATOR_BLOCK *Blocks;
+
+		/**
+		* The memory of each size class that was freed and can be reused.
+		*/
+		void *FreeObjects[STACK_ALLOCATOR_MAX_OBJECT_SIZE / STACK_ALLOCATOR_ALIGNMENT];
+
+		/**
+		* Where the next piece of each size class is carved out of its 
+		* newest block, and how many bytes that block has left.
+		*/
+		BYTE *Next[STACK_ALLOCATOR_MAX_OBJECT_SIZE / STACK_ALLOCATOR_ALIGNMENT];
+		UINT32 BytesLeft[STACK_ALLOCATOR_MAX_OBJECT_SIZE / STACK_ALLOCATOR_ALIGNMENT];
+
+		/**
+		* Memory freed by a thread the arena doesn't belong to, waiting for
+		* the owning thread to put it on its free lists.  Only used by 
+		* thread local arenas.
+		*/
+		void *RemoteFreeObjects;
+
+		/**
+		* The number of pieces of memory the arena has handed out that 
+		* haven't been put back on its free lists.
+		*/
+		UINT32 LiveObjects;
+
+		/**
+		* Once the thread a thread local arena belongs to has exited, the
+		* number of pieces of memory that are still out, plus one while 
+		* the exiting thread is still counting.  Whoever brings it to 0 
+		* releases the arena.
+		*/
+		UINT32 OrphanedObjects;
+
+		/**
+		* The NUMA node the arena's blocks are placed on, or -1 for any.
+		*/
+		int Node;
+
+		/**
+		* TRUE if any thread can use the arena, in which case Lock is held
+		* around every use of it.
+		*/
+		BOOL Shared;
+
+		pthread_mutex_t Lock;
+	};
+
+	typedef struct _StackAllocatorArena STACK_ALLOCATOR_ARENA;
+#endif // end of USING_STACK_ALLOCATORS
+
 /*
 	The following struct is the Stack Head itself.
 	There is only one of these per Stack, and it points
@@ -54,11 +330,613 @@ struct _Stack
 	*/
 	STACK_NODE *TopOfStack;
 
+	#if (USING_STACK_SPLICE_METHODS == 1)
+		/**
+		* A pointer to the last STACK_NODE in the STACK, so StackSplice() can
+		* hang another STACK's STACK_NODE's under it.  Only meaningful while
+		* TopOfStack isn't (STACK_NODE*)NULL.
+		*/
+		STACK_NODE *BottomOfStack;
+	#endif // end of USING_STACK_SPLICE_METHODS
+
 	#if(USING_STACK_DEPENDENT_FREE_METHOD == 1)
 		void (*StackFreeMethod)(void *Data);
 	#endif // end of USING_STACK_DEPENDENT_FREE_METHOD
+
+	#if (USING_STACK_ALLOCATORS == 1)
+		/**
+		* Where the STACK gets the memory for its STACK_NODE's.
+		*/
+		STACK_ALLOCATOR Allocator;
+	#endif // end of USING_STACK_ALLOCATORS
+
+	#if (USING_STACK_CHUNKED_STORAGE == 1)
+		/**
+		* The number of data pointers each STACK_NODE of this STACK holds.
+		*/
+		UINT32 ElementsPerNode;
+	#endif // end of USING_STACK_CHUNKED_STORAGE
+
+	#if (USING_STACK_VALUE_METHODS == 1)
+		/**
+		* The size in bytes of each item a STACK made with CreateValueStack()
+		* holds.  0 if the STACK holds data pointers.
+		*/
+		UINT32 ElementSize;
+	#endif // end of USING_STACK_VALUE_METHODS
+
+	#if (USING_STACK_BOUNDED_METHODS == 1)
+		/**
+		* The caller's buffer a STACK made with CreateBoundedStack() keeps its
+		* data pointers in, bottom first.  (void**)NULL for any other STACK.
+		*/
+		void **Buffer;
+
+		/**
+		* The number of data pointers Buffer has room for.
+		*/
+		UINT32 Capacity;
+	#endif // end of USING_STACK_BOUNDED_METHODS
+
+	#if (USING_STACK_SPILL_METHODS == 1)
+		/**
+		* The most items the STACK keeps in memory before moving its bottom 
+		* items out to SpillFile.  0 if the STACK has no memory budget.
+		*/
+		UINT32 MaxInMemoryItems;
+
+		/**
+		* The number of items, counted in Size, that are in SpillFile.  They
+		* are the bottom SpilledSize items of the STACK, bottom first.
+		*/
+		UINT32 SpilledSize;
+
+		/**
+		* The temporary file holding the spilled items, or (FILE*)NULL.
+		*/
+		FILE *SpillFile;
+	#endif // end of USING_STACK_SPILL_METHODS
+
+	#if (USING_STACK_SERIALIZE_METHODS == 1)
+		/**
+		* The items of a STACK made with CreateStackView(), bottom first, in
+		* the serialized buffer it was made over.  (const BYTE*)NULL for any
+		* other STACK.
+		*/
+		const BYTE *View;
+	#endif // end of USING_STACK_SERIALIZE_METHODS
+
+	#if (USING_STACK_NODE_ARENA == 1)
+		/**
+		* Every block the STACK's node arena has gotten from StackMemAlloc(),
+		* newest first.  (STACK_ARENA_BLOCK*)NULL until the first push.
+		*/
+		STACK_ARENA_BLOCK *ArenaBlocks;
+
+		/**
+		* Where the next STACK_NODE is carved out of the newest block.
+		*/
+		BYTE *ArenaNext;
+
+		/**
+		* The number of bytes left in the newest block.
+		*/
+		UINT32 ArenaBytesLeft;
+
+		/**
+		* STACK_NODE's that were removed from the STACK.  They can't be 
+		* freed on their own, so they are reused before the arena carves
+		* out new ones.
+		*/
+		STACK_NODE *ArenaFreeNodes;
+
+		#if (USING_STACK_MARK_METHODS == 1)
+			/**
+			* The first of ArenaFreeNodes that was already free when the 
+			* newest mark was made.  It and the ones after it aren't reused,
+			* so that StackRewind() finds them as they were.
+			*/
+			STACK_NODE *ArenaFreeFloor;
+
+			/**
+			* Counts how many times the arena has been handed back, so a 
+			* mark made in an arena that is gone can be told apart.
+			*/
+			UINT32 ArenaGeneration;
+
+			/**
+			* Hands out a number to every mark.  The newest mark is the one
+			* made or rewound last, and the STACK keeps the number of the 
+			* mark before it and how far the STACK was popped between the two.
+			*/
+			UINT32 MarkSerial;
+			UINT32 NewestMark;
+			UINT32 NewestPrevious;
+			UINT32 NewestLowWater;
+
+			/**
+			* The smallest size the STACK has been popped down to since the
+			* newest mark, and before it.  A mark the STACK has been popped 
+			* below can't be rewound.
+			*/
+			UINT32 MarkLowWater;
+			UINT32 MarkDip;
+		#endif // end of USING_STACK_MARK_METHODS
+	#endif // end of USING_STACK_NODE_ARENA
+
+	#if (USING_STACK_INLINE_BUFFER == 1)
+		/**
+		* The memory the STACK's first STACK_NODE's are carved out of.  It is
+		* declared as pointers so the STACK_NODE's are aligned.  A STACK 
+		* can't be copied or moved once it has been pushed onto.
+		*/
+		void *InlineBuffer[STACK_INLINE_BUFFER_SIZE / sizeof(void*)];
+
+		/**
+		* The number of bytes at the start of InlineBuffer that have been
+		* carved into STACK_NODE's.
+		*/
+		UINT32 InlineBytesUsed;
+
+		/**
+		* The number of STACK_NODE's from InlineBuffer that are in the STACK.
+		*/
+		UINT32 InlineNodesInUse;
+
+		/**
+		* STACK_NODE's from InlineBuffer that were removed from the STACK, 
+		* reused before any others.
+		*/
+		STACK_NODE *InlineFreeNodes;
+	#endif // end of USING_STACK_INLINE_BUFFER
+
+	#if (USING_STACK_NODE_CACHE == 1)
+		/**
+		* A list of STACK_NODE's that were removed from the STACK and are being
+		* kept for reuse by StackPush().  This will point to (STACK_NODE*)NULL
+		* if there are no STACK_NODE's in the cache.
+		*/
+		STACK_NODE *NodeCache;
+
+		/**
+		* The number of STACK_NODE's currently held in NodeCache.
+		*/
+		UINT32 NodeCacheSize;
+
+		/**
+		* The most STACK_NODE's NodeCache will hold.  Any STACK_NODE removed from
+		* the STACK past this limit is freed with StackMemDealloc().
+		*/
+		UINT32 NodeCacheLimit;
+	#endif // end of USING_STACK_NODE_CACHE
+
+	#if (USING_STACK_STATISTICS == 1)
+		/**
+		* The counters kept on how the STACK has been used.
+		*/
+		STACK_STATS Stats;
+	#endif // end of USING_STACK_STATISTICS
 };
 
 typedef struct _Stack STACK;
 
+#if (USING_STACK_MARK_METHODS == 1)
+	/*
+		The following struct is a checkpoint of a STACK made with
+		StackMark().  StackRewind() puts the STACK and its node 
+		arena back the way they were when it was made.  Its members
+		are only for the STACK Library to use.
+	*/
+	struct _StackMark
+	{
+		/**
+		* The size of the STACK.
+		*/
+		UINT32 Size;
+
+		/**
+		* The top STACK_NODE of the STACK.
+		*/
+		STACK_NODE *TopOfStack;
+
+		#if (USING_STACK_CHUNKED_STORAGE == 1)
+			/**
+			* The number of slots of the top STACK_NODE that were in use.
+			*/
+			UINT32 TopCount;
+		#endif // end of USING_STACK_CHUNKED_STORAGE
+
+		/**
+		* Where the STACK's node arena was.
+		*/
+		STACK_ARENA_BLOCK *ArenaBlocks;
+		BYTE *ArenaNext;
+		UINT32 ArenaBytesLeft;
+		STACK_NODE *ArenaFreeNodes;
+		STACK_NODE *ArenaFreeFloor;
+
+		/**
+		* The STACK's ArenaGeneration, the number of this mark and of the 
+		* newest one before it, and the STACK's MarkLowWater from before 
+		* the mark was made.
+		*/
+		UINT32 ArenaGeneration;
+		UINT32 Serial;
+		UINT32 PreviousMark;
+		UINT32 LowWater;
+	};
+
+	typedef struct _StackMark STACK_MARK;
+#endif // end of USING_STACK_MARK_METHODS
+
+#if (USING_STACK_CONCURRENT_METHODS == 1)
+	/*
+		The following struct is a node within a CONCURRENT_STACK.
+		Once a CONCURRENT_STACK_NODE is popped it is only freed
+		after no thread can still be looking at it.
+	*/
+	struct _ConcurrentStackNode
+	{
+		/**
+		* A pointer to the data that the CONCURRENT_STACK_NODE will point to.
+		*/
+		void *Data;
+
+		/**
+		* A pointer to the next CONCURRENT_STACK_NODE in the CONCURRENT_STACK.
+		* After the node is popped this links it into its thread's retired list.
+		*/
+		struct _ConcurrentStackNode *Next;
+	};
+
+	typedef struct _ConcurrentStackNode CONCURRENT_STACK_NODE;
+
+	#if (USING_STACK_ELIMINATION_BACKOFF == 1)
+		/*
+			One slot of a CONCURRENT_STACK's elimination array.  A push that
+			lost the race for the top leaves its node here for a pop to take.
+		*/
+		struct _StackEliminationSlot
+		{
+			/**
+			* The CONCURRENT_STACK_NODE on offer, NULL if the slot is free, or 
+			* a marker node once a pop has taken the offer.
+			*/
+			CONCURRENT_STACK_NODE *Offer;
+
+			BYTE Padding[STACK_CACHE_LINE_SIZE - sizeof(CONCURRENT_STACK_NODE*)];
+		};
+
+		typedef struct _StackEliminationSlot STACK_ELIMINATION_SLOT;
+	#endif // end of USING_STACK_ELIMINATION_BACKOFF
+
+	/*
+		The following struct is the head of a lock free stack that
+		any number of threads can push onto and pop from at once.
+		TopOfStack and Size are kept on their own cache lines.
+	*/
+	struct _ConcurrentStack
+	{
+		/**
+		* A pointer to the first CONCURRENT_STACK_NODE in the CONCURRENT_STACK.
+		* Only ever changed with StackAtomicCompareAndSwap().
+		*/
+		CONCURRENT_STACK_NODE *TopOfStack;
+
+		BYTE TopOfStackPadding[STACK_CACHE_LINE_SIZE - sizeof(CONCURRENT_STACK_NODE*)];
+
+		/**
+		* The current size of the CONCURRENT_STACK.  Only ever changed with StackAtomicAdd().
+		*/
+		UINT32 Size;
+
+		BYTE SizePadding[STACK_CACHE_LINE_SIZE - sizeof(UINT32)];
+
+		#if(USING_STACK_DEPENDENT_FREE_METHOD == 1)
+			void (*StackFreeMethod)(void *Data);
+		#endif // end of USING_STACK_DEPENDENT_FREE_METHOD
+
+		#if (USING_STACK_ELIMINATION_BACKOFF == 1)
+			/**
+			* TRUE if the CONCURRENT_STACK was made with CreateEliminationStack().
+			*/
+			BOOL UsingElimination;
+
+			/**
+			* Where pushes and pops that lost the race for TopOfStack meet.
+			*/
+			STACK_ELIMINATION_SLOT EliminationArray[STACK_ELIMINATION_ARRAY_SIZE];
+		#endif // end of USING_STACK_ELIMINATION_BACKOFF
+	};
+
+	typedef struct _ConcurrentStack CONCURRENT_STACK;
+#endif // end of USING_STACK_CONCURRENT_METHODS
+
+#if (USING_STACK_DEQUE == 1)
+	/*
+		The following struct is the circular buffer a STACK_DEQUE keeps
+		its data in.  When it fills up a new one twice the size replaces
+		it, and the old one is kept until StackDequeClear() since thieves
+		may still be reading out of it.
+	*/
+	struct _StackDequeArray
+	{
+		/**
+		* The number of slots in Data.  Always a power of 2.
+		*/
+		UINT32 Size;
+
+		/**
+		* The array this one replaced, or NULL.
+		*/
+		struct _StackDequeArray *Previous;
+
+		/**
+		* The data in the STACK_DEQUE.  Allocated with room for Size pointers.
+		*/
+		void *Data[1];
+	};
+
+	typedef struct _StackDequeArray STACK_DEQUE_ARRAY;
+
+	/*
+		The following struct is a Chase-Lev work stealing deque.  The
+		thread that owns it pushes and pops at the bottom like a STACK,
+		while any other thread can steal from the top.
+	*/
+	struct _StackDeque
+	{
+		/**
+		* The index of the oldest item, where thieves steal from.
+		*/
+		INT64 Top;
+
+		BYTE TopPadding[STACK_CACHE_LINE_SIZE - sizeof(INT64)];
+
+		/**
+		* One past the index of the newest item, where the owner pushes and pops.
+		*/
+		INT64 Bottom;
+
+		/**
+		* The circular buffer currently holding the data.  NULL until the
+		* first push after the STACK_DEQUE is created or cleared.
+		*/
+		STACK_DEQUE_ARRAY *Array;
+
+		#if(USING_STACK_DEPENDENT_FREE_METHOD == 1)
+			void (*StackFreeMethod)(void *Data);
+		#endif // end of USING_STACK_DEPENDENT_FREE_METHOD
+	};
+
+	typedef struct _StackDeque STACK_DEQUE;
+#endif // end of USING_STACK_DEQUE
+
+#if (USING_STACK_SERIALIZE_METHODS == 1)
+	/*
+		The following struct starts every buffer written by StackSerialize().
+		It is followed right away by Size items of ElementSize bytes each,
+		bottom first.  Everything is in the byte order of the machine that
+		wrote it, which ByteOrder and WordSize record.
+	*/
+	struct _StackSerialHeader
+	{
+		/**
+		* STACK_SERIAL_MAGIC, so a buffer that isn't a serialized STACK, or
+		* was written with the other byte order, is turned away.
+		*/
+		UINT32 Magic;
+
+		/**
+		* The layout of the buffer, STACK_SERIAL_VERSION.
+		*/
+		UINT32 Version;
+
+		/**
+		* STACK_SERIAL_BYTE_ORDER in the byte order of the machine that 
+		* wrote the buffer.
+		*/
+		UINT32 ByteOrder;
+
+		/**
+		* sizeof(void*) on the machine that wrote the buffer, so items laid
+		* out for another word size are turned away.
+		*/
+		UINT32 WordSize;
+
+		/**
+		* The size in bytes of each item.
+		*/
+		UINT32 ElementSize;
+
+		/**
+		* The number of items that follow.
+		*/
+		UINT32 Size;
+	};
+
+	typedef struct _StackSerialHeader STACK_SERIAL_HEADER;
+#endif // end of USING_STACK_SERIALIZE_METHODS
+
+#if (USING_STACK_SYNCHRONIZED_METHODS == 1)
+	/*
+		The following struct is a STACK that any number of threads can
+		push to and pop from.  Every use of the STACK inside it is done
+		with Lock held, and threads in StackPopWait() sleep on NotEmpty.
+	*/
+	struct _SynchronizedStack
+	{
+		/**
+		* The STACK holding the data.
+		*/
+		STACK Stack;
+
+		/**
+		* Held around every use of Stack.
+		*/
+		pthread_mutex_t Lock;
+
+		/**
+		* Signalled when data is pushed while a thread is waiting.
+		*/
+		pthread_cond_t NotEmpty;
+
+		/**
+		* The number of threads asleep in StackPopWait().
+		*/
+		UINT32 Waiters;
+
+		#if (USING_STACK_EVENT_FD == 1)
+			/**
+			* The eventfd handed out by SynchronizedStackGetEventFd(), or -1
+			* until it is first asked for.
+			*/
+			int EventFd;
+		#endif // end of USING_STACK_EVENT_FD
+	};
+
+	typedef struct _SynchronizedStack SYNCHRONIZED_STACK;
+#endif // end of USING_STACK_SYNCHRONIZED_METHODS
+
+#if (USING_STACK_MAPPED_METHODS == 1)
+	/*
+		The following struct starts the file of a MAPPED_STACK.  Only
+		offsets from the start of the file are kept in it, never 
+		pointers, so the file means the same thing wherever it is
+		mapped the next time it is opened.
+	*/
+	struct _StackMappedHeader
+	{
+		/**
+		* STACK_MAPPED_MAGIC, so a file that isn't a MAPPED_STACK is turned away.
+		*/
+		UINT32 Magic;
+
+		/**
+		* The layout of the file, STACK_MAPPED_FILE_VERSION.
+		*/
+		UINT32 Version;
+
+		/**
+		* The size in bytes of each item.
+		*/
+		UINT32 ElementSize;
+
+		/**
+		* The number of items in the MAPPED_STACK.  Only updated after the
+		* item itself has been written or read.
+		*/
+		UINT32 Size;
+
+		/**
+		* The number of items the file has room for.
+		*/
+		UINT32 Capacity;
+
+		/**
+		* The offset of the bottom item from the start of the file.
+		*/
+		UINT32 DataOffset;
+	};
+
+	typedef struct _StackMappedHeader STACK_MAPPED_HEADER;
+
+	/*
+		The following struct is an open MAPPED_STACK.  It only lives in
+		memory, everything that has to survive is in the file.
+	*/
+	struct _MappedStack
+	{
+		/**
+		* The file descriptor of the MAPPED_STACK's file.
+		*/
+		int File;
+
+		/**
+		* Where the file is mapped.  The STACK_MAPPED_HEADER is at the start.
+		*/
+		STACK_MAPPED_HEADER *Header;
+
+		/**
+		* The number of bytes of the file that are mapped.
+		*/
+		UINT64 MapSize;
+	};
+
+	typedef struct _MappedStack MAPPED_STACK;
+#endif // end of USING_STACK_MAPPED_METHODS
+
+#if (USING_STACK_COMPACT_METHODS == 1)
+	/*
+		The following struct is a pool of nodes that any number of
+		COMPACT_STACK's take their nodes from.  A node is an index into
+		Data and Next, which are kept apart so a node takes up a data
+		pointer and a UINT32 with no padding.  Index 0 is never handed 
+		out and stands for no node.  Growing the arrays moves them, but 
+		indices stay good, so a COMPACT_STACK never has to be fixed up.
+	*/
+	struct _StackSlab
+	{
+		/**
+		* The data of each node.
+		*/
+		void **Data;
+
+		/**
+		* The index of the node below each node, or 0 for the bottom.
+		*/
+		UINT32 *Next;
+
+		/**
+		* The number of nodes Data and Next have room for.
+		*/
+		UINT32 Capacity;
+
+		/**
+		* The nodes below this index have been handed out at least once.
+		*/
+		UINT32 Used;
+
+		/**
+		* The first node that was given back and can be handed out again,
+		* linked through Next, or 0.
+		*/
+		UINT32 FreeNodes;
+
+		/**
+		* The number of nodes in use by COMPACT_STACK's.
+		*/
+		UINT32 NodesInUse;
+
+		#if(USING_STACK_DEPENDENT_FREE_METHOD == 1)
+			/**
+			* Shared by every COMPACT_STACK of the STACK_SLAB.
+			*/
+			void (*StackFreeMethod)(void *Data);
+		#endif // end of USING_STACK_DEPENDENT_FREE_METHOD
+	};
+
+	typedef struct _StackSlab STACK_SLAB;
+
+	/*
+		The following struct is a stack whose nodes come from a
+		STACK_SLAB.  It is 8 bytes, so it can be kept in a table with
+		one for every session.
+	*/
+	struct _CompactStack
+	{
+		/**
+		* The index of the top node in the STACK_SLAB, or 0 if empty.
+		*/
+		UINT32 Top;
+
+		/**
+		* The number of items in the COMPACT_STACK.
+		*/
+		UINT32 Size;
+	};
+
+	typedef struct _CompactStack COMPACT_STACK;
+#endif // end of USING_STACK_COMPACT_METHODS
+
 #endif // end of STACK_OBJECT_H
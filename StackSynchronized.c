@@ -0,0 +1,338 @@
+/*
+	Date: March 26, 2011
+	File Name: StackSynchronized.c
+	Version: 1.05
+	IDE: Visual Studio 2010 Professional
+	Compiler: C89
+
+	Description:
+	This file contains all the code which comprises
+	the SYNCHRONIZED_STACK.  For method descriptions
+	see StackSynchronized.h.
+*/
+
+#include "StackSynchronized.h"
+
+#if (USING_STACK_SYNCHRONIZED_METHODS == 1)
+
+#if (USE_MALLOC == 1)
+	#include "stdlib.h"
+#endif // end of USE_MALLOC
+
+#include "errno.h"
+#include "time.h"
+
+#if (USING_STACK_EVENT_FD == 1)
+	#include "unistd.h"
+	#include "sys/eventfd.h"
+
+	/*
+		Makes the eventfd readable, if it has been made.  Only called when
+		the SYNCHRONIZED_STACK goes from empty to not, so the counter is
+		never more than 1.
+	*/
+	static BOOL StackEventFdSet(SYNCHRONIZED_STACK *Stack)
+	{
+		UINT64 One;
+
+		if(Stack->EventFd == -1)
+			return (BOOL)TRUE;
+
+		One = (UINT64)1;
+
+		return (BOOL)(write(Stack->EventFd, (const void*)&One, sizeof(UINT64)) == (ssize_t)sizeof(UINT64));
+	}
+
+	/*
+		Makes the eventfd unreadable again, if it has been made.  The
+		eventfd doesn't block, so this is fine even if it wasn't readable.
+	*/
+	static BOOL StackEventFdReset(SYNCHRONIZED_STACK *Stack)
+	{
+		UINT64 Count;
+
+		if(Stack->EventFd == -1)
+			return (BOOL)TRUE;
+
+		return (BOOL)(read(Stack->EventFd, (void*)&Count, sizeof(UINT64)) == (ssize_t)sizeof(UINT64));
+	}
+#endif // end of USING_STACK_EVENT_FD
+
+/*
+	Pops the top of the SYNCHRONIZED_STACK, which must not be empty.  The
+	lock must be held.
+*/
+static void *StackSynchronizedPop(SYNCHRONIZED_STACK *Stack)
+{
+	void *Data;
+
+	Data = (void*)StackPop(&Stack->Stack);
+
+	#if (USING_STACK_EVENT_FD == 1)
+		if(StackIsEmpty(&Stack->Stack))
+			StackEventFdReset(Stack);
+	#endif // end of USING_STACK_EVENT_FD
+
+	return (void*)Data;
+}
+
+SYNCHRONIZED_STACK *CreateSynchronizedStack(SYNCHRONIZED_STACK *Stack, void (*CustomFreeMethod)(void *Data))
+{
+	pthread_condattr_t ConditionAttributes;
+	BOOL Allocated;
+
+	/*
+		If Stack is equal to (SYNCHRONIZED_STACK*)NULL then the user wants
+		to create a new SYNCHRONIZED_STACK in memory
+	*/
+	Allocated = (BOOL)FALSE;
+
+	if(Stack == (SYNCHRONIZED_STACK*)NULL)
+	{
+		if((Stack = (SYNCHRONIZED_STACK*)StackMemAlloc(sizeof(SYNCHRONIZED_STACK))) == (SYNCHRONIZED_STACK*)NULL)
+		{
+			return (SYNCHRONIZED_STACK*)NULL;
+		}
+
+		Allocated = (BOOL)TRUE;
+	}
+
+	CreateStack(&Stack->Stack, CustomFreeMethod);
+
+	Stack->Waiters = (UINT32)0;
+
+	#if (USING_STACK_EVENT_FD == 1)
+		Stack->EventFd = -1;
+	#endif // end of USING_STACK_EVENT_FD
+
+	if(pthread_mutex_init(&Stack->Lock, NULL))
+	{
+		if(Allocated)
+			StackMemDealloc((void*)Stack);
+
+		return (SYNCHRONIZED_STACK*)NULL;
+	}
+
+	/*
+		Timeouts are worked out on CLOCK_MONOTONIC, so the condition
+		variable has to use it too.
+	*/
+	if(pthread_condattr_init(&ConditionAttributes))
+	{
+		pthread_mutex_destroy(&Stack->Lock);
+
+		if(Allocated)
+			StackMemDealloc((void*)Stack);
+
+		return (SYNCHRONIZED_STACK*)NULL;
+	}
+
+	if(pthread_condattr_setclock(&ConditionAttributes, CLOCK_MONOTONIC) || pthread_cond_init(&Stack->NotEmpty, &ConditionAttributes))
+	{
+		pthread_condattr_destroy(&ConditionAttributes);
+		pthread_mutex_destroy(&Stack->Lock);
+
+		if(Allocated)
+			StackMemDealloc((void*)Stack);
+
+		return (SYNCHRONIZED_STACK*)NULL;
+	}
+
+	pthread_condattr_destroy(&ConditionAttributes);
+
+	return (SYNCHRONIZED_STACK*)Stack;
+}
+
+BOOL SynchronizedStackPush(SYNCHRONIZED_STACK *Stack, const void *Data)
+{
+	BOOL Success;
+
+	#if (STACK_SAFE_MODE == 1)
+		if(Stack == (SYNCHRONIZED_STACK*)NULL)
+			return (BOOL)FALSE;
+	#endif // end of STACK_SAFE_MODE
+
+	pthread_mutex_lock(&Stack->Lock);
+
+	if((Success = StackPush(&Stack->Stack, Data)) == (BOOL)TRUE)
+	{
+		#if (USING_STACK_EVENT_FD == 1)
+			if(Stack->Stack.Size == (UINT32)1)
+				StackEventFdSet(Stack);
+		#endif // end of USING_STACK_EVENT_FD
+
+		/*
+			Each push can satisfy one waiting thread, and there is no
+			need to signal at all if nobody is waiting.
+		*/
+		if(Stack->Waiters)
+			pthread_cond_signal(&Stack->NotEmpty);
+	}
+
+	pthread_mutex_unlock(&Stack->Lock);
+
+	return (BOOL)Success;
+}
+
+void *SynchronizedStackPop(SYNCHRONIZED_STACK *Stack)
+{
+	return StackPopWait(Stack, (UINT32)0);
+}
+
+void *StackPopWait(SYNCHRONIZED_STACK *Stack, UINT32 TimeoutInMilliseconds)
+{
+	struct timespec Deadline;
+	void *Data;
+	int Result;
+
+	#if (STACK_SAFE_MODE == 1)
+		if(Stack == (SYNCHRONIZED_STACK*)NULL)
+			return (void*)NULL;
+	#endif // end of STACK_SAFE_MODE
+
+	/*
+		Work out when to give up before taking the lock, and once, so
+		waking up for nothing doesn't make the wait any longer.
+	*/
+	if(TimeoutInMilliseconds != (UINT32)0 && TimeoutInMilliseconds != STACK_WAIT_FOREVER)
+	{
+		clock_gettime(CLOCK_MONOTONIC, &Deadline);
+
+		Deadline.tv_sec += (time_t)(TimeoutInMilliseconds / 1000);
+		Deadline.tv_nsec += (long)((TimeoutInMilliseconds % 1000) * 1000000);
+
+		if(Deadline.tv_nsec >= 1000000000L)
+		{
+			Deadline.tv_sec++;
+			Deadline.tv_nsec -= 1000000000L;
+		}
+	}
+
+	pthread_mutex_lock(&Stack->Lock);
+
+	Result = 0;
+
+	/*
+		The condition variable can wake up without a push, or another
+		thread can get to the data first, so check again every time.
+	*/
+	while(StackIsEmpty(&Stack->Stack) && TimeoutInMilliseconds != (UINT32)0 && Result != ETIMEDOUT)
+	{
+		Stack->Waiters++;
+
+		if(TimeoutInMilliseconds == STACK_WAIT_FOREVER)
+			Result = pthread_cond_wait(&Stack->NotEmpty, &Stack->Lock);
+		else
+			Result = pthread_cond_timedwait(&Stack->NotEmpty, &Stack->Lock, &Deadline);
+
+		Stack->Waiters--;
+	}
+
+	if(StackIsEmpty(&Stack->Stack))
+		Data = (void*)NULL;
+	else
+		Data = (void*)StackSynchronizedPop(Stack);
+
+	pthread_mutex_unlock(&Stack->Lock);
+
+	return (void*)Data;
+}
+
+UINT32 SynchronizedStackGetSize(SYNCHRONIZED_STACK *Stack)
+{
+	UINT32 Size;
+
+	#if (STACK_SAFE_MODE == 1)
+		if(Stack == (SYNCHRONIZED_STACK*)NULL)
+			return (UINT32)0;
+	#endif // end of STACK_SAFE_MODE
+
+	pthread_mutex_lock(&Stack->Lock);
+
+	Size = (UINT32)(Stack->Stack.Size);
+
+	pthread_mutex_unlock(&Stack->Lock);
+
+	return (UINT32)Size;
+}
+
+BOOL SynchronizedStackClear(SYNCHRONIZED_STACK *Stack)
+{
+	#if (STACK_SAFE_MODE == 1)
+		if(Stack == (SYNCHRONIZED_STACK*)NULL)
+			return (BOOL)FALSE;
+	#endif // end of STACK_SAFE_MODE
+
+	pthread_mutex_lock(&Stack->Lock);
+
+	#if (USING_STACK_EVENT_FD == 1)
+		if(!StackIsEmpty(&Stack->Stack))
+			StackEventFdReset(Stack);
+	#endif // end of USING_STACK_EVENT_FD
+
+	StackClear(&Stack->Stack);
+
+	pthread_mutex_unlock(&Stack->Lock);
+
+	return (BOOL)TRUE;
+}
+
+#if (USING_STACK_EVENT_FD == 1)
+	int SynchronizedStackGetEventFd(SYNCHRONIZED_STACK *Stack)
+	{
+		int EventFd;
+
+		#if (STACK_SAFE_MODE == 1)
+			if(Stack == (SYNCHRONIZED_STACK*)NULL)
+				return -1;
+		#endif // end of STACK_SAFE_MODE
+
+		pthread_mutex_lock(&Stack->Lock);
+
+		/*
+			Make the eventfd the first time it is asked for, already
+			readable if there is something in the SYNCHRONIZED_STACK.
+		*/
+		if(Stack->EventFd == -1 && (Stack->EventFd = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC)) != -1)
+		{
+			if(!StackIsEmpty(&Stack->Stack))
+				StackEventFdSet(Stack);
+		}
+
+		EventFd = Stack->EventFd;
+
+		pthread_mutex_unlock(&Stack->Lock);
+
+		return EventFd;
+	}
+#endif // end of USING_STACK_EVENT_FD
+
+BOOL DestroySynchronizedStack(SYNCHRONIZED_STACK *Stack)
+{
+	#if (STACK_SAFE_MODE == 1)
+		if(Stack == (SYNCHRONIZED_STACK*)NULL)
+			return (BOOL)FALSE;
+	#endif // end of STACK_SAFE_MODE
+
+	StackClear(&Stack->Stack);
+
+	#if (USING_STACK_NODE_CACHE == 1)
+		StackShrink(&Stack->Stack);
+	#endif // end of USING_STACK_NODE_CACHE
+
+	#if (USING_STACK_EVENT_FD == 1)
+		if(Stack->EventFd != -1)
+		{
+			close(Stack->EventFd);
+
+			Stack->EventFd = -1;
+		}
+	#endif // end of USING_STACK_EVENT_FD
+
+	pthread_cond_destroy(&Stack->NotEmpty);
+	pthread_mutex_destroy(&Stack->Lock);
+
+	return (BOOL)TRUE;
+}
+
+#endif // end of USING_STACK_SYNCHRONIZED_METHODS
@@ -0,0 +1,270 @@
+/*
+	Date: March 26, 2011
+	File Name: StackSynchronized.h
+	Version: 1.05
+	IDE: Visual Studio 2010 Professional
+	Compiler: C89
+
+	Description:
+	This file contains all the method headers for interfacing to the
+	SYNCHRONIZED_STACK, a STACK that producer and consumer threads share.
+	A consumer can sleep in StackPopWait() until there is something to
+	pop, or wait on an eventfd alongside its other file descriptors.  All
+	methods have their documentation above their declaration.
+*/
+
+#ifndef STACK_SYNCHRONIZED_H
+	#define STACK_SYNCHRONIZED_H
+
+#include "GenericTypeDefs.h"
+#include "StackConfig.h"
+#include "StackObject.h"
+#include "Stack.h"
+
+#if (USING_STACK_SYNCHRONIZED_METHODS == 1)
+
+/*
+	Pass as the timeout of StackPopWait() to wait for as long as it takes.
+*/
+#define STACK_WAIT_FOREVER						(UINT32)0xFFFFFFFF
+
+/*
+	Function: SYNCHRONIZED_STACK *CreateSynchronizedStack(SYNCHRONIZED_STACK *Stack, void (*CustomFreeMethod)(void *Data))
+
+	Parameters:
+		SYNCHRONIZED_STACK *Stack - The address at which the SYNCHRONIZED_STACK
+		will be inititalized.  If NULL is passed in then this method will
+		create a SYNCHRONIZED_STACK out of the heap with a call to
+		StackMemAlloc().
+
+		void(*CustomFreeMethod)(void *Data) - A pointer to a method that the
+		user defines.  SynchronizedStackClear() calls it on every piece of
+		data left in the SYNCHRONIZED_STACK.
+
+	Returns:
+		SYNCHRONIZED_STACK* - The address at which the newly initialized
+		SYNCHRONIZED_STACK resides in memory.  If it could not be created
+		then (SYNCHRONIZED_STACK*)NULL is returned.
+
+	Description: Creates a new, empty SYNCHRONIZED_STACK in memory.  Its
+	STACK is made with CreateStack(), so it uses whatever storage
+	StackConfig.h picks for every other STACK.
+
+	Notes: USING_STACK_SYNCHRONIZED_METHODS in StackConfig.h must be defined as 1 to use method.
+*/
+/**
+		* @brief Initializes a SYNCHRONIZED_STACK, and can create a SYNCHRONIZED_STACK.
+		* @param *Stack - A pointer to an already allocate SYNCHRONIZED_STACK or a NULL
+		pointer to create a SYNCHRONIZED_STACK from StackMemAlloc().
+		* @param *CustomFreeMethod - A method called by the STACK Library to delete
+		a piece of data left in the SYNCHRONIZED_STACK.
+		* @return *SYNCHRONIZED_STACK - The address of the SYNCHRONIZED_STACK in memory.
+		If it could not be allocated, returns a NULL pointer.
+		* @note USING_STACK_SYNCHRONIZED_METHODS in StackConfig.h must be defined as 1 to use method.
+		* @sa DestroySynchronizedStack()
+		* @since v1.05
+*/
+SYNCHRONIZED_STACK *CreateSynchronizedStack(SYNCHRONIZED_STACK *Stack, void (*CustomFreeMethod)(void *Data));
+
+/*
+	Function: BOOL SynchronizedStackPush(SYNCHRONIZED_STACK *Stack, const void *Data)
+
+	Parameters:
+		SYNCHRONIZED_STACK *Stack - The address at which the SYNCHRONIZED_STACK resides in memory.
+		const void *Data - The data to push onto the SYNCHRONIZED_STACK.
+
+	Returns:
+		BOOL - TRUE if the data was pushed, FALSE if StackPush() failed or a
+		NULL referenced SYNCHRONIZED_STACK was passed in.
+
+	Description: Pushes Data onto the SYNCHRONIZED_STACK and wakes up one
+	thread waiting in StackPopWait(), if there is one.  Pushing onto an
+	empty SYNCHRONIZED_STACK makes its eventfd readable.
+
+	Notes: USING_STACK_SYNCHRONIZED_METHODS in StackConfig.h must be defined as 1 to use method.
+*/
+/**
+		* @brief Pushes data onto a SYNCHRONIZED_STACK and wakes a waiting consumer.
+		* @param *Stack - The address at which the SYNCHRONIZED_STACK resides in memory.
+		* @param *Data - The data to push.
+		* @return BOOL - TRUE if successful, FALSE otherwise.
+		* @note USING_STACK_SYNCHRONIZED_METHODS in StackConfig.h must be defined as 1 to use method.
+		* @sa StackPopWait()
+		* @since v1.05
+*/
+BOOL SynchronizedStackPush(SYNCHRONIZED_STACK *Stack, const void *Data);
+
+/*
+	Function: void *SynchronizedStackPop(SYNCHRONIZED_STACK *Stack)
+
+	Parameters:
+		SYNCHRONIZED_STACK *Stack - The address at which the SYNCHRONIZED_STACK resides in memory.
+
+	Returns:
+		void* - The data that was on top of the SYNCHRONIZED_STACK.  NULL if
+		it was empty or a NULL referenced SYNCHRONIZED_STACK was passed in.
+
+	Description: Pops the top of the SYNCHRONIZED_STACK without waiting,
+	the same as StackPopWait() with a timeout of 0.
+
+	Notes: USING_STACK_SYNCHRONIZED_METHODS in StackConfig.h must be defined as 1 to use method.
+*/
+/**
+		* @brief Pops the top of a SYNCHRONIZED_STACK without waiting.
+		* @param *Stack - The address at which the SYNCHRONIZED_STACK resides in memory.
+		* @return void* - The data popped, or NULL if the SYNCHRONIZED_STACK was empty.
+		* @note USING_STACK_SYNCHRONIZED_METHODS in StackConfig.h must be defined as 1 to use method.
+		* @sa StackPopWait()
+		* @since v1.05
+*/
+void *SynchronizedStackPop(SYNCHRONIZED_STACK *Stack);
+
+/*
+	Function: void *StackPopWait(SYNCHRONIZED_STACK *Stack, UINT32 TimeoutInMilliseconds)
+
+	Parameters:
+		SYNCHRONIZED_STACK *Stack - The address at which the SYNCHRONIZED_STACK resides in memory.
+
+		UINT32 TimeoutInMilliseconds - The longest to wait for something to
+		be pushed.  0 doesn't wait at all, STACK_WAIT_FOREVER waits for as
+		long as it takes.
+
+	Returns:
+		void* - The data that was on top of the SYNCHRONIZED_STACK.  NULL if
+		nothing was pushed before the timeout ran out, or a NULL referenced
+		SYNCHRONIZED_STACK was passed in.
+
+	Description: Pops the top of the SYNCHRONIZED_STACK.  If it is empty
+	the calling thread sleeps on a condition variable, using no CPU, until
+	SynchronizedStackPush() wakes it or the timeout runs out.  The timeout
+	is measured with CLOCK_MONOTONIC, so changing the system time doesn't
+	move it.
+
+	Notes: USING_STACK_SYNCHRONIZED_METHODS in StackConfig.h must be defined as 1 to use method.
+*/
+/**
+		* @brief Pops the top of a SYNCHRONIZED_STACK, waiting for data if it is empty.
+		* @param *Stack - The address at which the SYNCHRONIZED_STACK resides in memory.
+		* @param TimeoutInMilliseconds - The longest to wait, or STACK_WAIT_FOREVER.
+		* @return void* - The data popped, or NULL if the wait timed out.
+		* @note USING_STACK_SYNCHRONIZED_METHODS in StackConfig.h must be defined as 1 to use method.
+		* @sa SynchronizedStackPush()
+		* @since v1.05
+*/
+void *StackPopWait(SYNCHRONIZED_STACK *Stack, UINT32 TimeoutInMilliseconds);
+
+/*
+	Function: UINT32 SynchronizedStackGetSize(SYNCHRONIZED_STACK *Stack)
+
+	Parameters:
+		SYNCHRONIZED_STACK *Stack - The address at which the SYNCHRONIZED_STACK resides in memory.
+
+	Returns:
+		UINT32 - The number of items in the SYNCHRONIZED_STACK, or 0 if it is NULL.
+
+	Description: Returns the size of the referenced SYNCHRONIZED_STACK.
+	Other threads can change it as soon as it is read.
+
+	Notes: USING_STACK_SYNCHRONIZED_METHODS in StackConfig.h must be defined as 1 to use method.
+*/
+/**
+		* @brief Will return the number of items in a SYNCHRONIZED_STACK.
+		* @param *Stack - The address at which the SYNCHRONIZED_STACK resides in memory.
+		* @return UINT32 - The number of items in the SYNCHRONIZED_STACK.
+		* @note USING_STACK_SYNCHRONIZED_METHODS in StackConfig.h must be defined as 1 to use method.
+		* @sa None
+		* @since v1.05
+*/
+UINT32 SynchronizedStackGetSize(SYNCHRONIZED_STACK *Stack);
+
+/*
+	Function: BOOL SynchronizedStackClear(SYNCHRONIZED_STACK *Stack)
+
+	Parameters:
+		SYNCHRONIZED_STACK *Stack - The address at which the SYNCHRONIZED_STACK resides in memory.
+
+	Returns:
+		BOOL - TRUE if the SYNCHRONIZED_STACK was emptied.
+		FALSE - If a NULL referenced SYNCHRONIZED_STACK was passed in.
+
+	Description: Removes every item from the SYNCHRONIZED_STACK with
+	StackClear(), calling its free method on each one.
+
+	Notes: USING_STACK_SYNCHRONIZED_METHODS in StackConfig.h must be defined as 1 to use method.
+*/
+/**
+		* @brief Removes every item from a SYNCHRONIZED_STACK.
+		* @param *Stack - The address at which the SYNCHRONIZED_STACK resides in memory.
+		* @return BOOL - TRUE if successful, FALSE if the SYNCHRONIZED_STACK was NULL.
+		* @note USING_STACK_SYNCHRONIZED_METHODS in StackConfig.h must be defined as 1 to use method.
+		* @sa DestroySynchronizedStack()
+		* @since v1.05
+*/
+BOOL SynchronizedStackClear(SYNCHRONIZED_STACK *Stack);
+
+/*
+	Function: int SynchronizedStackGetEventFd(SYNCHRONIZED_STACK *Stack)
+
+	Parameters:
+		SYNCHRONIZED_STACK *Stack - The address at which the SYNCHRONIZED_STACK resides in memory.
+
+	Returns:
+		int - An eventfd that is readable while the SYNCHRONIZED_STACK holds
+		anything.  -1 if it couldn't be made or a NULL referenced
+		SYNCHRONIZED_STACK was passed in.
+
+	Description: Hands out the SYNCHRONIZED_STACK's eventfd, making it the
+	first time it is asked for, so a SYNCHRONIZED_STACK nobody waits on
+	this way never pays for it.  Add it to an epoll set, or poll() or
+	select() on it, for POLLIN, and pop until the SYNCHRONIZED_STACK is
+	empty when it is readable.  The eventfd is cleared by the pop that
+	takes the last item, so it must not be read from by the caller.
+
+	Notes: The eventfd belongs to the SYNCHRONIZED_STACK and is closed by
+	DestroySynchronizedStack().  USING_STACK_SYNCHRONIZED_METHODS and
+	USING_STACK_EVENT_FD in StackConfig.h must be defined as 1 to use method.
+*/
+/**
+		* @brief Will return an eventfd that is readable while a SYNCHRONIZED_STACK isn't empty.
+		* @param *Stack - The address at which the SYNCHRONIZED_STACK resides in memory.
+		* @return int - The eventfd, or -1 if unsuccessful.
+		* @note USING_STACK_SYNCHRONIZED_METHODS and USING_STACK_EVENT_FD in
+		StackConfig.h must be defined as 1 to use method.
+		* @sa StackPopWait()
+		* @since v1.05
+*/
+#if (USING_STACK_EVENT_FD == 1)
+	int SynchronizedStackGetEventFd(SYNCHRONIZED_STACK *Stack);
+#endif // end of USING_STACK_EVENT_FD
+
+/*
+	Function: BOOL DestroySynchronizedStack(SYNCHRONIZED_STACK *Stack)
+
+	Parameters:
+		SYNCHRONIZED_STACK *Stack - The address at which the SYNCHRONIZED_STACK resides in memory.
+
+	Returns:
+		BOOL - TRUE if the SYNCHRONIZED_STACK was destroyed.
+		FALSE - If a NULL referenced SYNCHRONIZED_STACK was passed in.
+
+	Description: Clears the SYNCHRONIZED_STACK, then releases its lock,
+	condition variable and eventfd.  The SYNCHRONIZED_STACK structure will
+	still exist.
+
+	Notes: No thread may be using the SYNCHRONIZED_STACK, or waiting on it.
+	USING_STACK_SYNCHRONIZED_METHODS in StackConfig.h must be defined as 1
+	to use method.
+*/
+/**
+		* @brief Releases everything a SYNCHRONIZED_STACK holds.
+		* @param *Stack - The address at which the SYNCHRONIZED_STACK resides in memory.
+		* @return BOOL - TRUE if successful, FALSE if the SYNCHRONIZED_STACK was NULL.
+		* @note USING_STACK_SYNCHRONIZED_METHODS in StackConfig.h must be defined as 1 to use method.
+		* @sa CreateSynchronizedStack()
+		* @since v1.05
+*/
+BOOL DestroySynchronizedStack(SYNCHRONIZED_STACK *Stack);
+
+#endif // end of USING_STACK_SYNCHRONIZED_METHODS
+
+#endif // end of STACK_SYNCHRONIZED_H